@@ -0,0 +1,246 @@
+/**
+ * @file bench_lflist.cpp
+ * @brief Compares the lock-free lflist with a mutex-wrapped sorted
+ * linkedlist_t under a mixed read-mostly workload
+ *
+ * Run with `make bench`. Contention, and so the gap, grows with the
+ * number of cores.
+ *
+ */
+
+#include "../data_structures/lflist.h"
+#include "../data_structures/linkedlist.h"
+
+#include <chrono>
+#include <pthread.h>
+#include <stdio.h>
+#include <unistd.h>
+
+
+#define KEY_RANGE 1024
+#define OPS_PER_THREAD 200000
+#define N_REPEATS 3
+
+// Percentages of each operation; the rest are lookups
+#define INSERT_PERCENT 10
+#define REMOVE_PERCENT 10
+
+static int compare_int(const void *a, const void *b) {
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+
+    return (x > y) - (x < y);
+}
+
+
+// -------------------- Mutex-wrapped sorted linked list
+
+struct locked_list {
+    pthread_mutex_t lock;
+    linkedlist_t list;
+};
+
+/**
+ * @brief Finds the first item not less than `key`
+ *
+ * @return int* The item, with the iterator positioned on it, or NULL
+ */
+static int *locked_find(struct locked_list *l, linkedlist_iterator_t *it, int key) {
+    int *item;
+
+    linkedlist_iter_init(it, &l->list, 0, 0);
+
+    while ((item = (int *) linkedlist_iter_next_ptr(it)) && *item < key) {
+    }
+
+    return item;
+}
+
+static int locked_insert(struct locked_list *l, int key) {
+    linkedlist_iterator_t it;
+    pthread_mutex_lock(&l->lock);
+
+    int *item = locked_find(l, &it, key);
+    int result = 1;
+
+    if (!item) {
+        result = linkedlist_append(&l->list, &key);
+    } else if (*item != key) {
+        result = linkedlist_insert_before(&it, &key);
+    }
+
+    pthread_mutex_unlock(&l->lock);
+
+    return result;
+}
+
+static int locked_remove(struct locked_list *l, int key) {
+    linkedlist_iterator_t it;
+    pthread_mutex_lock(&l->lock);
+
+    int *item = locked_find(l, &it, key);
+    int result = item && *item == key ? linkedlist_erase_at(&it) : 1;
+
+    pthread_mutex_unlock(&l->lock);
+
+    return result;
+}
+
+static int locked_contains(struct locked_list *l, int key) {
+    linkedlist_iterator_t it;
+    pthread_mutex_lock(&l->lock);
+
+    int *item = locked_find(l, &it, key);
+    int found = item && *item == key;
+
+    pthread_mutex_unlock(&l->lock);
+
+    return found;
+}
+
+
+// -------------------- Workload
+
+struct worker {
+    pthread_t thread;
+    unsigned int seed;
+    struct locked_list *locked;     // Used if not NULL, otherwise `lf`
+    lflist_t *lf;
+    epoch_domain_t *domain;
+};
+
+static void *run_worker(void *arg) {
+    struct worker *w = (struct worker *) arg;
+    epoch_thread_t thread;
+
+    if (!w->locked) {
+        epoch_register(w->domain, &thread);
+    }
+
+    for (int i = 0; i < OPS_PER_THREAD; i++) {
+        w->seed = w->seed * 1103515245u + 12345u;
+        int key = (int) ((w->seed >> 8) % KEY_RANGE);
+        int op = (int) ((w->seed >> 20) % 100);
+
+        if (w->locked) {
+            if (op < INSERT_PERCENT) {
+                locked_insert(w->locked, key);
+            } else if (op < INSERT_PERCENT + REMOVE_PERCENT) {
+                locked_remove(w->locked, key);
+            } else {
+                locked_contains(w->locked, key);
+            }
+        } else {
+            if (op < INSERT_PERCENT) {
+                lflist_insert(w->lf, &thread, &key);
+            } else if (op < INSERT_PERCENT + REMOVE_PERCENT) {
+                lflist_remove(w->lf, &thread, &key, NULL);
+            } else {
+                lflist_contains(w->lf, &thread, &key);
+            }
+        }
+    }
+
+    if (!w->locked) {
+        epoch_unregister(&thread);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Runs the workload on `n_threads` threads, after filling half the
+ * key range
+ *
+ * @return double Millions of operations per second
+ */
+static double run(int lock_free, int n_threads) {
+    struct locked_list locked;
+    lflist_t lf;
+    epoch_domain_t domain;
+    epoch_thread_t main_thread;
+
+    if (lock_free) {
+        epoch_init(&domain);
+        epoch_register(&domain, &main_thread);
+        lflist_init(&lf, sizeof(int), compare_int);
+    } else {
+        pthread_mutex_init(&locked.lock, NULL);
+        linkedlist_init_pooled(&locked.list, sizeof(int));
+    }
+
+    for (int key = 0; key < KEY_RANGE; key += 2) {
+        if (lock_free) {
+            lflist_insert(&lf, &main_thread, &key);
+        } else {
+            locked_insert(&locked, key);
+        }
+    }
+
+    struct worker workers[16];
+    auto start = std::chrono::steady_clock::now();
+
+    for (int t = 0; t < n_threads; t++) {
+        workers[t].seed = 1234u + t;
+        workers[t].locked = lock_free ? NULL : &locked;
+        workers[t].lf = &lf;
+        workers[t].domain = &domain;
+        pthread_create(&workers[t].thread, NULL, run_worker, &workers[t]);
+    }
+
+    for (int t = 0; t < n_threads; t++) {
+        pthread_join(workers[t].thread, NULL);
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    if (lock_free) {
+        epoch_unregister(&main_thread);
+        lflist_destroy(&lf);
+        epoch_destroy(&domain);
+    } else {
+        linkedlist_destroy(&locked.list);
+        pthread_mutex_destroy(&locked.lock);
+    }
+
+    return (double) n_threads * OPS_PER_THREAD / elapsed.count() / 1e6;
+}
+
+
+/**
+ * @brief Best of several runs
+ *
+ */
+static double best_run(int lock_free, int n_threads) {
+    double best = 0;
+
+    for (int r = 0; r < N_REPEATS; r++) {
+        double mops = run(lock_free, n_threads);
+
+        if (mops > best) {
+            best = mops;
+        }
+    }
+
+    return best;
+}
+
+
+int main(void) {
+    printf(
+        "sorted set, %d keys, %d%% insert, %d%% remove: Mops/s, best of %d, %ld cores online\n",
+        KEY_RANGE, INSERT_PERCENT, REMOVE_PERCENT, N_REPEATS, sysconf(_SC_NPROCESSORS_ONLN)
+    );
+    printf("%-8s %12s %12s\n", "threads", "mutex list", "lflist");
+
+    int threads[] = {1, 2, 4, 8};
+
+    for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++) {
+        double locked = best_run(0, threads[t]);
+        double lock_free = best_run(1, threads[t]);
+
+        printf("%-8d %12.2f %12.2f\n", threads[t], locked, lock_free);
+    }
+
+    return 0;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file bench_linkedlist_sort.cpp
+ * @brief Compares linkedlist_sort_parallel with linkedlist_sort
+ *
+ * Run with `make bench`. The speedup is bounded by the number of cores.
+ *
+ */
+
+#include "../data_structures/linkedlist_parallel.h"
+
+#include <chrono>
+#include <stdio.h>
+#include <unistd.h>
+
+
+#define N_ITEMS 1000000
+#define N_REPEATS 3
+
+static int compare_int(const void *a, const void *b) {
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+
+    return (x > y) - (x < y);
+}
+
+static void fill(linkedlist_t *list) {
+    unsigned int seed = 12345;
+
+    for (int i = 0; i < N_ITEMS; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int item = (int) (seed >> 1);
+        linkedlist_append(list, &item);
+    }
+}
+
+/**
+ * @brief Best time of several sorts, on `pool` or serially if it is NULL
+ *
+ */
+static double time_sort(threadpool_t *pool) {
+    double best = 1e30;
+
+    for (int r = 0; r < N_REPEATS; r++) {
+        linkedlist_t list;
+        linkedlist_init_pooled(&list, sizeof(int));
+        fill(&list);
+
+        auto start = std::chrono::steady_clock::now();
+
+        if (pool) {
+            linkedlist_sort_parallel(&list, compare_int, pool);
+        } else {
+            linkedlist_sort(&list, compare_int);
+        }
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        if (elapsed.count() < best) {
+            best = elapsed.count();
+        }
+
+        linkedlist_destroy(&list);
+    }
+
+    return best;
+}
+
+
+int main(void) {
+    printf(
+        "linkedlist sort: %d ints, best of %d (ms), %ld cores online\n",
+        N_ITEMS, N_REPEATS, sysconf(_SC_NPROCESSORS_ONLN)
+    );
+
+    double serial = time_sort(NULL);
+    printf("%-18s %10.1f\n", "serial", serial * 1e3);
+
+    // Pools of n workers sort n + 1 pieces, counting the calling thread
+    size_t workers[] = {1, 3, 7};
+
+    for (size_t w = 0; w < sizeof(workers) / sizeof(workers[0]); w++) {
+        threadpool_t pool;
+        threadpool_init(&pool, workers[w]);
+
+        double parallel = time_sort(&pool);
+        printf(
+            "parallel, %zu pieces %7.1f  (%.2fx)\n",
+            workers[w] + 1, parallel * 1e3, serial / parallel
+        );
+
+        threadpool_destroy(&pool);
+    }
+
+    return 0;
+}
@@ -0,0 +1,131 @@
+/**
+ * @file bench_skiplist.cpp
+ * @brief Compares the skip list with a sorted linkedlist_t as an ordered set
+ *
+ * Run with `make bench`.
+ *
+ */
+
+#include "../data_structures/skiplist.h"
+#include "../data_structures/linkedlist.h"
+
+#include <chrono>
+#include <stdio.h>
+
+
+static int compare_int(const void *a, const void *b) {
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+
+    return (x > y) - (x < y);
+}
+
+static int key_at(int i) {
+    return (int) ((i * 2654435761u) >> 1);
+}
+
+static double seconds_since(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    return elapsed.count();
+}
+
+
+// -------------------- Sorted linked list
+
+/**
+ * @brief Finds the first item not less than `key`
+ *
+ * @return int* The item, with the iterator positioned on it, or NULL
+ */
+static int *sorted_find(linkedlist_t *list, linkedlist_iterator_t *it, int key) {
+    int *item;
+
+    linkedlist_iter_init(it, list, 0, 0);
+
+    while ((item = (int *) linkedlist_iter_next_ptr(it)) && *item < key) {
+    }
+
+    return item;
+}
+
+static void sorted_insert(linkedlist_t *list, int key) {
+    linkedlist_iterator_t it;
+    int *item = sorted_find(list, &it, key);
+
+    if (!item) {
+        linkedlist_append(list, &key);
+    } else if (*item != key) {
+        linkedlist_insert_before(&it, &key);
+    }
+}
+
+
+/**
+ * @brief Times inserting `n` keys in random order, then looking each up
+ *
+ */
+static void run(int n) {
+    linkedlist_t list;
+    skiplist_t skip;
+    linkedlist_iterator_t it;
+    volatile int found = 0;
+
+    linkedlist_init_pooled(&list, sizeof(int));
+    skiplist_init(&skip, sizeof(int), compare_int);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+        sorted_insert(&list, key_at(i));
+    }
+    double list_insert = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+        int *item = sorted_find(&list, &it, key_at(i));
+        found += item && *item == key_at(i);
+    }
+    double list_find = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+        int key = key_at(i);
+        skiplist_insert(&skip, &key);
+    }
+    double skip_insert = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+        int key = key_at(i);
+        found += skiplist_find(&skip, &key) != NULL;
+    }
+    double skip_find = seconds_since(start);
+
+    // Nanoseconds per operation
+    printf(
+        "%-8d %12.0f %12.0f %12.0f %12.0f\n",
+        n,
+        list_insert / n * 1e9, skip_insert / n * 1e9,
+        list_find / n * 1e9, skip_find / n * 1e9
+    );
+
+    linkedlist_destroy(&list);
+    skiplist_destroy(&skip);
+}
+
+
+int main(void) {
+    printf("ordered set of random ints: ns per operation\n");
+    printf(
+        "%-8s %12s %12s %12s %12s\n",
+        "items", "list insert", "skip insert", "list find", "skip find"
+    );
+
+    int sizes[] = {100, 1000, 10000, 30000};
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        run(sizes[s]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file bench_sort.cpp
+ * @brief Compares array_sort_stable (timsort) with array_sort (qsort)
+ *
+ * Run with `make bench`.
+ *
+ */
+
+#include "../data_structures/array.h"
+#include "../data_structures/array_sort.h"
+
+#include <chrono>
+#include <stdio.h>
+
+
+#define N_ITEMS 1000000
+#define N_REPEATS 5
+
+static int compare_int(const void *a, const void *b) {
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+
+    return (x > y) - (x < y);
+}
+
+static void fill(int *array, const char *pattern) {
+    unsigned int seed = 12345;
+
+    for (int i = 0; i < N_ITEMS; i++) {
+        seed = seed * 1103515245u + 12345u;
+
+        switch (pattern[0]) {
+            case 'r': array[i] = (int) (seed >> 1); break;                      // random
+            case 's': array[i] = i; break;                                      // sorted
+            case 'd': array[i] = N_ITEMS - i; break;                            // descending
+            case 'n': array[i] = seed % 100 == 0 ? (int) (seed >> 1) : i; break; // nearly sorted
+            default: array[i] = (int) (seed % 16); break;                       // few unique
+        }
+    }
+}
+
+/**
+ * @brief Best time of several runs of one sort on freshly filled input
+ *
+ */
+static double time_sort(const char *pattern, int stable) {
+    double best = 1e30;
+
+    for (int r = 0; r < N_REPEATS; r++) {
+        int *array = (int *) array_init(sizeof(int), N_ITEMS);
+        fill(array, pattern);
+
+        auto start = std::chrono::steady_clock::now();
+        array = (int *) (stable ? array_sort_stable(array, compare_int) : array_sort(array, compare_int));
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        if (elapsed.count() < best) {
+            best = elapsed.count();
+        }
+
+        array_destroy(array);
+    }
+
+    return best;
+}
+
+
+int main(void) {
+    const char *patterns[] = {"random", "sorted", "descending", "nearly sorted", "few unique"};
+
+    printf("sort: %d ints, best of %d (ms)\n", N_ITEMS, N_REPEATS);
+    printf("%-14s %12s %12s %8s\n", "input", "array_sort", "timsort", "ratio");
+
+    for (size_t p = 0; p < sizeof(patterns) / sizeof(patterns[0]); p++) {
+        double unstable = time_sort(patterns[p], 0);
+        double stable = time_sort(patterns[p], 1);
+
+        printf(
+            "%-14s %12.1f %12.1f %8.2f\n",
+            patterns[p], unstable * 1e3, stable * 1e3, unstable / stable
+        );
+    }
+
+    return 0;
+}
@@ -1,5 +1,60 @@
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE         // mremap
+#endif
+
 #include "array.h"
 
+#include <fcntl.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Where the header and items of an array are stored
+enum array_storage {
+    ARRAY_STORAGE_HEAP,             // malloc
+    ARRAY_STORAGE_MMAP_SHARED,      // Writable file mapping
+    ARRAY_STORAGE_MMAP_PRIVATE,     // Read-only file mapping
+    ARRAY_STORAGE_HEAP_ALIGNED,     // posix_memalign
+    ARRAY_STORAGE_MMAP_ANON,        // Anonymous mapping with huge pages
+    ARRAY_STORAGE_INLINE            // Caller-provided storage
+};
+
+// Size of a transparent huge page
+#define HUGE_PAGE_SIZE ((size_t)2 << 20)
+
+#define ARRAY_MMAP_MAGIC 0x4d525241u    // "ARMM" when stored little endian
+#define ARRAY_MMAP_VERSION 1
+
+// Bytes before the items of a mapped file. The file header comes first;
+// the runtime header is kept in the bytes just before the items, but is
+// never read back from the file.
+#define ARRAY_MMAP_PREFIX ((size_t)128)
+
+/**
+ * @brief Fixed-layout header at the start of a memory-mapped array file
+ * 
+ * @param magic `ARRAY_MMAP_MAGIC`
+ * @param version The format version, `ARRAY_MMAP_VERSION`
+ * @param reserved Zero
+ * @param item_size Size of an item in bytes
+ * @param length Number of items, stored by `array_mmap_sync` and
+ * `array_destroy`
+ * 
+ */
+struct array_mmap_header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint64_t item_size;
+    uint64_t length;
+};
+
+// Both headers must fit in the prefix
+typedef char array_mmap_prefix_fits[
+    sizeof(struct array_mmap_header) + sizeof(struct array_header) <= ARRAY_MMAP_PREFIX ? 1 : -1
+];
+
 
 
 //----------
@@ -13,15 +68,315 @@ static void *array_ensure_capacity(void *array, size_t n_append) {
     size_t req_capacity = h->length + n_append;
 
     if (req_capacity > h->capacity) {
-        array = array_resize(array, req_capacity);
+        // Grow geometrically so repeated appends are amortised O(1)
+        size_t new_capacity = h->capacity * 2;
+
+        if (new_capacity < req_capacity) {
+            new_capacity = req_capacity;
+        }
+
+        array = array_resize(array, new_capacity);
     }
 
     return array;
 }
 
+//----------
+static size_t array_mapped_size(struct array_header *h) {
+    return ARRAY_MMAP_PREFIX + h->capacity * h->item_size;
+}
+
+//----------
+static char *array_mapped_base(struct array_header *h) {
+    return (char *) (h + 1) - ARRAY_MMAP_PREFIX;
+}
+
+//----------
+static struct array_mmap_header *array_mmap_header(struct array_header *h) {
+    return (struct array_mmap_header *) array_mapped_base(h);
+}
+
+//----------
+static int array_size_fits(size_t item_size, size_t capacity, size_t overhead) {
+    // Whether `overhead + item_size * capacity` can be represented
+    return item_size == 0 || capacity <= (SIZE_MAX - overhead) / item_size;
+}
+
+//----------
+static size_t round_up(size_t size, size_t multiple) {
+    return (size + multiple - 1) / multiple * multiple;
+}
+
+//----------
+static size_t array_header_offset(size_t alignment) {
+    // Padding before the header so the items after it are aligned
+    if (alignment == 0) {
+        return 0;
+    }
+
+    return round_up(sizeof(struct array_header), alignment) - sizeof(struct array_header);
+}
+
+//----------
+static size_t array_aligned_size(size_t alignment, size_t item_size, size_t capacity) {
+    return array_header_offset(alignment) + sizeof(struct array_header) + item_size * capacity;
+}
+
+//----------
+static char *array_base(struct array_header *h) {
+    return (char *) h - array_header_offset(h->alignment);
+}
+
+//----------
+static void *array_anon_map(size_t size) {
+    // Over-allocate so the mapping can be trimmed to start on a huge page
+    size_t map_size = size + HUGE_PAGE_SIZE;
+    char *map = (char *) mmap(
+        NULL, map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0
+    );
+
+    if (map == MAP_FAILED) {
+        return NULL;
+    }
+
+    char *base = (char *) round_up((size_t) map, HUGE_PAGE_SIZE);
+
+    if (base > map) {
+        munmap(map, base - map);
+    }
+
+    munmap(base + size, map + map_size - (base + size));
+
+#ifdef MADV_HUGEPAGE
+    madvise(base, size, MADV_HUGEPAGE);
+#endif
+
+    return base;
+}
+
+//----------
+static void *array_aligned_alloc(size_t item_size, size_t capacity, size_t alignment) {
+    // Leave room for the padding and for rounding up to a huge page
+    size_t overhead = array_aligned_size(alignment, 0, 0) + HUGE_PAGE_SIZE;
+
+    if (!array_size_fits(item_size, capacity, overhead)) {
+        return NULL;
+    }
+
+    size_t size = array_aligned_size(alignment, item_size, capacity);
+    unsigned int flags;
+    char *base;
+
+    if (size >= ARRAY_HUGE_PAGE_THRESHOLD) {
+        size = round_up(size, HUGE_PAGE_SIZE);
+        base = (char *) array_anon_map(size);
+        flags = ARRAY_STORAGE_MMAP_ANON;
+    } else {
+        void *ptr = NULL;
+        size_t min_align = alignment < sizeof(void *) ? sizeof(void *) : alignment;
+
+        base = posix_memalign(&ptr, min_align, size) == 0 ? (char *) ptr : NULL;
+        flags = ARRAY_STORAGE_HEAP_ALIGNED;
+    }
+
+    if (!base) {
+        return NULL;
+    }
+
+    struct array_header *h = (struct array_header *) (base + array_header_offset(alignment));
+    h->capacity = capacity;
+    h->length = 0;
+    h->item_size = item_size;
+    h->refcount = 1;
+    h->flags = flags;
+    h->fd = -1;
+    h->alignment = alignment;
+
+    return h + 1;
+}
+
+//----------
+static size_t array_anon_size(struct array_header *h) {
+    return round_up(array_aligned_size(h->alignment, h->item_size, h->capacity), HUGE_PAGE_SIZE);
+}
+
+//----------
+static void array_free(struct array_header *h) {
+    switch (h->flags) {
+        case ARRAY_STORAGE_HEAP:
+            free(h);
+            break;
+        case ARRAY_STORAGE_HEAP_ALIGNED:
+            free(array_base(h));
+            break;
+        case ARRAY_STORAGE_MMAP_ANON:
+            munmap(array_base(h), array_anon_size(h));
+            break;
+        case ARRAY_STORAGE_INLINE:
+            // Owned by the caller
+            break;
+        default: {
+            int fd = h->fd;
+            array_mmap_header(h)->length = h->length;
+            munmap(array_mapped_base(h), array_mapped_size(h));
+            close(fd);
+            break;
+        }
+    }
+}
+
+//----------
+static void *array_alloc_like(struct array_header *h, size_t capacity) {
+    if (h->alignment) {
+        return array_aligned_alloc(h->item_size, capacity, h->alignment);
+    }
+
+    void *array = array_init(h->item_size, capacity);
+
+    if (array) {
+        array_header(array)->length = 0;
+    }
+
+    return array;
+}
+
+//----------
+static void *array_aligned_resize(void *array, size_t new_capacity) {
+    struct array_header *h = array_header(array);
+    size_t new_size = array_aligned_size(h->alignment, h->item_size, new_capacity);
+
+    // Large mappings grow in place or are moved by the kernel
+    if (h->flags == ARRAY_STORAGE_MMAP_ANON && new_size >= ARRAY_HUGE_PAGE_THRESHOLD) {
+        size_t old_map = array_anon_size(h);
+        size_t new_map = round_up(new_size, HUGE_PAGE_SIZE);
+        size_t offset = array_header_offset(h->alignment);
+        char *base = (char *) mremap(array_base(h), old_map, new_map, MREMAP_MAYMOVE);
+
+        if (base == MAP_FAILED) {
+            return NULL;
+        }
+
+#ifdef MADV_HUGEPAGE
+        madvise(base, new_map, MADV_HUGEPAGE);
+#endif
+
+        h = (struct array_header *) (base + offset);
+        h->capacity = new_capacity;
+
+        return h + 1;
+    }
+
+    void *copy = array_aligned_alloc(h->item_size, new_capacity, h->alignment);
+
+    if (!copy) {
+        return NULL;
+    }
+
+    memcpy(copy, array, h->length * h->item_size);
+    array_header(copy)->length = h->length;
+    array_free(h);
+
+    return copy;
+}
+
+//----------
+static void *array_heap_resize(void *array, size_t new_capacity) {
+    struct array_header *h = array_header(array);
+
+    if (!array_size_fits(h->item_size, new_capacity, sizeof(struct array_header))) {
+        return NULL;
+    }
+
+    size_t new_size = h->item_size * new_capacity + sizeof(struct array_header);
+
+    h = (struct array_header *) realloc(h, new_size);
+
+    if (!h) {
+        return NULL;
+    }
+
+    h->capacity = new_capacity;
+
+    return h + 1;
+}
+
+//----------
+static void *array_mmap_resize(void *array, size_t new_capacity) {
+    struct array_header *h = array_header(array);
+
+    if (!array_size_fits(h->item_size, new_capacity, ARRAY_MMAP_PREFIX)) {
+        return NULL;
+    }
+
+    size_t old_size = array_mapped_size(h);
+    size_t new_size = ARRAY_MMAP_PREFIX + new_capacity * h->item_size;
+
+    if (ftruncate(h->fd, new_size) != 0) {
+        return NULL;
+    }
+
+    char *base = (char *) mremap(array_mapped_base(h), old_size, new_size, MREMAP_MAYMOVE);
+
+    if (base == MAP_FAILED) {
+        return NULL;
+    }
+
+    h = array_header(base + ARRAY_MMAP_PREFIX);
+    h->capacity = new_capacity;
+
+    return h + 1;
+}
+
+//----------
+static void *array_move_to_heap(void *array, size_t new_capacity) {
+    struct array_header *h = array_header(array);
+    size_t keep = h->length < new_capacity ? h->length : new_capacity;
+    void *copy = array_alloc_like(h, new_capacity);
+
+    if (!copy) {
+        return NULL;
+    }
+
+    memcpy(copy, array, keep * h->item_size);
+    array_header(copy)->length = keep;
+    array_destroy(array);
+
+    return copy;
+}
+
+//----------
+static void *array_mmap_fd(int fd, int writable) {
+    struct stat st;
+
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < ARRAY_MMAP_PREFIX) {
+        return NULL;
+    }
+
+    // Read-only arrays use a private mapping so the header can still be
+    // updated in memory without touching the file
+    char *base = (char *) mmap(
+        NULL,
+        st.st_size,
+        PROT_READ | PROT_WRITE,
+        writable ? MAP_SHARED : MAP_PRIVATE,
+        fd,
+        0
+    );
+
+    if (base == MAP_FAILED) {
+        return NULL;
+    }
+
+    return base + ARRAY_MMAP_PREFIX;
+}
+
 
 //----------
 void *array_init(size_t item_size, size_t initial_length) {
+    if (!array_size_fits(item_size, initial_length, sizeof(struct array_header))) {
+        return NULL;
+    }
+
     size_t init_size = item_size * initial_length + sizeof(struct array_header);
     struct array_header *header = (struct array_header *) malloc(init_size);
     void *ptr = NULL;           // pointer to the start of data
@@ -31,6 +386,10 @@ void *array_init(size_t item_size, size_t initial_length) {
         header->length = initial_length;
         header->capacity = initial_length;
         header->item_size = item_size;
+        header->refcount = 1;
+        header->flags = ARRAY_STORAGE_HEAP;
+        header->fd = -1;
+        header->alignment = 0;
 
         ptr = header + 1;
     }
@@ -39,41 +398,149 @@ void *array_init(size_t item_size, size_t initial_length) {
 }
 
 
+//----------
+void *array_init_aligned(size_t item_size, size_t initial_length, size_t alignment) {
+    size_t page_size = sysconf(_SC_PAGESIZE);
+
+    if (alignment == 0 || (alignment & (alignment - 1)) || alignment > page_size) {
+        return NULL;
+    }
+
+    void *array = array_aligned_alloc(item_size, initial_length, alignment);
+
+    if (array) {
+        array_header(array)->length = initial_length;
+    }
+
+    return array;
+}
+
+
+//----------
+void *array_init_inline(void *storage, size_t storage_size, size_t item_size) {
+    if (storage_size < sizeof(struct array_header)) {
+        return NULL;
+    }
+
+    struct array_header *h = (struct array_header *) storage;
+    size_t space = storage_size - sizeof(struct array_header);
+
+    h->capacity = item_size ? space / item_size : 0;
+    h->length = 0;
+    h->item_size = item_size;
+    h->refcount = 1;
+    h->flags = ARRAY_STORAGE_INLINE;
+    h->fd = -1;
+    h->alignment = 0;
+
+    return h + 1;
+}
+
+
+//----------
+int array_is_inline(void *array) {
+    return array_header(array)->flags == ARRAY_STORAGE_INLINE;
+}
+
+
+//----------
+size_t array_alignment(void *array) {
+    return array_header(array)->alignment;
+}
+
+
 //----------
 void array_destroy(void *array) {
     struct array_header *h = array_header(array);
-    free(h);
 
-    return;
+    // Other owners still use the buffer
+    if (__atomic_sub_fetch(&h->refcount, 1, __ATOMIC_ACQ_REL) > 0) {
+        return;
+    }
+
+    array_free(h);
 }
 
 
 //----------
 void *array_resize(void *array, size_t new_capacity) {
-    // void *header at the start of allocated data
     struct array_header *h = array_header(array);
-    size_t new_size = h->item_size * new_capacity + sizeof(struct array_header);
 
-    h = (struct array_header *) realloc(h, new_size);
-    h->capacity = new_capacity;
-    
-    return h != NULL ? (h + 1) : NULL;
+    if (!array_is_unique(array)) {
+        return array_move_to_heap(array, new_capacity);
+    }
+
+    if (h->length > new_capacity) {
+        h->length = new_capacity;
+    }
+
+    switch (h->flags) {
+        case ARRAY_STORAGE_MMAP_SHARED:
+            return array_mmap_resize(array, new_capacity);
+        case ARRAY_STORAGE_MMAP_PRIVATE:
+            // A read-only mapping cannot grow the file
+            return array_move_to_heap(array, new_capacity);
+        case ARRAY_STORAGE_HEAP_ALIGNED:
+        case ARRAY_STORAGE_MMAP_ANON:
+            return array_aligned_resize(array, new_capacity);
+        case ARRAY_STORAGE_INLINE:
+            // The storage cannot shrink, and spills to the heap once outgrown
+            if (new_capacity <= h->capacity) {
+                return array;
+            }
+
+            return array_move_to_heap(array, new_capacity);
+        default:
+            return array_heap_resize(array, new_capacity);
+    }
+}
+
+//----------
+static void *array_ensure_unique_capacity(void *array, size_t n_append) {
+    if (array_is_unique(array)) {
+        return array_ensure_capacity(array, n_append);
+    }
+
+    // Copy a shared array straight into the capacity needed, so that on
+    // failure the caller's reference is still valid
+    size_t required = array_length(array) + n_append;
+    size_t capacity = array_capacity(array);
+
+    return array_move_to_heap(array, capacity > required ? capacity : required);
+}
+
+//----------
+void *array_set_length(void *array, size_t new_length) {
+    size_t length = array_length(array);
+
+    if (new_length > length) {
+        array = array_ensure_unique_capacity(array, new_length - length);
+    } else {
+        array = array_unshare(array);
+    }
+
+    if (array) {
+        array_header(array)->length = new_length;
+    }
+
+    return array;
 }
 
 //----------
 void *array_append(void *array, void *item) {
-    array = array_ensure_capacity(array, 1);
+    array = array_ensure_unique_capacity(array, 1);
+
+    if (!array) {
+        return NULL;
+    }
 
     // Location of array header may change after ensure_capacity
     struct array_header *h = array_header(array);
 
     char *data_ptr = (char *)array;
-
-    if (array) {
-        char *dest = data_ptr + h->length * h->item_size;
-        memcpy(dest, item, h->item_size);
-        h->length++;
-    }
+    char *dest = data_ptr + h->length * h->item_size;
+    memcpy(dest, item, h->item_size);
+    h->length++;
 
     return array;
 }
@@ -82,6 +549,14 @@ void *array_pop(void *array, void *item) {
     struct array_header *h = array_header(array);
 
     if (h->length > 0) {
+        array = array_unshare(array);
+
+        if (!array) {
+            return NULL;
+        }
+
+        h = array_header(array);
+
         h->length--;
 
         if (item) {
@@ -94,19 +569,234 @@ void *array_pop(void *array, void *item) {
     return array;
 }
 
-void *array_get(void *array, size_t index, void *item) {
+void *array_insert_range(void *array, size_t index, const void *items, size_t n_items) {
+    if (index > array_length(array)) {
+        return array;
+    }
+
+    array = array_ensure_unique_capacity(array, n_items);
+
+    if (!array) {
+        return NULL;
+    }
+
+    struct array_header *h = array_header(array);
+    char *data_ptr = (char *)array;
+    char *dest = data_ptr + index * h->item_size;
+
+    // Open a gap for the new items
+    memmove(dest + n_items * h->item_size, dest, (h->length - index) * h->item_size);
+    memcpy(dest, items, n_items * h->item_size);
+    h->length += n_items;
+
+    return array;
+}
+
+
+//----------
+void *array_erase_range(void *array, size_t start, size_t end) {
+    struct array_header *h = array_header(array);
+
+    if (start >= end || end > h->length) {
+        return array;
+    }
+
+    array = array_unshare(array);
+
+    if (!array) {
+        return NULL;
+    }
+
+    h = array_header(array);
+    char *data_ptr = (char *)array;
+
+    memmove(
+        data_ptr + start * h->item_size,
+        data_ptr + end * h->item_size,
+        (h->length - end) * h->item_size
+    );
+    h->length -= end - start;
+
+    return array;
+}
+
+
+//----------
+void *array_remove_if(
+    void *array,
+    int (*predicate)(const void *item, void *ctx),
+    void *ctx
+) {
+    array = array_unshare(array);
+
+    if (!array) {
+        return NULL;
+    }
+
     struct array_header *h = array_header(array);
+    char *data_ptr = (char *)array;
+    size_t kept = 0;
+
+    // Move each kept item down over the removed ones
+    for (size_t i = 0; i < h->length; i++) {
+        char *item = data_ptr + i * h->item_size;
+
+        if (predicate(item, ctx)) {
+            continue;
+        }
 
-    if (index < h->length) {
-        char *data_ptr = (char *)array;
-        char *src = data_ptr + index * h->item_size;
-        memcpy(item, src, h->item_size);
+        if (kept != i) {
+            memcpy(data_ptr + kept * h->item_size, item, h->item_size);
+        }
+
+        kept++;
     }
 
+    h->length = kept;
+
     return array;
 }
 
 
+//----------
+void *array_unique(
+    void *array,
+    int (*compare)(const void *a, const void *b)
+) {
+    if (array_length(array) < 2) {
+        return array;
+    }
+
+    array = array_unshare(array);
+
+    if (!array) {
+        return NULL;
+    }
+
+    struct array_header *h = array_header(array);
+    char *data_ptr = (char *)array;
+    size_t kept = 1;
+
+    for (size_t i = 1; i < h->length; i++) {
+        char *item = data_ptr + i * h->item_size;
+        char *last = data_ptr + (kept - 1) * h->item_size;
+
+        if (compare(last, item) == 0) {
+            continue;
+        }
+
+        if (kept != i) {
+            memcpy(data_ptr + kept * h->item_size, item, h->item_size);
+        }
+
+        kept++;
+    }
+
+    h->length = kept;
+
+    return array;
+}
+
+
+//----------
+void *array_get(void *array, size_t index, void *item) {
+    void *src = array_at(array, index);
+
+    if (!src) {
+        return NULL;
+    }
+
+    memcpy(item, src, array_header(array)->item_size);
+
+    return array;
+}
+
+
+//----------
+void *array_at(void *array, size_t index) {
+    struct array_header *h = array_header(array);
+
+    if (index >= h->length) {
+        return NULL;
+    }
+
+    return (char *)array + index * h->item_size;
+}
+
+
+//----------
+void *array_back(void *array) {
+    struct array_header *h = array_header(array);
+
+    if (h->length == 0) {
+        return NULL;
+    }
+
+    return (char *)array + (h->length - 1) * h->item_size;
+}
+
+
+//----------
+void *array_data_range(void *array, size_t start, size_t end) {
+    struct array_header *h = array_header(array);
+
+    if (start > end || end > h->length) {
+        return NULL;
+    }
+
+    return (char *)array + start * h->item_size;
+}
+
+
+//----------
+struct array_view array_slice(void *array, size_t start, size_t end, size_t step) {
+    struct array_header *h = array_header(array);
+    struct array_view whole;
+
+    whole.data = array;
+    whole.length = h->length;
+    whole.stride = h->item_size;
+    whole.item_size = h->item_size;
+
+    return array_view_slice(whole, start, end, step);
+}
+
+
+//----------
+struct array_view array_view_slice(
+    struct array_view view,
+    size_t start,
+    size_t end,
+    size_t step
+) {
+    struct array_view slice;
+
+    slice.data = view.data;
+    slice.length = 0;
+    slice.stride = view.stride * step;
+    slice.item_size = view.item_size;
+
+    if (step == 0 || start > end || end > view.length) {
+        return slice;
+    }
+
+    slice.data = (char *)view.data + start * view.stride;
+    slice.length = (end - start + step - 1) / step;
+
+    return slice;
+}
+
+
+//----------
+void *array_view_at(struct array_view view, size_t index) {
+    if (index >= view.length) {
+        return NULL;
+    }
+
+    return (char *)view.data + index * view.stride;
+}
+
+
 //----------
 size_t array_length(void *array) {
     struct array_header *h = array_header(array);
@@ -122,6 +812,12 @@ size_t array_capacity(void *array) {
 
 
 void *array_shuffle(void *array) {
+    array = array_unshare(array);
+
+    if (!array) {
+        return NULL;
+    }
+
     struct array_header *h = array_header(array);
     char *data_ptr = (char*)array;
 
@@ -159,10 +855,11 @@ void *raw_to_array(void *ptr, size_t item_size, size_t length) {
 //----------
 void *array_copy(void *array) {
     struct array_header *h = array_header(array);
-    void *copy = array_init(h->item_size, h->length);
+    void *copy = array_alloc_like(h, h->length);
 
     if (copy) {
         memcpy(copy, array, h->item_size * h->length);
+        array_header(copy)->length = h->length;
     }
 
     return copy;
@@ -175,7 +872,192 @@ size_t array_item_size(void *array) {
 }
 
 //----------
-void array_sort(void *array, int (*compare)(const void *, const void *)) {
+void *array_sort(void *array, int (*compare)(const void *, const void *)) {
+    array = array_unshare(array);
+
+    if (!array) {
+        return NULL;
+    }
+
     struct array_header *h = array_header(array);
     qsort(array, h->length, h->item_size, compare);
+
+    return array;
+}
+
+
+//----------
+void *array_share(void *array) {
+    struct array_header *h = array_header(array);
+
+    // Caller-provided storage dies with its owner, so the other owner gets
+    // its own copy on the heap
+    if (h->flags == ARRAY_STORAGE_INLINE) {
+        return array_copy(array);
+    }
+
+    __atomic_add_fetch(&h->refcount, 1, __ATOMIC_RELAXED);
+
+    return array;
+}
+
+
+//----------
+int array_is_unique(void *array) {
+    struct array_header *h = array_header(array);
+    return __atomic_load_n(&h->refcount, __ATOMIC_ACQUIRE) == 1;
+}
+
+
+//----------
+void *array_unshare(void *array) {
+    if (array_is_unique(array)) {
+        return array;
+    }
+
+    return array_move_to_heap(array, array_capacity(array));
+}
+
+//----------
+void *array_mmap_create(const char *path, size_t item_size, size_t capacity) {
+    if (!array_size_fits(item_size, capacity, ARRAY_MMAP_PREFIX)) {
+        return NULL;
+    }
+
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+    if (fd < 0) {
+        return NULL;
+    }
+
+    size_t size = ARRAY_MMAP_PREFIX + capacity * item_size;
+
+    if (ftruncate(fd, size) != 0) {
+        close(fd);
+        return NULL;
+    }
+
+    void *array = array_mmap_fd(fd, 1);
+
+    if (!array) {
+        close(fd);
+        return NULL;
+    }
+
+    struct array_header *h = array_header(array);
+    struct array_mmap_header *file = array_mmap_header(h);
+    file->magic = ARRAY_MMAP_MAGIC;
+    file->version = ARRAY_MMAP_VERSION;
+    file->reserved = 0;
+    file->item_size = item_size;
+    file->length = 0;
+
+    h->capacity = capacity;
+    h->length = 0;
+    h->item_size = item_size;
+    h->refcount = 1;
+    h->flags = ARRAY_STORAGE_MMAP_SHARED;
+    h->fd = fd;
+    h->alignment = 0;
+
+    return array;
+}
+
+//----------
+void *array_mmap_open(const char *path, size_t item_size, int writable) {
+    int fd = open(path, writable ? O_RDWR : O_RDONLY);
+
+    if (fd < 0) {
+        return NULL;
+    }
+
+    void *array = array_mmap_fd(fd, writable);
+
+    if (!array) {
+        close(fd);
+        return NULL;
+    }
+
+    // The capacity is whatever fits in the file
+    struct stat st;
+    struct array_header *h = array_header(array);
+    struct array_mmap_header *file = array_mmap_header(h);
+    fstat(fd, &st);
+
+    size_t file_size = st.st_size;
+    size_t capacity = item_size ? (file_size - ARRAY_MMAP_PREFIX) / item_size : 0;
+
+    if (file->magic != ARRAY_MMAP_MAGIC
+        || file->version != ARRAY_MMAP_VERSION
+        || file->item_size != item_size
+        || file->length > capacity) {
+        munmap(array_mapped_base(h), file_size);
+        close(fd);
+        return NULL;
+    }
+
+    // Only the file header is read; the runtime header is rebuilt
+    h->capacity = capacity;
+    h->length = file->length;
+    h->item_size = item_size;
+    h->refcount = 1;
+    h->flags = writable ? ARRAY_STORAGE_MMAP_SHARED : ARRAY_STORAGE_MMAP_PRIVATE;
+    h->fd = fd;
+    h->alignment = 0;
+
+    // Drop any trailing bytes that do not make up a whole item
+    if (file_size != array_mapped_size(h)) {
+        mremap(array_mapped_base(h), file_size, array_mapped_size(h), 0);
+    }
+
+    return array;
+}
+
+//----------
+int array_mmap_advise(void *array, enum array_advice advice) {
+    struct array_header *h = array_header(array);
+    int flag;
+
+    switch (h->flags) {
+        case ARRAY_STORAGE_MMAP_SHARED:
+        case ARRAY_STORAGE_MMAP_PRIVATE:
+        case ARRAY_STORAGE_MMAP_ANON:
+            break;
+        default:
+            return 1;
+    }
+
+    switch (advice) {
+        case ARRAY_ADVICE_SEQUENTIAL:
+            flag = MADV_SEQUENTIAL;
+            break;
+        case ARRAY_ADVICE_RANDOM:
+            flag = MADV_RANDOM;
+            break;
+        case ARRAY_ADVICE_WILLNEED:
+            flag = MADV_WILLNEED;
+            break;
+        default:
+            flag = MADV_NORMAL;
+            break;
+    }
+
+    if (h->flags == ARRAY_STORAGE_MMAP_ANON) {
+        return madvise(array_base(h), array_anon_size(h), flag) != 0;
+    }
+
+    return madvise(array_mapped_base(h), array_mapped_size(h), flag) != 0;
+}
+
+//----------
+int array_mmap_sync(void *array) {
+    struct array_header *h = array_header(array);
+
+    if (h->flags != ARRAY_STORAGE_MMAP_SHARED) {
+        return 1;
+    }
+
+    array_mmap_header(h)->length = h->length;
+
+    return msync(array_mapped_base(h), array_mapped_size(h), MS_SYNC) != 0;
 }
\ No newline at end of file
@@ -23,14 +23,69 @@
 // -------------------- Types
 
 // @todo add custom allocator
+// Runtime state only: files store their own fixed-layout headers, so
+// fields can be added here without changing any file format
 struct array_header {
     size_t capacity;
     size_t length;
     size_t item_size;
+    size_t refcount;        // Number of owners sharing the array
+    unsigned int flags;     // Where the array is stored, e.g. heap or a file
+    int fd;                 // Backing file of a mapped array, otherwise -1
+    size_t alignment;       // Alignment of the items, or 0 if not requested
+};
+
+/**
+ * @brief Expected access pattern of a memory-mapped array
+ * 
+ */
+enum array_advice {
+    ARRAY_ADVICE_NORMAL,
+    ARRAY_ADVICE_SEQUENTIAL,
+    ARRAY_ADVICE_RANDOM,
+    ARRAY_ADVICE_WILLNEED
+};
+
+/**
+ * @brief A non-owning view over a sequence of items
+ * @note A view does not allocate. It is invalidated by any operation that
+ * may move the underlying array, e.g. `array_append` or `array_resize`.
+ * 
+ * @param data Pointer to the first item in the view
+ * @param length Number of items in the view
+ * @param stride Distance in bytes between consecutive items
+ * @param item_size Size of an item in bytes
+ */
+struct array_view {
+    void *data;
+    size_t length;
+    size_t stride;
+    size_t item_size;
 };
 
 // -------------------- Macros
 
+/**
+ * @brief Declares storage for an array of up to `n` items, suitable for
+ * `array_init_inline`
+ * @note e.g. `array_storage(int, 16) storage;` on the stack or as a struct
+ * member
+ * 
+ */
+#define array_storage(type, n) \
+    union { \
+        struct array_header header; \
+        char bytes[sizeof(struct array_header) + sizeof(type) * (n)]; \
+    }
+
+/**
+ * @brief Size in bytes above which aligned arrays are backed by huge pages
+ * 
+ */
+#ifndef ARRAY_HUGE_PAGE_THRESHOLD
+#define ARRAY_HUGE_PAGE_THRESHOLD ((size_t)2 << 20)
+#endif
+
 /**
  * @brief Initialise an array of a given type
  * @note Capacity is initially 0
@@ -52,12 +107,66 @@ struct array_header {
  * 
  * @param item_size Size of data type in bytes
  * @param initial_length Initial length of the array
- * @return `array` A pointer to the start of data
+ * @return `array` A pointer to the start of data, or NULL if the size
+ * overflows or memory could not be allocated
  */
 void *array_init(size_t item_size, size_t initial_length);
 
+/**
+ * @brief Initialise memory for an array whose items start at an aligned
+ * address
+ * @note The header is stored directly before the items, so every other
+ * `array_*` function works unchanged and the alignment is kept when the
+ * array grows or is copied. Arrays of at least
+ * `ARRAY_HUGE_PAGE_THRESHOLD` bytes are allocated with `mmap` and marked
+ * for transparent huge pages.
+ * 
+ * @param item_size Size of data type in bytes
+ * @param initial_length Initial length of the array
+ * @param alignment Alignment of the first item in bytes. Must be a power of
+ * two no larger than the page size, e.g. 64 for a cache line.
+ * @return `array` A pointer to the start of data, or NULL if the alignment
+ * is invalid, the size overflows or memory could not be allocated
+ */
+void *array_init_aligned(size_t item_size, size_t initial_length, size_t alignment);
+
+/**
+ * @brief Initialise an empty array in caller-provided storage
+ * @note The array uses the storage until it outgrows it, then moves to the
+ * heap like any other array. The storage must outlive the array and must
+ * not be reused until `array_destroy` is called, which only frees heap
+ * memory. Shrinking the array with `array_resize` keeps the capacity of
+ * the storage. Use `array_storage` to declare suitably aligned storage.
+ * 
+ * @param storage Pointer to the storage, aligned for a `size_t`
+ * @param storage_size Size of the storage in bytes
+ * @param item_size Size of data type in bytes
+ * @return `array` A pointer to the start of data, or NULL if the storage is
+ * too small for the header
+ */
+void *array_init_inline(void *storage, size_t storage_size, size_t item_size);
+
+/**
+ * @brief Checks whether an array still uses the storage passed to
+ * `array_init_inline`
+ * 
+ * @param array Pointer to the start of the array
+ * @return int 1 if the array is in caller-provided storage, 0 otherwise
+ */
+int array_is_inline(void *array);
+
+/**
+ * @brief Get the alignment requested for an array
+ * 
+ * @param array Pointer to the start of the array
+ * @return size_t The alignment, or 0 if the array was not created with
+ * `array_init_aligned`
+ */
+size_t array_alignment(void *array);
+
 /**
  * @brief Free the memory allocated for an array
+ * @note If the array is shared, only this owner's reference is released
  * 
  * @param array Pointer to the start of the array
  */
@@ -74,12 +183,26 @@ void array_destroy(void *array);
  */
 void *array_resize(void *array, size_t new_capacity);
 
+/**
+ * @brief Sets the length of an array, growing its capacity if needed
+ * @note Items added by growing the length are uninitialised
+ * 
+ * @param array Pointer to the start of the array
+ * @param new_length 
+ * @return void* Pointer to the start of the array, or NULL if memory could
+ * not be allocated, in which case `array` is unchanged and still owned by
+ * the caller
+ */
+void *array_set_length(void *array, size_t new_length);
+
 /**
  * @brief Adds an item to the end of an array
  * 
  * @param array 
  * @param item 
- * @return void* Pointer to the start of the array
+ * @return void* Pointer to the start of the array, or NULL if memory could
+ * not be allocated, in which case `array` is unchanged and still owned by
+ * the caller
  */
 void *array_append(void *array, void *item);
 
@@ -93,16 +216,140 @@ void *array_append(void *array, void *item);
  */
 void *array_pop(void *array, void *item);
 
+/**
+ * @brief Inserts items before the given index
+ * @note If the index is greater than the length, the array is unchanged
+ * 
+ * @param array 
+ * @param index Index to insert the items at
+ * @param items Pointer to `n_items` contiguous items to insert
+ * @param n_items Number of items to insert
+ * @return void* Pointer to the start of the array, or NULL if memory could
+ * not be allocated, in which case `array` is unchanged and still owned by
+ * the caller
+ */
+void *array_insert_range(void *array, size_t index, const void *items, size_t n_items);
+
+/**
+ * @brief Removes the items [start, end) from the array
+ * @note If the range is invalid, the array is unchanged
+ * 
+ * @param array 
+ * @param start Index of the first item to remove
+ * @param end One past the index of the last item to remove
+ * @return void* Pointer to the start of the array
+ */
+void *array_erase_range(void *array, size_t start, size_t end);
+
+/**
+ * @brief Removes every item matching a predicate, in a single pass
+ * @note The order of the remaining items is preserved. The capacity is not
+ * changed.
+ * 
+ * @param array 
+ * @param predicate Returns non-zero if the item should be removed
+ * @param ctx User data passed to the predicate
+ * @return void* Pointer to the start of the array
+ */
+void *array_remove_if(
+    void *array,
+    int (*predicate)(const void *item, void *ctx),
+    void *ctx
+);
+
+/**
+ * @brief Removes consecutive duplicate items, keeping the first of each run
+ * @note On a sorted array this leaves only distinct items
+ * 
+ * @param array 
+ * @param compare A comparitor function, as for `array_sort`. Items comparing
+ * equal are duplicates.
+ * @return void* Pointer to the start of the array
+ */
+void *array_unique(
+    void *array,
+    int (*compare)(const void *a, const void *b)
+);
+
 /**
  * @brief Retrieves the item at the given index
  * 
  * @param array 
  * @param index 
  * @param item The item at the given index
- * @return void* Pointer to the start of the array
+ * @return void* Pointer to the start of the array, or NULL if the index is
+ * out of range
  */
 void *array_get(void *array, size_t index, void *item);
 
+/**
+ * @brief Returns a pointer to the item at the given index without copying
+ * @note The pointer is invalidated if the array is moved, e.g. by
+ * `array_append` or `array_resize`
+ * 
+ * @param array 
+ * @param index 
+ * @return void* Pointer to the item, or NULL if the index is out of range
+ */
+void *array_at(void *array, size_t index);
+
+/**
+ * @brief Returns a pointer to the last item without copying
+ * 
+ * @param array 
+ * @return void* Pointer to the last item, or NULL if the array is empty
+ */
+void *array_back(void *array);
+
+/**
+ * @brief Returns a pointer to the first item of the range [start, end)
+ * 
+ * @param array 
+ * @param start Index of the first item in the range
+ * @param end One past the index of the last item in the range
+ * @return void* Pointer to the item at `start`, or NULL if the range is
+ * invalid
+ */
+void *array_data_range(void *array, size_t start, size_t end);
+
+/**
+ * @brief Creates a view over the items [start, end) of an array, taking
+ * every `step`th item
+ * @note An invalid range or a step of 0 yields an empty view
+ * 
+ * @param array 
+ * @param start Index of the first item in the view
+ * @param end One past the index of the last item in the view
+ * @param step Distance in items between consecutive items in the view
+ * @return struct array_view 
+ */
+struct array_view array_slice(void *array, size_t start, size_t end, size_t step);
+
+/**
+ * @brief Creates a view over a sub-range of another view
+ * 
+ * @param view 
+ * @param start Index of the first item in the sub-view
+ * @param end One past the index of the last item in the sub-view
+ * @param step Distance in items between consecutive items in the sub-view
+ * @return struct array_view 
+ */
+struct array_view array_view_slice(
+    struct array_view view,
+    size_t start,
+    size_t end,
+    size_t step
+);
+
+/**
+ * @brief Returns a pointer to the item at the given index of a view
+ * 
+ * @param view 
+ * @param index 
+ * @return void* Pointer to the item, or NULL if the index is out of range
+ */
+void *array_view_at(struct array_view view, size_t index);
+
 /**
  * @brief Get the length of an array
  * 
@@ -158,15 +405,100 @@ size_t array_item_size(void *array);
 
 /**
  * @brief Sorts an array in place
+ * @note A shared array is copied before it is sorted
  * 
  * @param array The array to sort
  * @param compare A comparitor function. Returns < 0 if a should come before b,
  * 0 if a and b are equal, and > 0 if a should come after b
+ * @return void* Pointer to the start of the sorted array
  */
-void array_sort(
+void *array_sort(
     void *array, 
     int (*compare)(const void *a, const void *b)
 );
 
+/**
+ * @brief Shares an array with another owner in O(1)
+ * @note Both owners use the same buffer until one of them mutates it with
+ * `array_append`, `array_pop`, `array_resize`, `array_sort` or
+ * `array_shuffle`, which copy the buffer first. Each owner must call
+ * `array_destroy`. Writing to items directly, e.g. through `array_at`,
+ * affects every owner; call `array_unshare` first.
+ * 
+ * An array in caller-provided storage is not shared, since the storage
+ * may not outlive the other owner: the other owner gets a copy on the heap
+ * instead, and the caller keeps the inline array.
+ * 
+ * @param array 
+ * @return void* Pointer to the shared array, or to the copy of an inline
+ * array, which is NULL if it could not be allocated
+ */
+void *array_share(void *array);
+
+/**
+ * @brief Checks whether the caller is the only owner of an array
+ * 
+ * @param array 
+ * @return int 1 if the array is not shared, 0 otherwise
+ */
+int array_is_unique(void *array);
+
+/**
+ * @brief Ensures the caller is the only owner of an array, copying it if it
+ * is shared
+ * 
+ * @param array 
+ * @return void* Pointer to the uniquely owned array, or NULL if the copy
+ * failed
+ */
+void *array_unshare(void *array);
+
+
+/**
+ * @brief Creates an array stored in a memory-mapped file
+ * @note The file starts with a fixed-size, versioned header holding the
+ * item size and length, followed by the items. The length in the file is
+ * updated by `array_mmap_sync` and `array_destroy`. Any existing file at
+ * `path` is truncated. The array is used like any other array, and growing
+ * it extends the file.
+ * 
+ * @param path Path of the file to create
+ * @param item_size Size of the data type in bytes
+ * @param capacity Initial capacity of the array
+ * @return void* Pointer to the start of the array, or NULL on failure
+ */
+void *array_mmap_create(const char *path, size_t item_size, size_t capacity);
+
+/**
+ * @brief Opens an array previously created with `array_mmap_create`
+ * @note If `writable` is 0, changes to the array are private to the process
+ * and growing the array moves it to the heap
+ * 
+ * @param path Path of the file to open
+ * @param item_size Expected size of the data type in bytes
+ * @param writable 1 if changes should be written back to the file
+ * @return void* Pointer to the start of the array, or NULL if the file
+ * cannot be mapped, has an unknown format or version, or does not hold an
+ * array of `item_size` items
+ */
+void *array_mmap_open(const char *path, size_t item_size, int writable);
+
+/**
+ * @brief Tells the kernel how a memory-mapped array will be accessed
+ * 
+ * @param array 
+ * @param advice 
+ * @return int 0 if successful, 1 otherwise or if the array is not mapped
+ */
+int array_mmap_advise(void *array, enum array_advice advice);
+
+/**
+ * @brief Flushes changes to a writable memory-mapped array to its file
+ * 
+ * @param array 
+ * @return int 0 if successful, 1 otherwise or if the array is not writable
+ */
+int array_mmap_sync(void *array);
+
 
 #endif // ARRAY_H
\ No newline at end of file
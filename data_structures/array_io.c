@@ -0,0 +1,417 @@
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE         // pwrite
+#endif
+
+#include "array_io.h"
+#include "array_kernels.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#if defined(__x86_64__)
+#define ARRAY_IO_X86
+#include <immintrin.h>
+
+#define TARGET_SSE42 __attribute__((target("sse4.2")))
+#endif
+
+// Largest single read or write, well below what the kernel accepts
+#define IO_CHUNK_BYTES ((size_t)1 << 30)
+
+// Reversed CRC-32C (Castagnoli) polynomial
+#define CRC32C_POLY 0x82f63b78u
+
+static uint32_t crc_table[256];
+static pthread_once_t crc_table_once = PTHREAD_ONCE_INIT;
+
+
+// +---------------------------------------------------------------------------+
+// |                           Static Functions                                |
+// +---------------------------------------------------------------------------+
+
+// -------------------- Checksum
+
+static void crc_table_init(void) {
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t crc = i;
+
+        for (int bit = 0; bit < 8; bit++) {
+            crc = crc & 1 ? (crc >> 1) ^ CRC32C_POLY : crc >> 1;
+        }
+
+        crc_table[i] = crc;
+    }
+}
+
+static uint32_t crc_update_scalar(uint32_t crc, const unsigned char *p, size_t n) {
+    pthread_once(&crc_table_once, crc_table_init);
+
+    for (size_t i = 0; i < n; i++) {
+        crc = crc_table[(crc ^ p[i]) & 0xff] ^ (crc >> 8);
+    }
+
+    return crc;
+}
+
+#ifdef ARRAY_IO_X86
+TARGET_SSE42
+static uint32_t crc_update_sse42(uint32_t crc, const unsigned char *p, size_t n) {
+    uint64_t crc64 = crc;
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        uint64_t word;
+        memcpy(&word, p + i, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+    }
+
+    crc = (uint32_t) crc64;
+
+    for (; i < n; i++) {
+        crc = _mm_crc32_u8(crc, p[i]);
+    }
+
+    return crc;
+}
+#endif
+
+/**
+ * @brief Adds bytes to a running CRC-32C. Start from 0.
+ *
+ * @param crc
+ * @param data
+ * @param n
+ * @return uint32_t
+ */
+static uint32_t crc_update(uint32_t crc, const void *data, size_t n) {
+    const unsigned char *p = (const unsigned char *) data;
+
+    crc = ~crc;
+
+#ifdef ARRAY_IO_X86
+    if (array_simd_level() >= ARRAY_SIMD_SSE42) {
+        return ~crc_update_sse42(crc, p, n);
+    }
+#endif
+
+    return ~crc_update_scalar(crc, p, n);
+}
+
+
+// -------------------- File descriptors
+
+/**
+ * @brief Writes all bytes, retrying short writes
+ *
+ * @param fd
+ * @param data
+ * @param n
+ * @return int 0 if successful, 1 otherwise
+ */
+static int write_full(int fd, const void *data, size_t n) {
+    const char *p = (const char *) data;
+
+    while (n > 0) {
+        ssize_t written = write(fd, p, n < IO_CHUNK_BYTES ? n : IO_CHUNK_BYTES);
+
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (written <= 0) {
+            return 1;
+        }
+
+        p += written;
+        n -= written;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Reads exactly `n` bytes, retrying short reads
+ *
+ * @param fd
+ * @param data
+ * @param n
+ * @return int 0 if successful, 1 on error or end of file
+ */
+static int read_full(int fd, void *data, size_t n) {
+    char *p = (char *) data;
+
+    while (n > 0) {
+        ssize_t got = read(fd, p, n < IO_CHUNK_BYTES ? n : IO_CHUNK_BYTES);
+
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (got <= 0) {
+            return 1;
+        }
+
+        p += got;
+        n -= got;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Reads and validates a header
+ *
+ * @param fd
+ * @param item_size Expected item size, or 0 to accept any
+ * @param header
+ * @return int 0 if successful, 1 otherwise
+ */
+static int header_read(int fd, size_t item_size, struct array_file_header *header) {
+    if (read_full(fd, header, sizeof(*header)) != 0) {
+        return 1;
+    }
+
+    if (header->magic != ARRAY_IO_MAGIC || header->version != ARRAY_IO_VERSION) {
+        return 1;
+    }
+
+    if (header->item_size == 0 || (item_size && header->item_size != item_size)) {
+        return 1;
+    }
+
+    // The payload and the array's header must fit in memory addressable
+    // by this process
+    if (header->length > (SIZE_MAX - sizeof(struct array_header)) / header->item_size) {
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Reads the checksum trailer, if any, and compares it
+ *
+ * @param fd
+ * @param header
+ * @param crc The checksum of the items read
+ * @return int 0 if it matches or the file has no checksum, 1 otherwise
+ */
+static int checksum_verify(int fd, const struct array_file_header *header, uint32_t crc) {
+    if (!(header->flags & ARRAY_IO_CHECKSUM)) {
+        return 0;
+    }
+
+    uint32_t stored;
+
+    if (read_full(fd, &stored, sizeof(stored)) != 0) {
+        return 1;
+    }
+
+    return stored != crc;
+}
+
+/**
+ * @brief Cleans up after a failed chunk read, never freeing the caller's
+ * array
+ *
+ * @param chunk The array read into
+ * @param given The array passed by the caller, or NULL
+ * @return void* NULL
+ */
+static void *reader_fail(void *chunk, void *given) {
+    if (chunk == given) {
+        array_set_length(chunk, 0);
+    } else {
+        array_destroy(chunk);
+    }
+
+    return NULL;
+}
+
+static void header_init(struct array_file_header *header, size_t item_size, unsigned int flags) {
+    memset(header, 0, sizeof(*header));
+    header->magic = ARRAY_IO_MAGIC;
+    header->version = ARRAY_IO_VERSION;
+    header->flags = flags & ARRAY_IO_CHECKSUM;
+    header->item_size = item_size;
+    header->length = 0;
+}
+
+
+// +---------------------------------------------------------------------------+
+// |                           Public Functions                                |
+// +---------------------------------------------------------------------------+
+
+
+//----------
+int array_write(void *array, int fd, unsigned int flags) {
+    struct array_file_header header;
+    size_t bytes = array_length(array) * array_item_size(array);
+
+    header_init(&header, array_item_size(array), flags);
+    header.length = array_length(array);
+
+    if (write_full(fd, &header, sizeof(header)) != 0 || write_full(fd, array, bytes) != 0) {
+        return 1;
+    }
+
+    if (header.flags & ARRAY_IO_CHECKSUM) {
+        uint32_t crc = crc_update(0, array, bytes);
+
+        return write_full(fd, &crc, sizeof(crc));
+    }
+
+    return 0;
+}
+
+
+//----------
+void *array_read(int fd, size_t item_size) {
+    struct array_file_header header;
+
+    if (header_read(fd, item_size, &header) != 0) {
+        return NULL;
+    }
+
+    // Read straight into the final allocation
+    void *array = array_init(header.item_size, header.length);
+    size_t bytes = header.length * header.item_size;
+
+    if (!array) {
+        return NULL;
+    }
+
+    if (read_full(fd, array, bytes) != 0) {
+        array_destroy(array);
+        return NULL;
+    }
+
+    uint32_t crc = header.flags & ARRAY_IO_CHECKSUM ? crc_update(0, array, bytes) : 0;
+
+    if (checksum_verify(fd, &header, crc) != 0) {
+        array_destroy(array);
+        return NULL;
+    }
+
+    return array;
+}
+
+
+//----------
+int array_writer_open(array_writer_t *writer, int fd, size_t item_size, unsigned int flags) {
+    off_t offset = lseek(fd, 0, SEEK_CUR);
+
+    if (offset < 0 || item_size == 0) {
+        return 1;
+    }
+
+    writer->fd = fd;
+    writer->header_offset = offset;
+    writer->crc = 0;
+    header_init(&writer->header, item_size, flags);
+
+    return write_full(fd, &writer->header, sizeof(writer->header));
+}
+
+
+//----------
+int array_writer_write(array_writer_t *writer, const void *items, size_t n_items) {
+    size_t bytes = n_items * writer->header.item_size;
+
+    if (write_full(writer->fd, items, bytes) != 0) {
+        return 1;
+    }
+
+    if (writer->header.flags & ARRAY_IO_CHECKSUM) {
+        writer->crc = crc_update(writer->crc, items, bytes);
+    }
+
+    writer->header.length += n_items;
+
+    return 0;
+}
+
+
+//----------
+int array_writer_finish(array_writer_t *writer) {
+    if (writer->header.flags & ARRAY_IO_CHECKSUM
+        && write_full(writer->fd, &writer->crc, sizeof(writer->crc)) != 0) {
+        return 1;
+    }
+
+    // Fill in the length without moving the file offset
+    ssize_t written = pwrite(
+        writer->fd, &writer->header, sizeof(writer->header), writer->header_offset
+    );
+
+    return written != (ssize_t) sizeof(writer->header);
+}
+
+
+//----------
+int array_reader_open(array_reader_t *reader, int fd, size_t item_size) {
+    if (header_read(fd, item_size, &reader->header) != 0) {
+        return 1;
+    }
+
+    reader->fd = fd;
+    reader->remaining = reader->header.length;
+    reader->crc = 0;
+
+    return 0;
+}
+
+
+//----------
+size_t array_reader_length(array_reader_t *reader) {
+    return reader->header.length;
+}
+
+
+//----------
+void *array_reader_read(array_reader_t *reader, void *out, size_t max_items) {
+    size_t item_size = reader->header.item_size;
+    size_t n = reader->remaining < max_items ? reader->remaining : max_items;
+    void *given = out;
+    void *chunk;
+
+    if (out && array_item_size(out) != item_size) {
+        return NULL;
+    }
+
+    if (out && array_is_unique(out) && array_capacity(out) >= n) {
+        // Fits in place, so this cannot allocate or fail
+        chunk = array_set_length(out, n);
+    } else {
+        // Read into a new array, so a given one stays valid until the
+        // read succeeds; its items are being replaced, so none are copied
+        chunk = array_init(item_size, n);
+    }
+
+    if (!chunk) {
+        return NULL;
+    }
+
+    if (n > 0 && read_full(reader->fd, chunk, n * item_size) != 0) {
+        return reader_fail(chunk, given);
+    }
+
+    reader->remaining -= n;
+
+    if (reader->header.flags & ARRAY_IO_CHECKSUM) {
+        reader->crc = crc_update(reader->crc, chunk, n * item_size);
+    }
+
+    if (n > 0
+        && reader->remaining == 0
+        && checksum_verify(reader->fd, &reader->header, reader->crc) != 0) {
+        return reader_fail(chunk, given);
+    }
+
+    if (given && chunk != given) {
+        array_destroy(given);
+    }
+
+    return chunk;
+}
@@ -0,0 +1,178 @@
+/**
+ * @file array_io.h
+ * @brief Binary serialisation of arrays to file descriptors
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * An array is stored as a `struct array_file_header`, followed by the
+ * items, followed by a CRC-32C of the items if `ARRAY_IO_CHECKSUM` is set.
+ * Values are stored in the byte order of the machine that wrote them, and
+ * files written on a machine of the other byte order are rejected.
+ *
+ * `array_write` and `array_read` transfer a whole array. The streaming
+ * writer and reader transfer the items a chunk at a time, for arrays that
+ * do not fit in memory.
+ *
+ */
+
+#ifndef ARRAY_IO_H
+#define ARRAY_IO_H
+
+#include "array.h"
+
+#include <stdint.h>
+#include <stddef.h>
+
+// -------------------- Types
+
+#define ARRAY_IO_MAGIC 0x59525241u     // "ARRY" when stored little endian
+#define ARRAY_IO_VERSION 1
+
+// Flags of a file
+#define ARRAY_IO_CHECKSUM 0x1           // A CRC-32C follows the items
+
+/**
+ * @brief Header at the start of a serialised array
+ *
+ * @param magic `ARRAY_IO_MAGIC`
+ * @param version The format version, `ARRAY_IO_VERSION`
+ * @param flags e.g. `ARRAY_IO_CHECKSUM`
+ * @param item_size Size of an item in bytes
+ * @param length Number of items
+ *
+ */
+struct array_file_header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t flags;
+    uint64_t item_size;
+    uint64_t length;
+};
+
+/**
+ * @brief Writes an array a chunk of items at a time
+ *
+ * @param fd The file descriptor, which must be seekable
+ * @param header_offset Offset of the header in the file
+ * @param header The header, written again once the length is known
+ * @param crc Running checksum of the items written
+ *
+ */
+typedef struct array_writer {
+    int fd;
+    int64_t header_offset;
+    struct array_file_header header;
+    uint32_t crc;
+} array_writer_t;
+
+/**
+ * @brief Reads an array a chunk of items at a time
+ *
+ * @param fd The file descriptor
+ * @param header The header read from the file
+ * @param remaining Number of items not yet read
+ * @param crc Running checksum of the items read
+ *
+ */
+typedef struct array_reader {
+    int fd;
+    struct array_file_header header;
+    uint64_t remaining;
+    uint32_t crc;
+} array_reader_t;
+
+// +---------------------------------------------------------------------------+
+// |                           Public Interface                                |
+// +---------------------------------------------------------------------------+
+
+/**
+ * @brief Writes an array to a file descriptor
+ *
+ * @param array
+ * @param fd The file descriptor to write to, at its current offset
+ * @param flags 0, or `ARRAY_IO_CHECKSUM` to append a checksum
+ * @return int 0 if successful, 1 otherwise
+ */
+int array_write(void *array, int fd, unsigned int flags);
+
+/**
+ * @brief Reads an array written by `array_write` or an `array_writer_t`
+ * @note The items are read directly into the new array, with no
+ * intermediate buffer
+ *
+ * @param fd The file descriptor to read from, at its current offset
+ * @param item_size The expected size of an item, or 0 to accept any
+ * @return void* The array, or NULL if the header is invalid, the item size
+ * does not match, the file is truncated or the checksum does not match
+ */
+void *array_read(int fd, size_t item_size);
+
+/**
+ * @brief Starts writing an array of unknown length
+ * @note The header is written now, and its length is filled in by
+ * `array_writer_finish`
+ *
+ * @param writer A pointer to the writer object
+ * @param fd A seekable file descriptor to write to, at its current offset
+ * @param item_size Size of an item in bytes
+ * @param flags 0, or `ARRAY_IO_CHECKSUM` to append a checksum
+ * @return int 0 if successful, 1 otherwise
+ */
+int array_writer_open(array_writer_t *writer, int fd, size_t item_size, unsigned int flags);
+
+/**
+ * @brief Writes a chunk of items
+ *
+ * @param writer A pointer to the writer object
+ * @param items Pointer to `n_items` contiguous items, e.g. an array
+ * @param n_items
+ * @return int 0 if successful, 1 otherwise
+ */
+int array_writer_write(array_writer_t *writer, const void *items, size_t n_items);
+
+/**
+ * @brief Writes the checksum and the final length
+ * @note The file offset is left after the end of the array
+ *
+ * @param writer A pointer to the writer object
+ * @return int 0 if successful, 1 otherwise
+ */
+int array_writer_finish(array_writer_t *writer);
+
+/**
+ * @brief Starts reading an array, reading its header
+ *
+ * @param reader A pointer to the reader object
+ * @param fd The file descriptor to read from, at its current offset
+ * @param item_size The expected size of an item, or 0 to accept any
+ * @return int 0 if successful, 1 if the header is invalid or the item size
+ * does not match
+ */
+int array_reader_open(array_reader_t *reader, int fd, size_t item_size);
+
+/**
+ * @brief Get the number of items in the array being read
+ *
+ * @param reader A pointer to the reader object
+ * @return size_t
+ */
+size_t array_reader_length(array_reader_t *reader);
+
+/**
+ * @brief Reads the next chunk of items into an array
+ * @note The checksum is verified when the last chunk is read
+ *
+ * @param reader A pointer to the reader object
+ * @param out Array to read into, replacing its items, or NULL to allocate
+ * one. Reusing the same array for each chunk bounds the memory used.
+ * @param max_items The most items to read
+ * @return void* The array holding the chunk, which is empty once every
+ * item has been read, or NULL if the file is truncated, the checksum does
+ * not match or memory could not be allocated. A given `out` is never freed
+ * on failure: it is still owned by the caller, and is left empty if the
+ * chunk was being read into it. On success `out` may have been replaced by
+ * the returned array.
+ */
+void *array_reader_read(array_reader_t *reader, void *out, size_t max_items);
+
+#endif // ARRAY_IO_H
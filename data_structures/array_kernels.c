@@ -0,0 +1,1055 @@
+#include "array_kernels.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define ARRAY_KERNELS_X86
+#include <immintrin.h>
+
+#define TARGET_SSE42 __attribute__((target("sse4.2")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+// Selected instruction set, -1 until first use
+static int kernel_level = -1;
+
+// Scratch storage large enough for any element type
+union scalar_value {
+    int32_t i32;
+    float f32;
+    double f64;
+};
+
+
+// +---------------------------------------------------------------------------+
+// |                           Static Functions                                |
+// +---------------------------------------------------------------------------+
+
+/**
+ * @brief Returns the best instruction set supported by the CPU
+ *
+ * @return enum array_simd_level
+ */
+static enum array_simd_level cpu_simd_level(void) {
+#ifdef ARRAY_KERNELS_X86
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2")) {
+        return ARRAY_SIMD_AVX2;
+    }
+
+    if (__builtin_cpu_supports("sse4.2")) {
+        return ARRAY_SIMD_SSE42;
+    }
+#endif
+
+    return ARRAY_SIMD_SCALAR;
+}
+
+/**
+ * @brief Checks that the item size of an array matches a kernel element type
+ *
+ * @param array
+ * @param type
+ * @return int 1 if the types match, 0 otherwise
+ */
+static int type_matches(void *array, enum array_scalar type) {
+    size_t item_size = array_item_size(array);
+
+    switch (type) {
+        case ARRAY_INT32:
+            return item_size == sizeof(int32_t);
+        case ARRAY_FLOAT:
+            return item_size == sizeof(float);
+        case ARRAY_DOUBLE:
+            return item_size == sizeof(double);
+    }
+
+    return 0;
+}
+
+
+// -------------------- Scalar kernels
+
+static size_t find_i32_scalar(const int32_t *p, size_t n, int32_t x) {
+    for (size_t i = 0; i < n; i++) {
+        if (p[i] == x) {
+            return i;
+        }
+    }
+
+    return n;
+}
+
+static size_t find_f32_scalar(const float *p, size_t n, float x) {
+    for (size_t i = 0; i < n; i++) {
+        if (p[i] == x) {
+            return i;
+        }
+    }
+
+    return n;
+}
+
+static size_t find_f64_scalar(const double *p, size_t n, double x) {
+    for (size_t i = 0; i < n; i++) {
+        if (p[i] == x) {
+            return i;
+        }
+    }
+
+    return n;
+}
+
+static size_t count_i32_scalar(const int32_t *p, size_t n, int32_t x) {
+    size_t count = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        count += p[i] == x;
+    }
+
+    return count;
+}
+
+static size_t count_f32_scalar(const float *p, size_t n, float x) {
+    size_t count = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        count += p[i] == x;
+    }
+
+    return count;
+}
+
+static size_t count_f64_scalar(const double *p, size_t n, double x) {
+    size_t count = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        count += p[i] == x;
+    }
+
+    return count;
+}
+
+static void minmax_i32_scalar(const int32_t *p, size_t n, int32_t *min, int32_t *max) {
+    for (size_t i = 0; i < n; i++) {
+        *min = p[i] < *min ? p[i] : *min;
+        *max = p[i] > *max ? p[i] : *max;
+    }
+}
+
+static void minmax_f32_scalar(const float *p, size_t n, float *min, float *max) {
+    for (size_t i = 0; i < n; i++) {
+        *min = p[i] < *min ? p[i] : *min;
+        *max = p[i] > *max ? p[i] : *max;
+    }
+}
+
+static void minmax_f64_scalar(const double *p, size_t n, double *min, double *max) {
+    for (size_t i = 0; i < n; i++) {
+        *min = p[i] < *min ? p[i] : *min;
+        *max = p[i] > *max ? p[i] : *max;
+    }
+}
+
+static int64_t sum_i32_scalar(const int32_t *p, size_t n) {
+    int64_t sum = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        sum += p[i];
+    }
+
+    return sum;
+}
+
+static double sum_f32_scalar(const float *p, size_t n) {
+    double sum = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        sum += p[i];
+    }
+
+    return sum;
+}
+
+static double sum_f64_scalar(const double *p, size_t n) {
+    double sum = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        sum += p[i];
+    }
+
+    return sum;
+}
+
+static int64_t dot_i32_scalar(const int32_t *a, const int32_t *b, size_t n) {
+    int64_t sum = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        sum += (int64_t)a[i] * b[i];
+    }
+
+    return sum;
+}
+
+static double dot_f32_scalar(const float *a, const float *b, size_t n) {
+    double sum = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        sum += (double)a[i] * b[i];
+    }
+
+    return sum;
+}
+
+static double dot_f64_scalar(const double *a, const double *b, size_t n) {
+    double sum = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        sum += a[i] * b[i];
+    }
+
+    return sum;
+}
+
+
+#ifdef ARRAY_KERNELS_X86
+
+// -------------------- SSE4.2 kernels
+
+TARGET_SSE42
+static size_t find_i32_sse42(const int32_t *p, size_t n, int32_t x) {
+    __m128i v = _mm_set1_epi32(x);
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(p + i)), v);
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+
+    return i + find_i32_scalar(p + i, n - i, x);
+}
+
+TARGET_SSE42
+static size_t find_f32_sse42(const float *p, size_t n, float x) {
+    __m128 v = _mm_set1_ps(x);
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        int mask = _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(p + i), v));
+
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+
+    return i + find_f32_scalar(p + i, n - i, x);
+}
+
+TARGET_SSE42
+static size_t find_f64_sse42(const double *p, size_t n, double x) {
+    __m128d v = _mm_set1_pd(x);
+    size_t i = 0;
+
+    for (; i + 2 <= n; i += 2) {
+        int mask = _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(p + i), v));
+
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+
+    return i + find_f64_scalar(p + i, n - i, x);
+}
+
+TARGET_SSE42
+static size_t count_i32_sse42(const int32_t *p, size_t n, int32_t x) {
+    __m128i v = _mm_set1_epi32(x);
+    size_t count = 0;
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(p + i)), v);
+        count += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(eq)));
+    }
+
+    return count + count_i32_scalar(p + i, n - i, x);
+}
+
+TARGET_SSE42
+static size_t count_f32_sse42(const float *p, size_t n, float x) {
+    __m128 v = _mm_set1_ps(x);
+    size_t count = 0;
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        count += __builtin_popcount(_mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(p + i), v)));
+    }
+
+    return count + count_f32_scalar(p + i, n - i, x);
+}
+
+TARGET_SSE42
+static size_t count_f64_sse42(const double *p, size_t n, double x) {
+    __m128d v = _mm_set1_pd(x);
+    size_t count = 0;
+    size_t i = 0;
+
+    for (; i + 2 <= n; i += 2) {
+        count += __builtin_popcount(_mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(p + i), v)));
+    }
+
+    return count + count_f64_scalar(p + i, n - i, x);
+}
+
+TARGET_SSE42
+static void minmax_i32_sse42(const int32_t *p, size_t n, int32_t *min, int32_t *max) {
+    __m128i vmin = _mm_set1_epi32(*min);
+    __m128i vmax = _mm_set1_epi32(*max);
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(p + i));
+        vmin = _mm_min_epi32(vmin, v);
+        vmax = _mm_max_epi32(vmax, v);
+    }
+
+    int32_t lanes[4];
+    _mm_storeu_si128((__m128i *)lanes, vmin);
+    minmax_i32_scalar(lanes, 4, min, max);
+    _mm_storeu_si128((__m128i *)lanes, vmax);
+    minmax_i32_scalar(lanes, 4, min, max);
+
+    minmax_i32_scalar(p + i, n - i, min, max);
+}
+
+TARGET_SSE42
+static void minmax_f32_sse42(const float *p, size_t n, float *min, float *max) {
+    __m128 vmin = _mm_set1_ps(*min);
+    __m128 vmax = _mm_set1_ps(*max);
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m128 v = _mm_loadu_ps(p + i);
+        vmin = _mm_min_ps(vmin, v);
+        vmax = _mm_max_ps(vmax, v);
+    }
+
+    float lanes[4];
+    _mm_storeu_ps(lanes, vmin);
+    minmax_f32_scalar(lanes, 4, min, max);
+    _mm_storeu_ps(lanes, vmax);
+    minmax_f32_scalar(lanes, 4, min, max);
+
+    minmax_f32_scalar(p + i, n - i, min, max);
+}
+
+TARGET_SSE42
+static void minmax_f64_sse42(const double *p, size_t n, double *min, double *max) {
+    __m128d vmin = _mm_set1_pd(*min);
+    __m128d vmax = _mm_set1_pd(*max);
+    size_t i = 0;
+
+    for (; i + 2 <= n; i += 2) {
+        __m128d v = _mm_loadu_pd(p + i);
+        vmin = _mm_min_pd(vmin, v);
+        vmax = _mm_max_pd(vmax, v);
+    }
+
+    double lanes[2];
+    _mm_storeu_pd(lanes, vmin);
+    minmax_f64_scalar(lanes, 2, min, max);
+    _mm_storeu_pd(lanes, vmax);
+    minmax_f64_scalar(lanes, 2, min, max);
+
+    minmax_f64_scalar(p + i, n - i, min, max);
+}
+
+TARGET_SSE42
+static int64_t sum_i32_sse42(const int32_t *p, size_t n) {
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(p + i));
+        acc = _mm_add_epi64(acc, _mm_cvtepi32_epi64(v));
+        acc = _mm_add_epi64(acc, _mm_cvtepi32_epi64(_mm_srli_si128(v, 8)));
+    }
+
+    int64_t lanes[2];
+    _mm_storeu_si128((__m128i *)lanes, acc);
+
+    return lanes[0] + lanes[1] + sum_i32_scalar(p + i, n - i);
+}
+
+TARGET_SSE42
+static double sum_f32_sse42(const float *p, size_t n) {
+    __m128d acc = _mm_setzero_pd();
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m128 v = _mm_loadu_ps(p + i);
+        acc = _mm_add_pd(acc, _mm_cvtps_pd(v));
+        acc = _mm_add_pd(acc, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+    }
+
+    double lanes[2];
+    _mm_storeu_pd(lanes, acc);
+
+    return lanes[0] + lanes[1] + sum_f32_scalar(p + i, n - i);
+}
+
+TARGET_SSE42
+static double sum_f64_sse42(const double *p, size_t n) {
+    __m128d acc0 = _mm_setzero_pd();
+    __m128d acc1 = _mm_setzero_pd();
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        acc0 = _mm_add_pd(acc0, _mm_loadu_pd(p + i));
+        acc1 = _mm_add_pd(acc1, _mm_loadu_pd(p + i + 2));
+    }
+
+    double lanes[2];
+    _mm_storeu_pd(lanes, _mm_add_pd(acc0, acc1));
+
+    return lanes[0] + lanes[1] + sum_f64_scalar(p + i, n - i);
+}
+
+TARGET_SSE42
+static int64_t dot_i32_sse42(const int32_t *a, const int32_t *b, size_t n) {
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m128i va = _mm_loadu_si128((const __m128i *)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i *)(b + i));
+
+        // Sign extend to 64-bit lanes so the products are exact
+        acc = _mm_add_epi64(acc, _mm_mul_epi32(_mm_cvtepi32_epi64(va), _mm_cvtepi32_epi64(vb)));
+        acc = _mm_add_epi64(acc, _mm_mul_epi32(
+            _mm_cvtepi32_epi64(_mm_srli_si128(va, 8)),
+            _mm_cvtepi32_epi64(_mm_srli_si128(vb, 8))
+        ));
+    }
+
+    int64_t lanes[2];
+    _mm_storeu_si128((__m128i *)lanes, acc);
+
+    return lanes[0] + lanes[1] + dot_i32_scalar(a + i, b + i, n - i);
+}
+
+TARGET_SSE42
+static double dot_f32_sse42(const float *a, const float *b, size_t n) {
+    __m128d acc = _mm_setzero_pd();
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m128 va = _mm_loadu_ps(a + i);
+        __m128 vb = _mm_loadu_ps(b + i);
+
+        acc = _mm_add_pd(acc, _mm_mul_pd(_mm_cvtps_pd(va), _mm_cvtps_pd(vb)));
+        acc = _mm_add_pd(acc, _mm_mul_pd(
+            _mm_cvtps_pd(_mm_movehl_ps(va, va)),
+            _mm_cvtps_pd(_mm_movehl_ps(vb, vb))
+        ));
+    }
+
+    double lanes[2];
+    _mm_storeu_pd(lanes, acc);
+
+    return lanes[0] + lanes[1] + dot_f32_scalar(a + i, b + i, n - i);
+}
+
+TARGET_SSE42
+static double dot_f64_sse42(const double *a, const double *b, size_t n) {
+    __m128d acc0 = _mm_setzero_pd();
+    __m128d acc1 = _mm_setzero_pd();
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+        acc1 = _mm_add_pd(acc1, _mm_mul_pd(_mm_loadu_pd(a + i + 2), _mm_loadu_pd(b + i + 2)));
+    }
+
+    double lanes[2];
+    _mm_storeu_pd(lanes, _mm_add_pd(acc0, acc1));
+
+    return lanes[0] + lanes[1] + dot_f64_scalar(a + i, b + i, n - i);
+}
+
+
+// -------------------- AVX2 kernels
+
+TARGET_AVX2
+static size_t find_i32_avx2(const int32_t *p, size_t n, int32_t x) {
+    __m256i v = _mm256_set1_epi32(x);
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(p + i)), v);
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+
+    return i + find_i32_scalar(p + i, n - i, x);
+}
+
+TARGET_AVX2
+static size_t find_f32_avx2(const float *p, size_t n, float x) {
+    __m256 v = _mm256_set1_ps(x);
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        int mask = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(p + i), v, _CMP_EQ_OQ));
+
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+
+    return i + find_f32_scalar(p + i, n - i, x);
+}
+
+TARGET_AVX2
+static size_t find_f64_avx2(const double *p, size_t n, double x) {
+    __m256d v = _mm256_set1_pd(x);
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        int mask = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(p + i), v, _CMP_EQ_OQ));
+
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+
+    return i + find_f64_scalar(p + i, n - i, x);
+}
+
+TARGET_AVX2
+static size_t count_i32_avx2(const int32_t *p, size_t n, int32_t x) {
+    __m256i v = _mm256_set1_epi32(x);
+    size_t count = 0;
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(p + i)), v);
+        count += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(eq)));
+    }
+
+    return count + count_i32_scalar(p + i, n - i, x);
+}
+
+TARGET_AVX2
+static size_t count_f32_avx2(const float *p, size_t n, float x) {
+    __m256 v = _mm256_set1_ps(x);
+    size_t count = 0;
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        count += __builtin_popcount(_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(p + i), v, _CMP_EQ_OQ)));
+    }
+
+    return count + count_f32_scalar(p + i, n - i, x);
+}
+
+TARGET_AVX2
+static size_t count_f64_avx2(const double *p, size_t n, double x) {
+    __m256d v = _mm256_set1_pd(x);
+    size_t count = 0;
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        count += __builtin_popcount(_mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(p + i), v, _CMP_EQ_OQ)));
+    }
+
+    return count + count_f64_scalar(p + i, n - i, x);
+}
+
+TARGET_AVX2
+static void minmax_i32_avx2(const int32_t *p, size_t n, int32_t *min, int32_t *max) {
+    __m256i vmin = _mm256_set1_epi32(*min);
+    __m256i vmax = _mm256_set1_epi32(*max);
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(p + i));
+        vmin = _mm256_min_epi32(vmin, v);
+        vmax = _mm256_max_epi32(vmax, v);
+    }
+
+    int32_t lanes[8];
+    _mm256_storeu_si256((__m256i *)lanes, vmin);
+    minmax_i32_scalar(lanes, 8, min, max);
+    _mm256_storeu_si256((__m256i *)lanes, vmax);
+    minmax_i32_scalar(lanes, 8, min, max);
+
+    minmax_i32_scalar(p + i, n - i, min, max);
+}
+
+TARGET_AVX2
+static void minmax_f32_avx2(const float *p, size_t n, float *min, float *max) {
+    __m256 vmin = _mm256_set1_ps(*min);
+    __m256 vmax = _mm256_set1_ps(*max);
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m256 v = _mm256_loadu_ps(p + i);
+        vmin = _mm256_min_ps(vmin, v);
+        vmax = _mm256_max_ps(vmax, v);
+    }
+
+    float lanes[8];
+    _mm256_storeu_ps(lanes, vmin);
+    minmax_f32_scalar(lanes, 8, min, max);
+    _mm256_storeu_ps(lanes, vmax);
+    minmax_f32_scalar(lanes, 8, min, max);
+
+    minmax_f32_scalar(p + i, n - i, min, max);
+}
+
+TARGET_AVX2
+static void minmax_f64_avx2(const double *p, size_t n, double *min, double *max) {
+    __m256d vmin = _mm256_set1_pd(*min);
+    __m256d vmax = _mm256_set1_pd(*max);
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m256d v = _mm256_loadu_pd(p + i);
+        vmin = _mm256_min_pd(vmin, v);
+        vmax = _mm256_max_pd(vmax, v);
+    }
+
+    double lanes[4];
+    _mm256_storeu_pd(lanes, vmin);
+    minmax_f64_scalar(lanes, 4, min, max);
+    _mm256_storeu_pd(lanes, vmax);
+    minmax_f64_scalar(lanes, 4, min, max);
+
+    minmax_f64_scalar(p + i, n - i, min, max);
+}
+
+TARGET_AVX2
+static int64_t sum_i32_avx2(const int32_t *p, size_t n) {
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_add_epi64(acc0, _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i *)(p + i))));
+        acc1 = _mm256_add_epi64(acc1, _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i *)(p + i + 4))));
+    }
+
+    int64_t lanes[4];
+    _mm256_storeu_si256((__m256i *)lanes, _mm256_add_epi64(acc0, acc1));
+
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sum_i32_scalar(p + i, n - i);
+}
+
+TARGET_AVX2
+static double sum_f32_avx2(const float *p, size_t n) {
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_add_pd(acc0, _mm256_cvtps_pd(_mm_loadu_ps(p + i)));
+        acc1 = _mm256_add_pd(acc1, _mm256_cvtps_pd(_mm_loadu_ps(p + i + 4)));
+    }
+
+    double lanes[4];
+    _mm256_storeu_pd(lanes, _mm256_add_pd(acc0, acc1));
+
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sum_f32_scalar(p + i, n - i);
+}
+
+TARGET_AVX2
+static double sum_f64_avx2(const double *p, size_t n) {
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(p + i));
+        acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(p + i + 4));
+    }
+
+    double lanes[4];
+    _mm256_storeu_pd(lanes, _mm256_add_pd(acc0, acc1));
+
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sum_f64_scalar(p + i, n - i);
+}
+
+TARGET_AVX2
+static int64_t dot_i32_avx2(const int32_t *a, const int32_t *b, size_t n) {
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        // Sign extend to 64-bit lanes so the products are exact
+        __m256i a0 = _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i *)(a + i)));
+        __m256i a1 = _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i *)(a + i + 4)));
+        __m256i b0 = _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i *)(b + i)));
+        __m256i b1 = _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i *)(b + i + 4)));
+
+        acc = _mm256_add_epi64(acc, _mm256_mul_epi32(a0, b0));
+        acc = _mm256_add_epi64(acc, _mm256_mul_epi32(a1, b1));
+    }
+
+    int64_t lanes[4];
+    _mm256_storeu_si256((__m256i *)lanes, acc);
+
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + dot_i32_scalar(a + i, b + i, n - i);
+}
+
+TARGET_AVX2
+static double dot_f32_avx2(const float *a, const float *b, size_t n) {
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(
+            _mm256_cvtps_pd(_mm_loadu_ps(a + i)),
+            _mm256_cvtps_pd(_mm_loadu_ps(b + i))
+        ));
+        acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(
+            _mm256_cvtps_pd(_mm_loadu_ps(a + i + 4)),
+            _mm256_cvtps_pd(_mm_loadu_ps(b + i + 4))
+        ));
+    }
+
+    double lanes[4];
+    _mm256_storeu_pd(lanes, _mm256_add_pd(acc0, acc1));
+
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + dot_f32_scalar(a + i, b + i, n - i);
+}
+
+TARGET_AVX2
+static double dot_f64_avx2(const double *a, const double *b, size_t n) {
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+        acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4)));
+    }
+
+    double lanes[4];
+    _mm256_storeu_pd(lanes, _mm256_add_pd(acc0, acc1));
+
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + dot_f64_scalar(a + i, b + i, n - i);
+}
+
+#endif // ARRAY_KERNELS_X86
+
+
+// -------------------- Dispatch
+
+static size_t find_dispatch(const void *p, size_t n, enum array_scalar type, const void *x) {
+    enum array_simd_level level = array_simd_level();
+
+#ifdef ARRAY_KERNELS_X86
+    if (level == ARRAY_SIMD_AVX2) {
+        switch (type) {
+            case ARRAY_INT32: return find_i32_avx2((const int32_t *)p, n, *(const int32_t *)x);
+            case ARRAY_FLOAT: return find_f32_avx2((const float *)p, n, *(const float *)x);
+            case ARRAY_DOUBLE: return find_f64_avx2((const double *)p, n, *(const double *)x);
+        }
+    }
+
+    if (level == ARRAY_SIMD_SSE42) {
+        switch (type) {
+            case ARRAY_INT32: return find_i32_sse42((const int32_t *)p, n, *(const int32_t *)x);
+            case ARRAY_FLOAT: return find_f32_sse42((const float *)p, n, *(const float *)x);
+            case ARRAY_DOUBLE: return find_f64_sse42((const double *)p, n, *(const double *)x);
+        }
+    }
+#endif
+
+    (void)level;
+
+    switch (type) {
+        case ARRAY_INT32: return find_i32_scalar((const int32_t *)p, n, *(const int32_t *)x);
+        case ARRAY_FLOAT: return find_f32_scalar((const float *)p, n, *(const float *)x);
+        case ARRAY_DOUBLE: return find_f64_scalar((const double *)p, n, *(const double *)x);
+    }
+
+    return n;
+}
+
+static size_t count_dispatch(const void *p, size_t n, enum array_scalar type, const void *x) {
+    enum array_simd_level level = array_simd_level();
+
+#ifdef ARRAY_KERNELS_X86
+    if (level == ARRAY_SIMD_AVX2) {
+        switch (type) {
+            case ARRAY_INT32: return count_i32_avx2((const int32_t *)p, n, *(const int32_t *)x);
+            case ARRAY_FLOAT: return count_f32_avx2((const float *)p, n, *(const float *)x);
+            case ARRAY_DOUBLE: return count_f64_avx2((const double *)p, n, *(const double *)x);
+        }
+    }
+
+    if (level == ARRAY_SIMD_SSE42) {
+        switch (type) {
+            case ARRAY_INT32: return count_i32_sse42((const int32_t *)p, n, *(const int32_t *)x);
+            case ARRAY_FLOAT: return count_f32_sse42((const float *)p, n, *(const float *)x);
+            case ARRAY_DOUBLE: return count_f64_sse42((const double *)p, n, *(const double *)x);
+        }
+    }
+#endif
+
+    (void)level;
+
+    switch (type) {
+        case ARRAY_INT32: return count_i32_scalar((const int32_t *)p, n, *(const int32_t *)x);
+        case ARRAY_FLOAT: return count_f32_scalar((const float *)p, n, *(const float *)x);
+        case ARRAY_DOUBLE: return count_f64_scalar((const double *)p, n, *(const double *)x);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Computes the min and max of a non-empty array in a single pass
+ *
+ * @param p
+ * @param n
+ * @param type
+ * @param min Pointer to store the min, of the element type
+ * @param max Pointer to store the max, of the element type
+ */
+static void minmax_dispatch(const void *p, size_t n, enum array_scalar type, void *min, void *max) {
+    enum array_simd_level level = array_simd_level();
+
+    // Seed with the first item
+    memcpy(min, p, type == ARRAY_DOUBLE ? sizeof(double) : sizeof(int32_t));
+    memcpy(max, p, type == ARRAY_DOUBLE ? sizeof(double) : sizeof(int32_t));
+
+#ifdef ARRAY_KERNELS_X86
+    if (level == ARRAY_SIMD_AVX2) {
+        switch (type) {
+            case ARRAY_INT32: minmax_i32_avx2((const int32_t *)p, n, (int32_t *)min, (int32_t *)max); return;
+            case ARRAY_FLOAT: minmax_f32_avx2((const float *)p, n, (float *)min, (float *)max); return;
+            case ARRAY_DOUBLE: minmax_f64_avx2((const double *)p, n, (double *)min, (double *)max); return;
+        }
+    }
+
+    if (level == ARRAY_SIMD_SSE42) {
+        switch (type) {
+            case ARRAY_INT32: minmax_i32_sse42((const int32_t *)p, n, (int32_t *)min, (int32_t *)max); return;
+            case ARRAY_FLOAT: minmax_f32_sse42((const float *)p, n, (float *)min, (float *)max); return;
+            case ARRAY_DOUBLE: minmax_f64_sse42((const double *)p, n, (double *)min, (double *)max); return;
+        }
+    }
+#endif
+
+    (void)level;
+
+    switch (type) {
+        case ARRAY_INT32: minmax_i32_scalar((const int32_t *)p, n, (int32_t *)min, (int32_t *)max); return;
+        case ARRAY_FLOAT: minmax_f32_scalar((const float *)p, n, (float *)min, (float *)max); return;
+        case ARRAY_DOUBLE: minmax_f64_scalar((const double *)p, n, (double *)min, (double *)max); return;
+    }
+}
+
+static void sum_dispatch(const void *p, size_t n, enum array_scalar type, void *result) {
+    enum array_simd_level level = array_simd_level();
+
+#ifdef ARRAY_KERNELS_X86
+    if (level == ARRAY_SIMD_AVX2) {
+        switch (type) {
+            case ARRAY_INT32: *(int64_t *)result = sum_i32_avx2((const int32_t *)p, n); return;
+            case ARRAY_FLOAT: *(double *)result = sum_f32_avx2((const float *)p, n); return;
+            case ARRAY_DOUBLE: *(double *)result = sum_f64_avx2((const double *)p, n); return;
+        }
+    }
+
+    if (level == ARRAY_SIMD_SSE42) {
+        switch (type) {
+            case ARRAY_INT32: *(int64_t *)result = sum_i32_sse42((const int32_t *)p, n); return;
+            case ARRAY_FLOAT: *(double *)result = sum_f32_sse42((const float *)p, n); return;
+            case ARRAY_DOUBLE: *(double *)result = sum_f64_sse42((const double *)p, n); return;
+        }
+    }
+#endif
+
+    (void)level;
+
+    switch (type) {
+        case ARRAY_INT32: *(int64_t *)result = sum_i32_scalar((const int32_t *)p, n); return;
+        case ARRAY_FLOAT: *(double *)result = sum_f32_scalar((const float *)p, n); return;
+        case ARRAY_DOUBLE: *(double *)result = sum_f64_scalar((const double *)p, n); return;
+    }
+}
+
+static void dot_dispatch(const void *a, const void *b, size_t n, enum array_scalar type, void *result) {
+    enum array_simd_level level = array_simd_level();
+
+#ifdef ARRAY_KERNELS_X86
+    if (level == ARRAY_SIMD_AVX2) {
+        switch (type) {
+            case ARRAY_INT32: *(int64_t *)result = dot_i32_avx2((const int32_t *)a, (const int32_t *)b, n); return;
+            case ARRAY_FLOAT: *(double *)result = dot_f32_avx2((const float *)a, (const float *)b, n); return;
+            case ARRAY_DOUBLE: *(double *)result = dot_f64_avx2((const double *)a, (const double *)b, n); return;
+        }
+    }
+
+    if (level == ARRAY_SIMD_SSE42) {
+        switch (type) {
+            case ARRAY_INT32: *(int64_t *)result = dot_i32_sse42((const int32_t *)a, (const int32_t *)b, n); return;
+            case ARRAY_FLOAT: *(double *)result = dot_f32_sse42((const float *)a, (const float *)b, n); return;
+            case ARRAY_DOUBLE: *(double *)result = dot_f64_sse42((const double *)a, (const double *)b, n); return;
+        }
+    }
+#endif
+
+    (void)level;
+
+    switch (type) {
+        case ARRAY_INT32: *(int64_t *)result = dot_i32_scalar((const int32_t *)a, (const int32_t *)b, n); return;
+        case ARRAY_FLOAT: *(double *)result = dot_f32_scalar((const float *)a, (const float *)b, n); return;
+        case ARRAY_DOUBLE: *(double *)result = dot_f64_scalar((const double *)a, (const double *)b, n); return;
+    }
+}
+
+
+// +---------------------------------------------------------------------------+
+// |                           Public Functions                                |
+// +---------------------------------------------------------------------------+
+
+
+//----------
+enum array_simd_level array_simd_level(void) {
+    int level = __atomic_load_n(&kernel_level, __ATOMIC_RELAXED);
+
+    if (level < 0) {
+        level = cpu_simd_level();
+        __atomic_store_n(&kernel_level, level, __ATOMIC_RELAXED);
+    }
+
+    return (enum array_simd_level) level;
+}
+
+
+//----------
+enum array_simd_level array_simd_set_level(enum array_simd_level level) {
+    enum array_simd_level supported = cpu_simd_level();
+
+    if (level > supported) {
+        level = supported;
+    }
+
+    __atomic_store_n(&kernel_level, (int)level, __ATOMIC_RELAXED);
+
+    return level;
+}
+
+
+//----------
+size_t array_find_eq(void *array, enum array_scalar type, const void *value) {
+    size_t n = array_length(array);
+
+    if (!type_matches(array, type)) {
+        return n;
+    }
+
+    return find_dispatch(array, n, type, value);
+}
+
+
+//----------
+size_t array_count_if_eq(void *array, enum array_scalar type, const void *value) {
+    if (!type_matches(array, type)) {
+        return 0;
+    }
+
+    return count_dispatch(array, array_length(array), type, value);
+}
+
+
+//----------
+int array_min(void *array, enum array_scalar type, void *result) {
+    union scalar_value max;
+
+    if (!type_matches(array, type) || array_length(array) == 0) {
+        return 1;
+    }
+
+    minmax_dispatch(array, array_length(array), type, result, &max);
+
+    return 0;
+}
+
+
+//----------
+int array_max(void *array, enum array_scalar type, void *result) {
+    union scalar_value min;
+
+    if (!type_matches(array, type) || array_length(array) == 0) {
+        return 1;
+    }
+
+    minmax_dispatch(array, array_length(array), type, &min, result);
+
+    return 0;
+}
+
+
+//----------
+size_t array_argmin(void *array, enum array_scalar type) {
+    union scalar_value min;
+
+    if (array_min(array, type, &min)) {
+        return array_length(array);
+    }
+
+    return array_find_eq(array, type, &min);
+}
+
+
+//----------
+size_t array_argmax(void *array, enum array_scalar type) {
+    union scalar_value max;
+
+    if (array_max(array, type, &max)) {
+        return array_length(array);
+    }
+
+    return array_find_eq(array, type, &max);
+}
+
+
+//----------
+int array_sum(void *array, enum array_scalar type, void *result) {
+    if (!type_matches(array, type)) {
+        return 1;
+    }
+
+    sum_dispatch(array, array_length(array), type, result);
+
+    return 0;
+}
+
+
+//----------
+int array_dot(void *a, void *b, enum array_scalar type, void *result) {
+    if (!type_matches(a, type) || !type_matches(b, type)) {
+        return 1;
+    }
+
+    if (array_length(a) != array_length(b)) {
+        return 1;
+    }
+
+    dot_dispatch(a, b, array_length(a), type, result);
+
+    return 0;
+}
@@ -0,0 +1,156 @@
+/**
+ * @file array_kernels.h
+ * @brief Vectorised search and reduction kernels over arrays of primitives
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * Each kernel is implemented with AVX2, SSE4.2 and portable scalar code.
+ * The fastest implementation supported by the CPU is selected at runtime.
+ *
+ */
+
+#ifndef ARRAY_KERNELS_H
+#define ARRAY_KERNELS_H
+
+#include "array.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+// -------------------- Types
+
+/**
+ * @brief The element type of an array passed to a kernel
+ * @note `int` and `float` have the same size, so the element type cannot be
+ * deduced from `array_item_size` alone. Kernels check that the item size of
+ * the array matches the element type and fail otherwise.
+ *
+ */
+enum array_scalar {
+    ARRAY_INT32,
+    ARRAY_FLOAT,
+    ARRAY_DOUBLE
+};
+
+/**
+ * @brief Instruction set used by the kernels
+ *
+ */
+enum array_simd_level {
+    ARRAY_SIMD_SCALAR,
+    ARRAY_SIMD_SSE42,
+    ARRAY_SIMD_AVX2
+};
+
+// +---------------------------------------------------------------------------+
+// |                           Public Interface                                |
+// +---------------------------------------------------------------------------+
+
+/**
+ * @brief Get the instruction set currently used by the kernels
+ *
+ * @return enum array_simd_level
+ */
+enum array_simd_level array_simd_level(void);
+
+/**
+ * @brief Restrict the kernels to the given instruction set
+ * @note The level is clamped to what the CPU supports
+ *
+ * @param level
+ * @return enum array_simd_level The level actually selected
+ */
+enum array_simd_level array_simd_set_level(enum array_simd_level level);
+
+/**
+ * @brief Find the first item equal to a value
+ *
+ * @param array
+ * @param type The element type of the array
+ * @param value Pointer to the value to search for
+ * @return size_t The index of the first match, or `array_length(array)` if
+ * there is no match or the type does not match the array
+ */
+size_t array_find_eq(void *array, enum array_scalar type, const void *value);
+
+/**
+ * @brief Count the items equal to a value
+ *
+ * @param array
+ * @param type The element type of the array
+ * @param value Pointer to the value to count
+ * @return size_t The number of matches
+ */
+size_t array_count_if_eq(void *array, enum array_scalar type, const void *value);
+
+/**
+ * @brief Find the smallest item
+ * @note The result is unspecified if the array contains NaN
+ *
+ * @param array
+ * @param type The element type of the array
+ * @param result Pointer to store the smallest item, of the element type
+ * @return int 0 if successful, 1 if the array is empty or the type does not
+ * match the array
+ */
+int array_min(void *array, enum array_scalar type, void *result);
+
+/**
+ * @brief Find the largest item
+ * @note The result is unspecified if the array contains NaN
+ *
+ * @param array
+ * @param type The element type of the array
+ * @param result Pointer to store the largest item, of the element type
+ * @return int 0 if successful, 1 if the array is empty or the type does not
+ * match the array
+ */
+int array_max(void *array, enum array_scalar type, void *result);
+
+/**
+ * @brief Find the index of the first smallest item
+ *
+ * @param array
+ * @param type The element type of the array
+ * @return size_t The index, or `array_length(array)` if the array is empty
+ * or the type does not match the array
+ */
+size_t array_argmin(void *array, enum array_scalar type);
+
+/**
+ * @brief Find the index of the first largest item
+ *
+ * @param array
+ * @param type The element type of the array
+ * @return size_t The index, or `array_length(array)` if the array is empty
+ * or the type does not match the array
+ */
+size_t array_argmax(void *array, enum array_scalar type);
+
+/**
+ * @brief Sum the items of an array
+ * @note Sums are accumulated in a wider type to avoid overflow and precision
+ * loss: `int64_t` for `ARRAY_INT32` and `double` for `ARRAY_FLOAT` and
+ * `ARRAY_DOUBLE`. The order of floating point additions is unspecified.
+ *
+ * @param array
+ * @param type The element type of the array
+ * @param result Pointer to store the sum, of the accumulator type
+ * @return int 0 if successful, 1 if the type does not match the array
+ */
+int array_sum(void *array, enum array_scalar type, void *result);
+
+/**
+ * @brief Compute the dot product of two arrays of the same length
+ * @note The result has the same accumulator type as `array_sum`
+ *
+ * @param a
+ * @param b
+ * @param type The element type of both arrays
+ * @param result Pointer to store the dot product, of the accumulator type
+ * @return int 0 if successful, 1 if the lengths or types do not match
+ */
+int array_dot(void *a, void *b, enum array_scalar type, void *result);
+
+
+#endif // ARRAY_KERNELS_H
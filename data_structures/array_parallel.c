@@ -0,0 +1,376 @@
+#include "array_parallel.h"
+
+// Target size of a block, small enough to stay in a core's L2 cache
+#define BLOCK_BYTES (64 * 1024)
+
+
+// +---------------------------------------------------------------------------+
+// |                           Static Functions                                |
+// +---------------------------------------------------------------------------+
+
+static threadpool_t *pool_or_shared(threadpool_t *pool) {
+    return pool ? pool : threadpool_shared();
+}
+
+/**
+ * @brief Split of an array into blocks
+ *
+ */
+struct blocks {
+    size_t length;
+    size_t block_items;
+    size_t n_blocks;
+};
+
+static struct blocks blocks_of(size_t length, size_t item_size) {
+    struct blocks b;
+
+    b.length = length;
+    b.block_items = item_size < BLOCK_BYTES ? BLOCK_BYTES / item_size : 1;
+    b.n_blocks = (length + b.block_items - 1) / b.block_items;
+
+    return b;
+}
+
+static size_t block_start(const struct blocks *b, size_t block) {
+    return block * b->block_items;
+}
+
+static size_t block_length(const struct blocks *b, size_t block) {
+    size_t start = block_start(b, block);
+    return b->length - start < b->block_items ? b->length - start : b->block_items;
+}
+
+/**
+ * @brief Clears or allocates an output array of `length` items
+ *
+ * @param out
+ * @param item_size
+ * @param length
+ * @return void* The output array, or NULL on failure
+ */
+static void *output_prepare(void *out, size_t item_size, size_t length) {
+    if (!out) {
+        out = array_init(item_size, 0);
+    } else if (array_item_size(out) != item_size) {
+        return NULL;
+    }
+
+    if (!out) {
+        return NULL;
+    }
+
+    return array_set_length(out, length);
+}
+
+
+// -------------------- for
+
+struct for_job {
+    char *data;
+    size_t item_size;
+    struct blocks blocks;
+    void (*body)(void *items, size_t start, size_t n_items, void *ctx);
+    void *ctx;
+};
+
+static void for_task(void *arg, size_t block) {
+    struct for_job *job = (struct for_job *) arg;
+    size_t start = block_start(&job->blocks, block);
+
+    job->body(
+        job->data + start * job->item_size,
+        start,
+        block_length(&job->blocks, block),
+        job->ctx
+    );
+}
+
+
+// -------------------- reduce
+
+struct reduce_job {
+    const char *data;
+    size_t item_size;
+    struct blocks blocks;
+    char *accs;             // One accumulator per block
+    size_t acc_size;
+    void (*reduce)(void *acc, const void *items, size_t n_items, void *ctx);
+    void *ctx;
+};
+
+static void reduce_task(void *arg, size_t block) {
+    struct reduce_job *job = (struct reduce_job *) arg;
+    size_t start = block_start(&job->blocks, block);
+
+    job->reduce(
+        job->accs + block * job->acc_size,
+        job->data + start * job->item_size,
+        block_length(&job->blocks, block),
+        job->ctx
+    );
+}
+
+
+// -------------------- scan
+
+struct scan_job {
+    const char *src;
+    char *dest;
+    size_t item_size;
+    struct blocks blocks;
+    const void *identity;
+    char *totals;           // Total, then starting offset, of each block
+    char *tmp;              // Scratch item per block for in-place scans
+    int inclusive;
+    void (*op)(void *acc, const void *item, void *ctx);
+    void *ctx;
+};
+
+static void scan_total_task(void *arg, size_t block) {
+    struct scan_job *job = (struct scan_job *) arg;
+    size_t size = job->item_size;
+    const char *items = job->src + block_start(&job->blocks, block) * size;
+    char *total = job->totals + block * size;
+
+    memcpy(total, job->identity, size);
+
+    for (size_t i = 0; i < block_length(&job->blocks, block); i++) {
+        job->op(total, items + i * size, job->ctx);
+    }
+}
+
+static void scan_block_task(void *arg, size_t block) {
+    struct scan_job *job = (struct scan_job *) arg;
+    size_t size = job->item_size;
+    size_t start = block_start(&job->blocks, block);
+    const char *src = job->src + start * size;
+    char *dest = job->dest + start * size;
+    char *running = job->totals + block * size;
+    char *item = job->tmp + block * size;
+
+    for (size_t i = 0; i < block_length(&job->blocks, block); i++) {
+        // Copy the item first in case `dest` and `src` are the same
+        memcpy(item, src + i * size, size);
+
+        if (job->inclusive) {
+            job->op(running, item, job->ctx);
+            memcpy(dest + i * size, running, size);
+        } else {
+            memcpy(dest + i * size, running, size);
+            job->op(running, item, job->ctx);
+        }
+    }
+}
+
+static void *scan(
+    void *array,
+    void *out,
+    const void *identity,
+    void (*op)(void *acc, const void *item, void *ctx),
+    void *ctx,
+    threadpool_t *pool,
+    int inclusive
+) {
+    size_t size = array_item_size(array);
+    size_t length = array_length(array);
+    void *given = out;
+
+    // If `out` is `array` and shared, this copies it and `array` stays valid
+    // through its other owners
+    out = output_prepare(out, size, length);
+
+    if (!out) {
+        return NULL;
+    }
+
+    struct scan_job job;
+    job.src = (const char *)array;
+    job.dest = (char *)out;
+    job.item_size = size;
+    job.blocks = blocks_of(length, size);
+    job.identity = identity;
+    job.inclusive = inclusive;
+    job.op = op;
+    job.ctx = ctx;
+    size_t n_blocks = job.blocks.n_blocks;
+    job.totals = (char *) malloc((2 * n_blocks + 2) * size);
+    job.tmp = job.totals + n_blocks * size;
+
+    if (!job.totals) {
+        if (!given) {
+            array_destroy(out);
+        }
+
+        return NULL;
+    }
+
+    pool = pool_or_shared(pool);
+    threadpool_run(pool, n_blocks, scan_total_task, &job);
+
+    // Turn the block totals into starting offsets
+    char *running = job.tmp + n_blocks * size;
+    char *total = running + size;
+    memcpy(running, identity, size);
+
+    for (size_t b = 0; b < n_blocks; b++) {
+        memcpy(total, job.totals + b * size, size);
+        memcpy(job.totals + b * size, running, size);
+        op(running, total, ctx);
+    }
+
+    threadpool_run(pool, n_blocks, scan_block_task, &job);
+    free(job.totals);
+
+    return out;
+}
+
+
+// -------------------- transform
+
+struct transform_job {
+    const char *src;
+    char *dest;
+    size_t item_size;
+    size_t out_item_size;
+    struct blocks blocks;
+    void (*transform)(void *dest, const void *src, size_t n_items, void *ctx);
+    void *ctx;
+};
+
+static void transform_task(void *arg, size_t block) {
+    struct transform_job *job = (struct transform_job *) arg;
+    size_t start = block_start(&job->blocks, block);
+
+    job->transform(
+        job->dest + start * job->out_item_size,
+        job->src + start * job->item_size,
+        block_length(&job->blocks, block),
+        job->ctx
+    );
+}
+
+
+// +---------------------------------------------------------------------------+
+// |                           Public Functions                                |
+// +---------------------------------------------------------------------------+
+
+
+//----------
+int array_parallel_for(
+    void *array,
+    void (*body)(void *items, size_t start, size_t n_items, void *ctx),
+    void *ctx,
+    threadpool_t *pool
+) {
+    struct for_job job;
+    job.data = (char *)array;
+    job.item_size = array_item_size(array);
+    job.blocks = blocks_of(array_length(array), job.item_size);
+    job.body = body;
+    job.ctx = ctx;
+
+    return threadpool_run(pool_or_shared(pool), job.blocks.n_blocks, for_task, &job);
+}
+
+
+//----------
+int array_parallel_reduce(
+    void *array,
+    void *result,
+    size_t result_size,
+    const void *identity,
+    void (*reduce)(void *acc, const void *items, size_t n_items, void *ctx),
+    void (*combine)(void *acc, const void *other, void *ctx),
+    void *ctx,
+    threadpool_t *pool
+) {
+    struct reduce_job job;
+    job.data = (const char *)array;
+    job.item_size = array_item_size(array);
+    job.blocks = blocks_of(array_length(array), job.item_size);
+    job.acc_size = result_size;
+    job.reduce = reduce;
+    job.ctx = ctx;
+    job.accs = (char *) malloc(job.blocks.n_blocks * result_size + 1);
+
+    if (!job.accs) {
+        return 1;
+    }
+
+    for (size_t b = 0; b < job.blocks.n_blocks; b++) {
+        memcpy(job.accs + b * result_size, identity, result_size);
+    }
+
+    int err = threadpool_run(pool_or_shared(pool), job.blocks.n_blocks, reduce_task, &job);
+
+    memcpy(result, identity, result_size);
+
+    for (size_t b = 0; b < job.blocks.n_blocks; b++) {
+        combine(result, job.accs + b * result_size, ctx);
+    }
+
+    free(job.accs);
+
+    return err;
+}
+
+
+//----------
+void *array_inclusive_scan(
+    void *array,
+    void *out,
+    const void *identity,
+    void (*op)(void *acc, const void *item, void *ctx),
+    void *ctx,
+    threadpool_t *pool
+) {
+    return scan(array, out, identity, op, ctx, pool, 1);
+}
+
+
+//----------
+void *array_exclusive_scan(
+    void *array,
+    void *out,
+    const void *identity,
+    void (*op)(void *acc, const void *item, void *ctx),
+    void *ctx,
+    threadpool_t *pool
+) {
+    return scan(array, out, identity, op, ctx, pool, 0);
+}
+
+
+//----------
+void *array_parallel_transform(
+    void *array,
+    void *out,
+    size_t out_item_size,
+    void (*transform)(void *dest, const void *src, size_t n_items, void *ctx),
+    void *ctx,
+    threadpool_t *pool
+) {
+    size_t length = array_length(array);
+
+    out = output_prepare(out, out_item_size, length);
+
+    if (!out) {
+        return NULL;
+    }
+
+    struct transform_job job;
+    job.src = (const char *)array;
+    job.dest = (char *)out;
+    job.item_size = array_item_size(array);
+    job.out_item_size = out_item_size;
+
+    // Size blocks by the larger of the two items
+    job.blocks = blocks_of(length, job.item_size > out_item_size ? job.item_size : out_item_size);
+    job.transform = transform;
+    job.ctx = ctx;
+
+    threadpool_run(pool_or_shared(pool), job.blocks.n_blocks, transform_task, &job);
+
+    return out;
+}
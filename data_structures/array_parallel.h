@@ -0,0 +1,146 @@
+/**
+ * @file array_parallel.h
+ * @brief Parallel algorithms over arrays
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * Arrays are split into blocks of roughly 64 KiB, which are processed by the
+ * workers of a thread pool. Each function takes the pool to run on; pass
+ * NULL to use a shared pool with one worker per additional CPU, created on
+ * first use.
+ *
+ * Callbacks run concurrently on different blocks and must not modify shared
+ * state without synchronisation.
+ *
+ */
+
+#ifndef ARRAY_PARALLEL_H
+#define ARRAY_PARALLEL_H
+
+#include "array.h"
+#include "../synchronization/threadpool.h"
+
+#include <stddef.h>
+
+// +---------------------------------------------------------------------------+
+// |                           Public Interface                                |
+// +---------------------------------------------------------------------------+
+
+/**
+ * @brief Calls `body` on each block of the array in parallel
+ *
+ * @param array
+ * @param body Called with a pointer to the first item of a block, the index
+ * of that item and the number of items in the block
+ * @param ctx User data passed to `body`
+ * @param pool The pool to run on, or NULL for the shared pool
+ * @return int 0 if successful, 1 otherwise
+ */
+int array_parallel_for(
+    void *array,
+    void (*body)(void *items, size_t start, size_t n_items, void *ctx),
+    void *ctx,
+    threadpool_t *pool
+);
+
+/**
+ * @brief Reduces the array to a single value in parallel
+ * @note Each block is folded into its own accumulator, starting from
+ * `identity`. The accumulators are then combined in block order, so the
+ * result is deterministic for any associative `combine`.
+ *
+ * @param array
+ * @param result Pointer to store the result in
+ * @param result_size Size of the accumulator in bytes
+ * @param identity Pointer to the initial accumulator value
+ * @param reduce Folds a block of items into an accumulator
+ * @param combine Folds the accumulator `other` into `acc`
+ * @param ctx User data passed to `reduce` and `combine`
+ * @param pool The pool to run on, or NULL for the shared pool
+ * @return int 0 if successful, 1 otherwise
+ */
+int array_parallel_reduce(
+    void *array,
+    void *result,
+    size_t result_size,
+    const void *identity,
+    void (*reduce)(void *acc, const void *items, size_t n_items, void *ctx),
+    void (*combine)(void *acc, const void *other, void *ctx),
+    void *ctx,
+    threadpool_t *pool
+);
+
+/**
+ * @brief Stores the inclusive prefix sums of an array, i.e. item i of the
+ * output is `array[0] + ... + array[i]`
+ * @note Uses a two-pass blocked scan: block totals are computed in parallel,
+ * prefixed serially, then each block is scanned from its offset in parallel.
+ * `op` must be associative.
+ *
+ * @param array
+ * @param out Array to store the result in, NULL to allocate one, or `array`
+ * to scan in place
+ * @param identity Pointer to the identity item of `op`, e.g. 0 for addition
+ * @param op Adds `item` to `acc`, both of the array's item type
+ * @param ctx User data passed to `op`
+ * @param pool The pool to run on, or NULL for the shared pool
+ * @return void* Pointer to the output array, or NULL if the item sizes do
+ * not match or memory could not be allocated
+ */
+void *array_inclusive_scan(
+    void *array,
+    void *out,
+    const void *identity,
+    void (*op)(void *acc, const void *item, void *ctx),
+    void *ctx,
+    threadpool_t *pool
+);
+
+/**
+ * @brief Stores the exclusive prefix sums of an array, i.e. item i of the
+ * output is `array[0] + ... + array[i - 1]`, and item 0 is the identity
+ * @note See `array_inclusive_scan`
+ *
+ * @param array
+ * @param out Array to store the result in, NULL to allocate one, or `array`
+ * to scan in place
+ * @param identity Pointer to the identity item of `op`
+ * @param op Adds `item` to `acc`, both of the array's item type
+ * @param ctx User data passed to `op`
+ * @param pool The pool to run on, or NULL for the shared pool
+ * @return void* Pointer to the output array, or NULL on failure
+ */
+void *array_exclusive_scan(
+    void *array,
+    void *out,
+    const void *identity,
+    void (*op)(void *acc, const void *item, void *ctx),
+    void *ctx,
+    threadpool_t *pool
+);
+
+/**
+ * @brief Transforms each block of an array into an output array in parallel
+ *
+ * @param array
+ * @param out Array to store the result in, NULL to allocate one, or `array`
+ * to transform in place if the item sizes match
+ * @param out_item_size Size of an output item in bytes
+ * @param transform Writes `n_items` output items to `dest` from the input
+ * items at `src`
+ * @param ctx User data passed to `transform`
+ * @param pool The pool to run on, or NULL for the shared pool
+ * @return void* Pointer to the output array, or NULL if the item sizes do
+ * not match or memory could not be allocated
+ */
+void *array_parallel_transform(
+    void *array,
+    void *out,
+    size_t out_item_size,
+    void (*transform)(void *dest, const void *src, size_t n_items, void *ctx),
+    void *ctx,
+    threadpool_t *pool
+);
+
+
+#endif // ARRAY_PARALLEL_H
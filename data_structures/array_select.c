@@ -0,0 +1,591 @@
+#include "array_select.h"
+
+#include <stdint.h>
+
+// Ranges this small are finished with insertion sort
+#define SELECT_CUTOFF 16
+
+typedef int (*compare_fn)(const void *a, const void *b);
+
+
+// +---------------------------------------------------------------------------+
+// |                           Static Functions                                |
+// +---------------------------------------------------------------------------+
+
+/**
+ * @brief Returns the recursion depth after which introselect falls back to
+ * heap selection
+ *
+ * @param n
+ * @return size_t 2 * floor(log2(n))
+ */
+static size_t depth_limit(size_t n) {
+    size_t depth = 0;
+
+    while (n >>= 1) {
+        depth++;
+    }
+
+    return 2 * depth;
+}
+
+/**
+ * @brief Clears or allocates an output array with room for `length` items
+ *
+ * @param out
+ * @param item_size
+ * @param length
+ * @return void* The output array with its length set, or NULL on failure
+ */
+static void *output_prepare(void *out, size_t item_size, size_t length) {
+    void *given = out;
+
+    if (!out) {
+        out = array_init(item_size, 0);
+    } else if (array_item_size(out) != item_size) {
+        return NULL;
+    }
+
+    if (!out) {
+        return NULL;
+    }
+
+    void *resized = array_set_length(out, length);
+
+    // A caller's array is left as it was; one allocated here is freed
+    if (!resized && !given) {
+        array_destroy(out);
+    }
+
+    return resized;
+}
+
+
+// -------------------- Comparitor-based selection
+
+/**
+ * @brief Items being selected, with scratch space for a swap and a pivot
+ *
+ */
+struct select_range {
+    char *data;
+    size_t size;
+    compare_fn compare;
+    char *tmp;
+    char *pivot;
+};
+
+static char *item_at(struct select_range *r, size_t i) {
+    return r->data + i * r->size;
+}
+
+static int item_less(struct select_range *r, const void *a, const void *b) {
+    return r->compare(a, b) < 0;
+}
+
+static void item_swap(struct select_range *r, size_t i, size_t j) {
+    memcpy(r->tmp, item_at(r, i), r->size);
+    memcpy(item_at(r, i), item_at(r, j), r->size);
+    memcpy(item_at(r, j), r->tmp, r->size);
+}
+
+/**
+ * @brief Restores the max-heap property below index `i`
+ *
+ */
+static void heap_sift_down(struct select_range *r, size_t n, size_t i) {
+    for (;;) {
+        size_t largest = i;
+        size_t left = 2 * i + 1;
+        size_t right = left + 1;
+
+        if (left < n && item_less(r, item_at(r, largest), item_at(r, left))) {
+            largest = left;
+        }
+
+        if (right < n && item_less(r, item_at(r, largest), item_at(r, right))) {
+            largest = right;
+        }
+
+        if (largest == i) {
+            return;
+        }
+
+        item_swap(r, i, largest);
+        i = largest;
+    }
+}
+
+static void heap_make(struct select_range *r, size_t n) {
+    for (size_t i = n / 2; i-- > 0;) {
+        heap_sift_down(r, n, i);
+    }
+}
+
+static void heap_sort(struct select_range *r, size_t n) {
+    heap_make(r, n);
+
+    for (size_t end = n; end > 1; end--) {
+        item_swap(r, 0, end - 1);
+        heap_sift_down(r, end - 1, 0);
+    }
+}
+
+static void insertion_sort(struct select_range *r, size_t lo, size_t hi) {
+    for (size_t i = lo + 1; i < hi; i++) {
+        memcpy(r->tmp, item_at(r, i), r->size);
+        size_t j = i;
+
+        while (j > lo && item_less(r, r->tmp, item_at(r, j - 1))) {
+            memcpy(item_at(r, j), item_at(r, j - 1), r->size);
+            j--;
+        }
+
+        memcpy(item_at(r, j), r->tmp, r->size);
+    }
+}
+
+/**
+ * @brief Heap selection of `nth` within [lo, hi), used when introselect
+ * partitions badly
+ *
+ */
+static void heap_select(struct select_range *r, size_t lo, size_t hi, size_t nth) {
+    struct select_range sub = *r;
+    sub.data = item_at(r, lo);
+    nth -= lo;
+
+    // Keep the nth + 1 first items in a max-heap
+    heap_make(&sub, nth + 1);
+
+    for (size_t i = nth + 1; i < hi - lo; i++) {
+        if (item_less(&sub, item_at(&sub, i), item_at(&sub, 0))) {
+            item_swap(&sub, i, 0);
+            heap_sift_down(&sub, nth + 1, 0);
+        }
+    }
+
+    item_swap(&sub, 0, nth);
+}
+
+static void introselect(struct select_range *r, size_t n, size_t nth) {
+    size_t lo = 0, hi = n;
+    size_t depth = depth_limit(n);
+
+    while (hi - lo > SELECT_CUTOFF) {
+        if (depth-- == 0) {
+            heap_select(r, lo, hi, nth);
+            return;
+        }
+
+        // Median of three as the pivot value
+        char *a = item_at(r, lo);
+        char *b = item_at(r, lo + (hi - lo) / 2);
+        char *c = item_at(r, hi - 1);
+
+        if (item_less(r, b, a)) { char *t = a; a = b; b = t; }
+        if (item_less(r, c, b)) { b = c; }
+        if (item_less(r, b, a)) { b = a; }
+
+        memcpy(r->pivot, b, r->size);
+
+        // Hoare partition into [lo, j] and [j + 1, hi)
+        size_t i = lo - 1, j = hi;
+
+        for (;;) {
+            do { i++; } while (item_less(r, item_at(r, i), r->pivot));
+            do { j--; } while (item_less(r, r->pivot, item_at(r, j)));
+
+            if (i >= j) {
+                break;
+            }
+
+            item_swap(r, i, j);
+        }
+
+        if (nth <= j) {
+            hi = j + 1;
+        } else {
+            lo = j + 1;
+        }
+    }
+
+    insertion_sort(r, lo, hi);
+}
+
+
+// -------------------- Typed selection
+
+// Generates introselect, heap sort and bounded-heap top-k for one type.
+// `desc` reverses the order and is loop invariant, so the branch on it is
+// predicted perfectly.
+#define SELECT_TYPED(name, T)                                                   \
+static int name##_less(T a, T b, int desc) {                                    \
+    return desc ? b < a : a < b;                                                \
+}                                                                               \
+                                                                                \
+static void name##_sift_down(T *p, size_t n, size_t i, int desc) {             \
+    T item = p[i];                                                              \
+                                                                                \
+    for (;;) {                                                                  \
+        size_t child = 2 * i + 1;                                               \
+                                                                                \
+        if (child >= n) {                                                       \
+            break;                                                              \
+        }                                                                       \
+                                                                                \
+        if (child + 1 < n && name##_less(p[child], p[child + 1], desc)) {       \
+            child++;                                                            \
+        }                                                                       \
+                                                                                \
+        if (!name##_less(item, p[child], desc)) {                               \
+            break;                                                              \
+        }                                                                       \
+                                                                                \
+        p[i] = p[child];                                                        \
+        i = child;                                                              \
+    }                                                                           \
+                                                                                \
+    p[i] = item;                                                                \
+}                                                                               \
+                                                                                \
+static void name##_heap_sort(T *p, size_t n, int desc) {                        \
+    for (size_t i = n / 2; i-- > 0;) {                                          \
+        name##_sift_down(p, n, i, desc);                                        \
+    }                                                                           \
+                                                                                \
+    for (size_t end = n; end > 1; end--) {                                      \
+        T t = p[0]; p[0] = p[end - 1]; p[end - 1] = t;                          \
+        name##_sift_down(p, end - 1, 0, desc);                                  \
+    }                                                                           \
+}                                                                               \
+                                                                                \
+static void name##_heap_select(T *p, size_t n, size_t nth, int desc) {          \
+    for (size_t i = (nth + 1) / 2; i-- > 0;) {                                  \
+        name##_sift_down(p, nth + 1, i, desc);                                  \
+    }                                                                           \
+                                                                                \
+    for (size_t i = nth + 1; i < n; i++) {                                      \
+        if (name##_less(p[i], p[0], desc)) {                                    \
+            T t = p[0]; p[0] = p[i]; p[i] = t;                                  \
+            name##_sift_down(p, nth + 1, 0, desc);                              \
+        }                                                                       \
+    }                                                                           \
+                                                                                \
+    T t = p[0]; p[0] = p[nth]; p[nth] = t;                                      \
+}                                                                               \
+                                                                                \
+static void name##_nth(T *p, size_t n, size_t nth, int desc) {                  \
+    size_t lo = 0, hi = n;                                                      \
+    size_t depth = depth_limit(n);                                              \
+                                                                                \
+    while (hi - lo > SELECT_CUTOFF) {                                           \
+        if (depth-- == 0) {                                                     \
+            name##_heap_select(p + lo, hi - lo, nth - lo, desc);                \
+            return;                                                             \
+        }                                                                       \
+                                                                                \
+        T a = p[lo], b = p[lo + (hi - lo) / 2], c = p[hi - 1];                  \
+        if (name##_less(b, a, desc)) { T t = a; a = b; b = t; }                 \
+        if (name##_less(c, b, desc)) { b = c; }                                 \
+        if (name##_less(b, a, desc)) { b = a; }                                 \
+        T pivot = b;                                                            \
+                                                                                \
+        size_t i = lo - 1, j = hi;                                              \
+                                                                                \
+        for (;;) {                                                              \
+            do { i++; } while (name##_less(p[i], pivot, desc));                 \
+            do { j--; } while (name##_less(pivot, p[j], desc));                 \
+                                                                                \
+            if (i >= j) {                                                       \
+                break;                                                          \
+            }                                                                   \
+                                                                                \
+            T t = p[i]; p[i] = p[j]; p[j] = t;                                  \
+        }                                                                       \
+                                                                                \
+        if (nth <= j) {                                                         \
+            hi = j + 1;                                                         \
+        } else {                                                                \
+            lo = j + 1;                                                         \
+        }                                                                       \
+    }                                                                           \
+                                                                                \
+    for (size_t i = lo + 1; i < hi; i++) {                                      \
+        T item = p[i];                                                          \
+        size_t j = i;                                                           \
+                                                                                \
+        while (j > lo && name##_less(item, p[j - 1], desc)) {                   \
+            p[j] = p[j - 1];                                                    \
+            j--;                                                                \
+        }                                                                       \
+                                                                                \
+        p[j] = item;                                                            \
+    }                                                                           \
+}                                                                               \
+                                                                                \
+static void name##_top_k(const T *p, size_t n, size_t k, T *out, int desc) {    \
+    memcpy(out, p, k * sizeof(T));                                              \
+                                                                                \
+    for (size_t i = k / 2; i-- > 0;) {                                          \
+        name##_sift_down(out, k, i, desc);                                      \
+    }                                                                           \
+                                                                                \
+    for (size_t i = k; i < n; i++) {                                            \
+        if (name##_less(p[i], out[0], desc)) {                                  \
+            out[0] = p[i];                                                      \
+            name##_sift_down(out, k, 0, desc);                                  \
+        }                                                                       \
+    }                                                                           \
+                                                                                \
+    name##_heap_sort(out, k, desc);                                             \
+}
+
+SELECT_TYPED(i32, int32_t)
+SELECT_TYPED(f32, float)
+SELECT_TYPED(f64, double)
+
+/**
+ * @brief Checks that the item size of an array matches an element type
+ *
+ */
+static int type_matches(void *array, enum array_scalar type) {
+    switch (type) {
+        case ARRAY_INT32:
+            return array_item_size(array) == sizeof(int32_t);
+        case ARRAY_FLOAT:
+            return array_item_size(array) == sizeof(float);
+        case ARRAY_DOUBLE:
+            return array_item_size(array) == sizeof(double);
+    }
+
+    return 0;
+}
+
+
+// +---------------------------------------------------------------------------+
+// |                           Public Functions                                |
+// +---------------------------------------------------------------------------+
+
+
+//----------
+void *array_nth_element(void *array, size_t nth, compare_fn compare) {
+    size_t n = array_length(array);
+
+    if (nth >= n) {
+        return array;
+    }
+
+    struct select_range r;
+    r.size = array_item_size(array);
+    r.compare = compare;
+    r.tmp = (char *) malloc(2 * r.size);
+    r.pivot = r.tmp + r.size;
+
+    // Allocate before unsharing, so a failure leaves the caller's array
+    if (!r.tmp) {
+        return NULL;
+    }
+
+    array = array_unshare(array);
+
+    if (!array) {
+        free(r.tmp);
+        return NULL;
+    }
+
+    r.data = (char *)array;
+    introselect(&r, n, nth);
+    free(r.tmp);
+
+    return array;
+}
+
+
+//----------
+void *array_partial_sort(void *array, size_t k, compare_fn compare) {
+    size_t n = array_length(array);
+
+    if (k > n) {
+        k = n;
+    }
+
+    if (k == 0) {
+        return array;
+    }
+
+    struct select_range r;
+    r.size = array_item_size(array);
+    r.compare = compare;
+    r.tmp = (char *) malloc(r.size);
+    r.pivot = NULL;
+
+    if (!r.tmp) {
+        return NULL;
+    }
+
+    array = array_nth_element(array, k - 1, compare);
+
+    if (!array) {
+        free(r.tmp);
+        return NULL;
+    }
+
+    r.data = (char *)array;
+    heap_sort(&r, k - 1);
+    free(r.tmp);
+
+    return array;
+}
+
+
+//----------
+void *array_top_k(void *array, size_t k, compare_fn compare, void *out) {
+    size_t n = array_length(array);
+    size_t size = array_item_size(array);
+
+    if (k > n) {
+        k = n;
+    }
+
+    void *given = out;
+
+    out = output_prepare(out, size, k);
+
+    if (!out || k == 0) {
+        return out;
+    }
+
+    struct select_range r;
+    r.data = (char *)out;
+    r.size = size;
+    r.compare = compare;
+    r.tmp = (char *) malloc(size);
+    r.pivot = NULL;
+
+    // Only free the output if it was allocated here
+    if (!r.tmp) {
+        if (!given) {
+            array_destroy(out);
+        }
+
+        return NULL;
+    }
+
+    // Max-heap of the k first items seen so far
+    memcpy(out, array, k * size);
+    heap_make(&r, k);
+
+    for (size_t i = k; i < n; i++) {
+        char *item = (char *)array + i * size;
+
+        if (item_less(&r, item, out)) {
+            memcpy(out, item, size);
+            heap_sift_down(&r, k, 0);
+        }
+    }
+
+    heap_sort(&r, k);
+    free(r.tmp);
+
+    return out;
+}
+
+
+//----------
+void *array_nth_element_scalar(void *array, size_t nth, enum array_scalar type, int descending) {
+    size_t n = array_length(array);
+
+    if (nth >= n || !type_matches(array, type)) {
+        return array;
+    }
+
+    array = array_unshare(array);
+
+    if (!array) {
+        return NULL;
+    }
+
+    switch (type) {
+        case ARRAY_INT32:
+            i32_nth((int32_t *)array, n, nth, descending);
+            break;
+        case ARRAY_FLOAT:
+            f32_nth((float *)array, n, nth, descending);
+            break;
+        case ARRAY_DOUBLE:
+            f64_nth((double *)array, n, nth, descending);
+            break;
+    }
+
+    return array;
+}
+
+
+//----------
+void *array_partial_sort_scalar(void *array, size_t k, enum array_scalar type, int descending) {
+    size_t n = array_length(array);
+
+    if (k > n) {
+        k = n;
+    }
+
+    if (k == 0 || !type_matches(array, type)) {
+        return array;
+    }
+
+    array = array_nth_element_scalar(array, k - 1, type, descending);
+
+    if (!array) {
+        return NULL;
+    }
+
+    // The item at k - 1 is already in place
+    switch (type) {
+        case ARRAY_INT32:
+            i32_heap_sort((int32_t *)array, k - 1, descending);
+            break;
+        case ARRAY_FLOAT:
+            f32_heap_sort((float *)array, k - 1, descending);
+            break;
+        case ARRAY_DOUBLE:
+            f64_heap_sort((double *)array, k - 1, descending);
+            break;
+    }
+
+    return array;
+}
+
+
+//----------
+void *array_top_k_scalar(void *array, size_t k, enum array_scalar type, int descending, void *out) {
+    size_t n = array_length(array);
+
+    if (!type_matches(array, type)) {
+        return NULL;
+    }
+
+    if (k > n) {
+        k = n;
+    }
+
+    out = output_prepare(out, array_item_size(array), k);
+
+    if (!out || k == 0) {
+        return out;
+    }
+
+    switch (type) {
+        case ARRAY_INT32:
+            i32_top_k((const int32_t *)array, n, k, (int32_t *)out, descending);
+            break;
+        case ARRAY_FLOAT:
+            f32_top_k((const float *)array, n, k, (float *)out, descending);
+            break;
+        case ARRAY_DOUBLE:
+            f64_top_k((const double *)array, n, k, (double *)out, descending);
+            break;
+    }
+
+    return out;
+}
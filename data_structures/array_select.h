@@ -0,0 +1,138 @@
+/**
+ * @file array_select.h
+ * @brief Selection algorithms for arrays that avoid a full sort
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * "First" refers to the order defined by the comparitor, as for
+ * `array_sort`. To select the largest items, pass a descending comparitor.
+ * The `_scalar` variants work on arrays of `int32_t`, `float` or `double`
+ * and compare items directly instead of calling a comparitor.
+ *
+ */
+
+#ifndef ARRAY_SELECT_H
+#define ARRAY_SELECT_H
+
+#include "array.h"
+#include "array_kernels.h"
+
+#include <stddef.h>
+
+// +---------------------------------------------------------------------------+
+// |                           Public Interface                                |
+// +---------------------------------------------------------------------------+
+
+/**
+ * @brief Partially sorts an array so the item at `nth` is the one that would
+ * be there if the array were sorted
+ * @note Items before `nth` are not after it, and items after `nth` are not
+ * before it. Runs in O(n) on average and O(n log n) in the worst case.
+ *
+ * @param array
+ * @param nth The index to place
+ * @param compare A comparitor function, as for `array_sort`
+ * @return void* Pointer to the start of the array. If `nth` is out of range
+ * the array is unchanged. NULL if memory could not be allocated, in which
+ * case the array is unchanged and still owned by the caller.
+ */
+void *array_nth_element(
+    void *array,
+    size_t nth,
+    int (*compare)(const void *a, const void *b)
+);
+
+/**
+ * @brief Sorts the first `k` items of the array, leaving the rest in an
+ * unspecified order
+ * @note If `k` is larger than the length, the whole array is sorted
+ *
+ * @param array
+ * @param k The number of items to sort
+ * @param compare A comparitor function, as for `array_sort`
+ * @return void* Pointer to the start of the array, or NULL if memory could
+ * not be allocated, in which case the array is unchanged and still owned by
+ * the caller
+ */
+void *array_partial_sort(
+    void *array,
+    size_t k,
+    int (*compare)(const void *a, const void *b)
+);
+
+/**
+ * @brief Stores the first `k` items of an array, in sorted order, without
+ * modifying the array
+ * @note Uses a bounded heap of `k` items, so only O(k) extra memory is used
+ *
+ * @param array
+ * @param k The number of items to select
+ * @param compare A comparitor function, as for `array_sort`
+ * @param out Array to store the result in, or NULL to allocate one
+ * @return void* Pointer to the output array, or NULL if the item sizes do
+ * not match or memory could not be allocated. On failure a given `out` is
+ * not freed and is still owned by the caller.
+ */
+void *array_top_k(
+    void *array,
+    size_t k,
+    int (*compare)(const void *a, const void *b),
+    void *out
+);
+
+/**
+ * @brief `array_nth_element` for arrays of primitives
+ *
+ * @param array
+ * @param nth
+ * @param type The element type of the array
+ * @param descending 1 to order the largest items first
+ * @return void* Pointer to the start of the array. If `nth` is out of range
+ * or the type does not match, the array is unchanged.
+ */
+void *array_nth_element_scalar(
+    void *array,
+    size_t nth,
+    enum array_scalar type,
+    int descending
+);
+
+/**
+ * @brief `array_partial_sort` for arrays of primitives
+ *
+ * @param array
+ * @param k
+ * @param type The element type of the array
+ * @param descending 1 to order the largest items first
+ * @return void* Pointer to the start of the array. If the type does not
+ * match, the array is unchanged.
+ */
+void *array_partial_sort_scalar(
+    void *array,
+    size_t k,
+    enum array_scalar type,
+    int descending
+);
+
+/**
+ * @brief `array_top_k` for arrays of primitives
+ *
+ * @param array
+ * @param k
+ * @param type The element type of the array
+ * @param descending 1 to select the largest items
+ * @param out Array to store the result in, or NULL to allocate one
+ * @return void* Pointer to the output array, or NULL if the type does not
+ * match or memory could not be allocated. On failure a given `out` is not
+ * freed and is still owned by the caller.
+ */
+void *array_top_k_scalar(
+    void *array,
+    size_t k,
+    enum array_scalar type,
+    int descending,
+    void *out
+);
+
+
+#endif // ARRAY_SELECT_H
@@ -0,0 +1,582 @@
+#include "array_set.h"
+#include "array_kernels.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define ARRAY_SET_X86
+#include <immintrin.h>
+
+#define TARGET_SSE42 __attribute__((target("sse4.2")))
+#endif
+
+// Galloping search is used when one input is this many times larger
+#define GALLOP_RATIO 32
+
+typedef int (*compare_fn)(const void *a, const void *b);
+
+
+// +---------------------------------------------------------------------------+
+// |                           Static Functions                                |
+// +---------------------------------------------------------------------------+
+
+/**
+ * @brief Branchless lower or upper bound over raw items
+ *
+ * @param data
+ * @param n Number of items
+ * @param size Size of an item in bytes
+ * @param key
+ * @param compare
+ * @param upper 1 for the upper bound, 0 for the lower bound
+ * @return size_t
+ */
+static size_t bound(
+    const char *data,
+    size_t n,
+    size_t size,
+    const void *key,
+    compare_fn compare,
+    int upper
+) {
+    if (n == 0) {
+        return 0;
+    }
+
+    const char *base = data;
+
+    // Halve the range each step, moving the base with a conditional move
+    // rather than a branch
+    while (n > 1) {
+        size_t half = n / 2;
+        int c = compare(base + half * size, key);
+        base = (upper ? c <= 0 : c < 0) ? base + half * size : base;
+        n -= half;
+    }
+
+    int c = compare(base, key);
+    size_t index = (base - data) / size;
+
+    return index + (upper ? c <= 0 : c < 0);
+}
+
+/**
+ * @brief Finds the lower bound of a key near the start of a range by
+ * exponential search
+ *
+ * @param data
+ * @param n Number of items
+ * @param size Size of an item in bytes
+ * @param key
+ * @param compare
+ * @return size_t
+ */
+static size_t gallop(const char *data, size_t n, size_t size, const void *key, compare_fn compare) {
+    size_t hi = 1;
+
+    while (hi < n && compare(data + (hi - 1) * size, key) < 0) {
+        hi *= 2;
+    }
+
+    size_t lo = hi / 2;
+    hi = hi < n ? hi : n;
+
+    return lo + bound(data + lo * size, hi - lo, size, key, compare, 0);
+}
+
+static size_t bound_u32(const uint32_t *data, size_t n, uint32_t key, int upper) {
+    if (n == 0) {
+        return 0;
+    }
+
+    const uint32_t *base = data;
+
+    while (n > 1) {
+        size_t half = n / 2;
+        base = (upper ? base[half] <= key : base[half] < key) ? base + half : base;
+        n -= half;
+    }
+
+    return (base - data) + (upper ? *base <= key : *base < key);
+}
+
+static size_t gallop_u32(const uint32_t *data, size_t n, uint32_t key) {
+    size_t hi = 1;
+
+    while (hi < n && data[hi - 1] < key) {
+        hi *= 2;
+    }
+
+    size_t lo = hi / 2;
+    hi = hi < n ? hi : n;
+
+    return lo + bound_u32(data + lo, hi - lo, key, 0);
+}
+
+/**
+ * @brief Clears or allocates an output array with room for `capacity` items
+ *
+ * @param out
+ * @param item_size
+ * @param capacity
+ * @return void* The output array with its length set to `capacity`, or NULL
+ * on failure
+ */
+static void *output_prepare(void *out, size_t item_size, size_t capacity) {
+    if (!out) {
+        out = array_init(item_size, 0);
+    } else if (array_item_size(out) != item_size) {
+        return NULL;
+    }
+
+    if (!out) {
+        return NULL;
+    }
+
+    return array_set_length(out, capacity);
+}
+
+static int skewed(size_t n_small, size_t n_large) {
+    return n_small * GALLOP_RATIO < n_large;
+}
+
+
+// -------------------- Generic set operations
+
+static size_t intersect_gallop(
+    const char *small, size_t n_small,
+    const char *large, size_t n_large,
+    size_t size, compare_fn compare, char *out
+) {
+    size_t k = 0;
+    size_t j = 0;
+
+    for (size_t i = 0; i < n_small && j < n_large; i++) {
+        const char *key = small + i * size;
+        j += gallop(large + j * size, n_large - j, size, key, compare);
+
+        if (j < n_large && compare(large + j * size, key) == 0) {
+            memcpy(out + k++ * size, key, size);
+            j++;
+        }
+    }
+
+    return k;
+}
+
+static size_t intersect_merge(
+    const char *a, size_t na,
+    const char *b, size_t nb,
+    size_t size, compare_fn compare, char *out
+) {
+    size_t i = 0, j = 0, k = 0;
+
+    while (i < na && j < nb) {
+        int c = compare(a + i * size, b + j * size);
+
+        if (c == 0) {
+            memcpy(out + k++ * size, a + i * size, size);
+        }
+
+        i += c <= 0;
+        j += c >= 0;
+    }
+
+    return k;
+}
+
+
+// -------------------- uint32_t set operations
+
+static size_t intersect_gallop_u32(
+    const uint32_t *small, size_t n_small,
+    const uint32_t *large, size_t n_large,
+    uint32_t *out
+) {
+    size_t k = 0;
+    size_t j = 0;
+
+    for (size_t i = 0; i < n_small && j < n_large; i++) {
+        j += gallop_u32(large + j, n_large - j, small[i]);
+
+        if (j < n_large && large[j] == small[i]) {
+            out[k++] = small[i];
+            j++;
+        }
+    }
+
+    return k;
+}
+
+static size_t intersect_merge_u32(
+    const uint32_t *a, size_t na,
+    const uint32_t *b, size_t nb,
+    uint32_t *out
+) {
+    size_t i = 0, j = 0, k = 0;
+
+    while (i < na && j < nb) {
+        uint32_t x = a[i], y = b[j];
+
+        // Write unconditionally and only keep the item on a match
+        out[k] = x;
+        k += x == y;
+        i += x <= y;
+        j += x >= y;
+    }
+
+    return k;
+}
+
+#ifdef ARRAY_SET_X86
+
+/**
+ * @brief Intersects blocks of 4 items by comparing each block of `a` with
+ * every rotation of the current block of `b`
+ * @note Requires strictly increasing inputs
+ *
+ */
+TARGET_SSE42
+static size_t intersect_sse42_u32(
+    const uint32_t *a, size_t na,
+    const uint32_t *b, size_t nb,
+    uint32_t *out
+) {
+    size_t i = 0, j = 0, k = 0;
+
+    while (i + 4 <= na && j + 4 <= nb) {
+        __m128i va = _mm_loadu_si128((const __m128i *)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i *)(b + j));
+
+        __m128i eq = _mm_cmpeq_epi32(va, vb);
+        vb = _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1));
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, vb));
+        vb = _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1));
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, vb));
+        vb = _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1));
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, vb));
+
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+
+        while (mask) {
+            out[k++] = a[i + __builtin_ctz(mask)];
+            mask &= mask - 1;
+        }
+
+        // Advance whichever block ends first, or both
+        uint32_t a_max = a[i + 3], b_max = b[j + 3];
+        i += (a_max <= b_max) * 4;
+        j += (b_max <= a_max) * 4;
+    }
+
+    return k + intersect_merge_u32(a + i, na - i, b + j, nb - j, out + k);
+}
+
+#endif // ARRAY_SET_X86
+
+
+// +---------------------------------------------------------------------------+
+// |                           Public Functions                                |
+// +---------------------------------------------------------------------------+
+
+
+//----------
+size_t array_lower_bound(void *array, const void *key, compare_fn compare) {
+    return bound((const char *)array, array_length(array), array_item_size(array), key, compare, 0);
+}
+
+
+//----------
+size_t array_upper_bound(void *array, const void *key, compare_fn compare) {
+    return bound((const char *)array, array_length(array), array_item_size(array), key, compare, 1);
+}
+
+
+//----------
+void *array_intersect(void *a, void *b, void *out, compare_fn compare) {
+    size_t size = array_item_size(a);
+    size_t na = array_length(a);
+    size_t nb = array_length(b);
+
+    if (array_item_size(b) != size) {
+        return NULL;
+    }
+
+    out = output_prepare(out, size, na < nb ? na : nb);
+
+    if (!out) {
+        return NULL;
+    }
+
+    size_t k;
+
+    if (skewed(na, nb)) {
+        k = intersect_gallop((const char *)a, na, (const char *)b, nb, size, compare, (char *)out);
+    } else if (skewed(nb, na)) {
+        k = intersect_gallop((const char *)b, nb, (const char *)a, na, size, compare, (char *)out);
+    } else {
+        k = intersect_merge((const char *)a, na, (const char *)b, nb, size, compare, (char *)out);
+    }
+
+    return array_set_length(out, k);
+}
+
+
+//----------
+void *array_union(void *a, void *b, void *out, compare_fn compare) {
+    size_t size = array_item_size(a);
+    size_t na = array_length(a);
+    size_t nb = array_length(b);
+
+    if (array_item_size(b) != size) {
+        return NULL;
+    }
+
+    out = output_prepare(out, size, na + nb);
+
+    if (!out) {
+        return NULL;
+    }
+
+    const char *pa = (const char *)a;
+    const char *pb = (const char *)b;
+    char *dest = (char *)out;
+    size_t i = 0, j = 0, k = 0;
+
+    if (skewed(nb, na)) {
+        // Copy the runs of `a` between each item of `b` in bulk
+        for (; j < nb; j++) {
+            size_t run = gallop(pa + i * size, na - i, size, pb + j * size, compare);
+            memcpy(dest + k * size, pa + i * size, run * size);
+            i += run;
+            k += run;
+
+            memcpy(dest + k++ * size, pb + j * size, size);
+            i += i < na && compare(pa + i * size, pb + j * size) == 0;
+        }
+    } else {
+        while (i < na && j < nb) {
+            int c = compare(pa + i * size, pb + j * size);
+
+            memcpy(dest + k++ * size, c <= 0 ? pa + i * size : pb + j * size, size);
+            i += c <= 0;
+            j += c >= 0;
+        }
+    }
+
+    // At most one input has items left
+    memcpy(dest + k * size, pa + i * size, (na - i) * size);
+    k += na - i;
+    memcpy(dest + k * size, pb + j * size, (nb - j) * size);
+    k += nb - j;
+
+    return array_set_length(out, k);
+}
+
+
+//----------
+void *array_difference(void *a, void *b, void *out, compare_fn compare) {
+    size_t size = array_item_size(a);
+    size_t na = array_length(a);
+    size_t nb = array_length(b);
+
+    if (array_item_size(b) != size) {
+        return NULL;
+    }
+
+    out = output_prepare(out, size, na);
+
+    if (!out) {
+        return NULL;
+    }
+
+    const char *pa = (const char *)a;
+    const char *pb = (const char *)b;
+    char *dest = (char *)out;
+    size_t i = 0, j = 0, k = 0;
+
+    if (skewed(na, nb)) {
+        for (; i < na; i++) {
+            j += gallop(pb + j * size, nb - j, size, pa + i * size, compare);
+
+            if (j < nb && compare(pb + j * size, pa + i * size) == 0) {
+                j++;
+            } else {
+                memcpy(dest + k++ * size, pa + i * size, size);
+            }
+        }
+    } else {
+        while (i < na && j < nb) {
+            int c = compare(pa + i * size, pb + j * size);
+
+            if (c < 0) {
+                memcpy(dest + k++ * size, pa + i * size, size);
+            }
+
+            i += c <= 0;
+            j += c >= 0;
+        }
+
+        memcpy(dest + k * size, pa + i * size, (na - i) * size);
+        k += na - i;
+    }
+
+    return array_set_length(out, k);
+}
+
+
+//----------
+size_t array_lower_bound_u32(void *array, uint32_t key) {
+    return bound_u32((const uint32_t *)array, array_length(array), key, 0);
+}
+
+
+//----------
+size_t array_upper_bound_u32(void *array, uint32_t key) {
+    return bound_u32((const uint32_t *)array, array_length(array), key, 1);
+}
+
+
+//----------
+void *array_intersect_u32(void *a, void *b, void *out) {
+    size_t na = array_length(a);
+    size_t nb = array_length(b);
+
+    if (array_item_size(a) != sizeof(uint32_t) || array_item_size(b) != sizeof(uint32_t)) {
+        return NULL;
+    }
+
+    out = output_prepare(out, sizeof(uint32_t), na < nb ? na : nb);
+
+    if (!out) {
+        return NULL;
+    }
+
+    const uint32_t *pa = (const uint32_t *)a;
+    const uint32_t *pb = (const uint32_t *)b;
+    uint32_t *dest = (uint32_t *)out;
+    size_t k;
+
+    if (skewed(na, nb)) {
+        k = intersect_gallop_u32(pa, na, pb, nb, dest);
+    } else if (skewed(nb, na)) {
+        k = intersect_gallop_u32(pb, nb, pa, na, dest);
+    }
+#ifdef ARRAY_SET_X86
+    else if (array_simd_level() >= ARRAY_SIMD_SSE42) {
+        k = intersect_sse42_u32(pa, na, pb, nb, dest);
+    }
+#endif
+    else {
+        k = intersect_merge_u32(pa, na, pb, nb, dest);
+    }
+
+    return array_set_length(out, k);
+}
+
+
+//----------
+void *array_union_u32(void *a, void *b, void *out) {
+    size_t na = array_length(a);
+    size_t nb = array_length(b);
+
+    if (array_item_size(a) != sizeof(uint32_t) || array_item_size(b) != sizeof(uint32_t)) {
+        return NULL;
+    }
+
+    out = output_prepare(out, sizeof(uint32_t), na + nb);
+
+    if (!out) {
+        return NULL;
+    }
+
+    const uint32_t *pa = (const uint32_t *)a;
+    const uint32_t *pb = (const uint32_t *)b;
+    uint32_t *dest = (uint32_t *)out;
+    size_t i = 0, j = 0, k = 0;
+
+    if (skewed(na, nb) || skewed(nb, na)) {
+        // Copy the runs of the larger input between each item of the smaller
+        const uint32_t *small = na < nb ? pa : pb;
+        const uint32_t *large = na < nb ? pb : pa;
+        size_t n_small = na < nb ? na : nb;
+        size_t n_large = na < nb ? nb : na;
+
+        for (; i < n_small; i++) {
+            size_t run = gallop_u32(large + j, n_large - j, small[i]);
+            memcpy(dest + k, large + j, run * sizeof(uint32_t));
+            j += run;
+            k += run;
+
+            dest[k++] = small[i];
+            j += j < n_large && large[j] == small[i];
+        }
+
+        memcpy(dest + k, large + j, (n_large - j) * sizeof(uint32_t));
+        k += n_large - j;
+
+        return array_set_length(out, k);
+    }
+
+    while (i < na && j < nb) {
+        uint32_t x = pa[i], y = pb[j];
+
+        dest[k++] = x <= y ? x : y;
+        i += x <= y;
+        j += x >= y;
+    }
+
+    memcpy(dest + k, pa + i, (na - i) * sizeof(uint32_t));
+    k += na - i;
+    memcpy(dest + k, pb + j, (nb - j) * sizeof(uint32_t));
+    k += nb - j;
+
+    return array_set_length(out, k);
+}
+
+
+//----------
+void *array_difference_u32(void *a, void *b, void *out) {
+    size_t na = array_length(a);
+    size_t nb = array_length(b);
+
+    if (array_item_size(a) != sizeof(uint32_t) || array_item_size(b) != sizeof(uint32_t)) {
+        return NULL;
+    }
+
+    out = output_prepare(out, sizeof(uint32_t), na);
+
+    if (!out) {
+        return NULL;
+    }
+
+    const uint32_t *pa = (const uint32_t *)a;
+    const uint32_t *pb = (const uint32_t *)b;
+    uint32_t *dest = (uint32_t *)out;
+    size_t i = 0, j = 0, k = 0;
+
+    if (skewed(na, nb)) {
+        for (; i < na; i++) {
+            j += gallop_u32(pb + j, nb - j, pa[i]);
+            int found = j < nb && pb[j] == pa[i];
+
+            dest[k] = pa[i];
+            k += !found;
+            j += found;
+        }
+
+        return array_set_length(out, k);
+    }
+
+    while (i < na && j < nb) {
+        uint32_t x = pa[i], y = pb[j];
+
+        dest[k] = x;
+        k += x < y;
+        i += x <= y;
+        j += x >= y;
+    }
+
+    memcpy(dest + k, pa + i, (na - i) * sizeof(uint32_t));
+    k += na - i;
+
+    return array_set_length(out, k);
+}
@@ -0,0 +1,163 @@
+/**
+ * @file array_set.h
+ * @brief Searching and set operations on sorted arrays
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * Set operations pick a strategy from the input sizes. When one input is
+ * much smaller than the other, each of its items is located in the larger
+ * input by galloping (exponential then binary) search. Otherwise the inputs
+ * are merged, and `uint32_t` intersections use SIMD block comparisons.
+ *
+ * The output goes into `out`, which is cleared first. If `out` is NULL a
+ * new array is allocated.
+ *
+ */
+
+#ifndef ARRAY_SET_H
+#define ARRAY_SET_H
+
+#include "array.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+// +---------------------------------------------------------------------------+
+// |                           Public Interface                                |
+// +---------------------------------------------------------------------------+
+
+/**
+ * @brief Finds the first item not less than a key, with a branchless binary
+ * search
+ *
+ * @param array A sorted array
+ * @param key Pointer to the key
+ * @param compare A comparitor function, as for `array_sort`
+ * @return size_t The index of the item, or `array_length(array)` if every
+ * item is less than the key
+ */
+size_t array_lower_bound(
+    void *array,
+    const void *key,
+    int (*compare)(const void *a, const void *b)
+);
+
+/**
+ * @brief Finds the first item greater than a key, with a branchless binary
+ * search
+ *
+ * @param array A sorted array
+ * @param key Pointer to the key
+ * @param compare A comparitor function, as for `array_sort`
+ * @return size_t The index of the item, or `array_length(array)` if no item
+ * is greater than the key
+ */
+size_t array_upper_bound(
+    void *array,
+    const void *key,
+    int (*compare)(const void *a, const void *b)
+);
+
+/**
+ * @brief Stores the items present in both sorted arrays
+ * @note Repeated items appear as many times as in the input with fewer
+ * copies
+ *
+ * @param a A sorted array
+ * @param b A sorted array with the same item size
+ * @param out Array to store the result in, or NULL to allocate one
+ * @param compare A comparitor function, as for `array_sort`
+ * @return void* Pointer to the output array, or NULL if the item sizes do
+ * not match or memory could not be allocated
+ */
+void *array_intersect(
+    void *a,
+    void *b,
+    void *out,
+    int (*compare)(const void *a, const void *b)
+);
+
+/**
+ * @brief Stores the items present in either sorted array, in sorted order
+ *
+ * @param a A sorted array
+ * @param b A sorted array with the same item size
+ * @param out Array to store the result in, or NULL to allocate one
+ * @param compare A comparitor function, as for `array_sort`
+ * @return void* Pointer to the output array, or NULL if the item sizes do
+ * not match or memory could not be allocated
+ */
+void *array_union(
+    void *a,
+    void *b,
+    void *out,
+    int (*compare)(const void *a, const void *b)
+);
+
+/**
+ * @brief Stores the items of `a` that are not in `b`, in sorted order
+ *
+ * @param a A sorted array
+ * @param b A sorted array with the same item size
+ * @param out Array to store the result in, or NULL to allocate one
+ * @param compare A comparitor function, as for `array_sort`
+ * @return void* Pointer to the output array, or NULL if the item sizes do
+ * not match or memory could not be allocated
+ */
+void *array_difference(
+    void *a,
+    void *b,
+    void *out,
+    int (*compare)(const void *a, const void *b)
+);
+
+/**
+ * @brief `array_lower_bound` for arrays of `uint32_t`, without a comparitor
+ *
+ * @param array A sorted array of `uint32_t`
+ * @param key
+ * @return size_t
+ */
+size_t array_lower_bound_u32(void *array, uint32_t key);
+
+/**
+ * @brief `array_upper_bound` for arrays of `uint32_t`, without a comparitor
+ *
+ * @param array A sorted array of `uint32_t`
+ * @param key
+ * @return size_t
+ */
+size_t array_upper_bound_u32(void *array, uint32_t key);
+
+/**
+ * @brief `array_intersect` for arrays of strictly increasing `uint32_t`
+ *
+ * @param a
+ * @param b
+ * @param out Array of `uint32_t` to store the result in, or NULL
+ * @return void* Pointer to the output array, or NULL on failure
+ */
+void *array_intersect_u32(void *a, void *b, void *out);
+
+/**
+ * @brief `array_union` for arrays of strictly increasing `uint32_t`
+ *
+ * @param a
+ * @param b
+ * @param out Array of `uint32_t` to store the result in, or NULL
+ * @return void* Pointer to the output array, or NULL on failure
+ */
+void *array_union_u32(void *a, void *b, void *out);
+
+/**
+ * @brief `array_difference` for arrays of strictly increasing `uint32_t`
+ *
+ * @param a
+ * @param b
+ * @param out Array of `uint32_t` to store the result in, or NULL
+ * @return void* Pointer to the output array, or NULL on failure
+ */
+void *array_difference_u32(void *a, void *b, void *out);
+
+
+#endif // ARRAY_SET_H
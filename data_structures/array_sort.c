@@ -0,0 +1,809 @@
+#include "array_sort.h"
+
+// Arrays shorter than this are sorted with binary insertion sort alone
+#define MIN_MERGE 32
+
+// Initial number of consecutive wins before a merge starts galloping
+#define MIN_GALLOP 7
+
+// Enough pending runs for any array that fits in memory
+#define MAX_PENDING 85
+
+typedef int (*compare_fn)(const void *a, const void *b);
+
+/**
+ * @brief A sorted run waiting to be merged
+ *
+ */
+struct run {
+    size_t base;
+    size_t length;
+};
+
+/**
+ * @brief State of a single sort
+ *
+ * @param base The items being sorted
+ * @param size Size of an item in bytes
+ * @param compare
+ * @param buffer An `array` of bytes reused by every merge, or NULL until
+ * the first merge
+ * @param pivot Scratch space for one item
+ * @param min_gallop Current threshold for entering galloping mode
+ * @param runs Stack of pending runs
+ * @param n_runs
+ */
+struct timsort {
+    char *base;
+    size_t size;
+    compare_fn compare;
+    char *buffer;
+    char *pivot;
+    ptrdiff_t min_gallop;
+    struct run runs[MAX_PENDING];
+    size_t n_runs;
+};
+
+
+// +---------------------------------------------------------------------------+
+// |                           Static Functions                                |
+// +---------------------------------------------------------------------------+
+
+static char *item(struct timsort *ts, const char *base, ptrdiff_t i) {
+    return (char *) base + i * (ptrdiff_t) ts->size;
+}
+
+static void copy_items(struct timsort *ts, char *dest, const char *src, size_t n) {
+    memmove(dest, src, n * ts->size);
+}
+
+/**
+ * @brief Ensures the merge buffer can hold `n` items
+ *
+ * @param ts
+ * @param n
+ * @return char* The buffer, or NULL if memory could not be allocated
+ */
+static char *buffer_reserve(struct timsort *ts, size_t n) {
+    if (!ts->buffer) {
+        ts->buffer = (char *) array_init(1, 0);
+
+        if (!ts->buffer) {
+            return NULL;
+        }
+    }
+
+    size_t bytes = n * ts->size;
+
+    if (bytes > array_capacity(ts->buffer)) {
+        // Grow geometrically so a few large merges do not each reallocate
+        size_t grown = array_capacity(ts->buffer) * 2;
+        char *buffer = (char *) array_resize(ts->buffer, grown > bytes ? grown : bytes);
+
+        if (!buffer) {
+            return NULL;
+        }
+
+        ts->buffer = buffer;
+    }
+
+    return ts->buffer;
+}
+
+/**
+ * @brief Returns the minimum run length for an array of n items, chosen so
+ * that n / min_run is a power of two or slightly less
+ *
+ * @param n
+ * @return size_t A value in [MIN_MERGE / 2, MIN_MERGE]
+ */
+static size_t min_run_length(size_t n) {
+    size_t r = 0;
+
+    while (n >= MIN_MERGE) {
+        r |= n & 1;
+        n >>= 1;
+    }
+
+    return n + r;
+}
+
+static void reverse(struct timsort *ts, size_t lo, size_t hi) {
+    while (lo + 1 < hi) {
+        hi--;
+        memcpy(ts->pivot, item(ts, ts->base, lo), ts->size);
+        memcpy(item(ts, ts->base, lo), item(ts, ts->base, hi), ts->size);
+        memcpy(item(ts, ts->base, hi), ts->pivot, ts->size);
+        lo++;
+    }
+}
+
+/**
+ * @brief Finds the length of the run starting at `lo`, reversing it if it
+ * is strictly descending
+ * @note Only strictly descending runs are reversed, which keeps the sort
+ * stable
+ *
+ * @param ts
+ * @param lo
+ * @param hi
+ * @return size_t
+ */
+static size_t count_run(struct timsort *ts, size_t lo, size_t hi) {
+    size_t run_hi = lo + 1;
+
+    if (run_hi == hi) {
+        return 1;
+    }
+
+    if (ts->compare(item(ts, ts->base, run_hi), item(ts, ts->base, lo)) < 0) {
+        run_hi++;
+
+        while (run_hi < hi
+            && ts->compare(item(ts, ts->base, run_hi), item(ts, ts->base, run_hi - 1)) < 0) {
+            run_hi++;
+        }
+
+        reverse(ts, lo, run_hi);
+    } else {
+        run_hi++;
+
+        while (run_hi < hi
+            && ts->compare(item(ts, ts->base, run_hi), item(ts, ts->base, run_hi - 1)) >= 0) {
+            run_hi++;
+        }
+    }
+
+    return run_hi - lo;
+}
+
+/**
+ * @brief Sorts [lo, hi) with binary insertion sort, given that [lo, start)
+ * is already sorted
+ *
+ * @param ts
+ * @param lo
+ * @param hi
+ * @param start
+ */
+static void binary_sort(struct timsort *ts, size_t lo, size_t hi, size_t start) {
+    for (; start < hi; start++) {
+        memcpy(ts->pivot, item(ts, ts->base, start), ts->size);
+
+        size_t left = lo, right = start;
+
+        // Place the pivot after any equal items
+        while (left < right) {
+            size_t mid = left + (right - left) / 2;
+
+            if (ts->compare(ts->pivot, item(ts, ts->base, mid)) < 0) {
+                right = mid;
+            } else {
+                left = mid + 1;
+            }
+        }
+
+        copy_items(ts, item(ts, ts->base, left + 1), item(ts, ts->base, left), start - left);
+        memcpy(item(ts, ts->base, left), ts->pivot, ts->size);
+    }
+}
+
+/**
+ * @brief Finds where to insert `key` into the sorted range `a[0, n)`,
+ * before any equal items
+ * @note Searches outwards from `hint` in exponentially growing steps, then
+ * finishes with a binary search
+ *
+ * @param ts
+ * @param key
+ * @param a
+ * @param n
+ * @param hint The index to start from, in [0, n)
+ * @return ptrdiff_t k such that a[k - 1] < key <= a[k]
+ */
+static ptrdiff_t gallop_left(
+    struct timsort *ts,
+    const char *key,
+    const char *a,
+    ptrdiff_t n,
+    ptrdiff_t hint
+) {
+    ptrdiff_t last_ofs = 0, ofs = 1;
+
+    if (ts->compare(key, item(ts, a, hint)) > 0) {
+        // Gallop right until a[hint + last_ofs] < key <= a[hint + ofs]
+        ptrdiff_t max_ofs = n - hint;
+
+        while (ofs < max_ofs && ts->compare(key, item(ts, a, hint + ofs)) > 0) {
+            last_ofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+
+        if (ofs > max_ofs) {
+            ofs = max_ofs;
+        }
+
+        last_ofs += hint;
+        ofs += hint;
+    } else {
+        // Gallop left until a[hint - ofs] < key <= a[hint - last_ofs]
+        ptrdiff_t max_ofs = hint + 1;
+
+        while (ofs < max_ofs && ts->compare(key, item(ts, a, hint - ofs)) <= 0) {
+            last_ofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+
+        if (ofs > max_ofs) {
+            ofs = max_ofs;
+        }
+
+        ptrdiff_t tmp = last_ofs;
+        last_ofs = hint - ofs;
+        ofs = hint - tmp;
+    }
+
+    // Now a[last_ofs] < key <= a[ofs]
+    last_ofs++;
+
+    while (last_ofs < ofs) {
+        ptrdiff_t mid = last_ofs + ((ofs - last_ofs) >> 1);
+
+        if (ts->compare(key, item(ts, a, mid)) > 0) {
+            last_ofs = mid + 1;
+        } else {
+            ofs = mid;
+        }
+    }
+
+    return ofs;
+}
+
+/**
+ * @brief Like `gallop_left`, but finds the position after any equal items
+ *
+ * @param ts
+ * @param key
+ * @param a
+ * @param n
+ * @param hint
+ * @return ptrdiff_t k such that a[k - 1] <= key < a[k]
+ */
+static ptrdiff_t gallop_right(
+    struct timsort *ts,
+    const char *key,
+    const char *a,
+    ptrdiff_t n,
+    ptrdiff_t hint
+) {
+    ptrdiff_t last_ofs = 0, ofs = 1;
+
+    if (ts->compare(key, item(ts, a, hint)) < 0) {
+        // Gallop left until a[hint - ofs] <= key < a[hint - last_ofs]
+        ptrdiff_t max_ofs = hint + 1;
+
+        while (ofs < max_ofs && ts->compare(key, item(ts, a, hint - ofs)) < 0) {
+            last_ofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+
+        if (ofs > max_ofs) {
+            ofs = max_ofs;
+        }
+
+        ptrdiff_t tmp = last_ofs;
+        last_ofs = hint - ofs;
+        ofs = hint - tmp;
+    } else {
+        // Gallop right until a[hint + last_ofs] <= key < a[hint + ofs]
+        ptrdiff_t max_ofs = n - hint;
+
+        while (ofs < max_ofs && ts->compare(key, item(ts, a, hint + ofs)) >= 0) {
+            last_ofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+
+        if (ofs > max_ofs) {
+            ofs = max_ofs;
+        }
+
+        last_ofs += hint;
+        ofs += hint;
+    }
+
+    // Now a[last_ofs] <= key < a[ofs]
+    last_ofs++;
+
+    while (last_ofs < ofs) {
+        ptrdiff_t mid = last_ofs + ((ofs - last_ofs) >> 1);
+
+        if (ts->compare(key, item(ts, a, mid)) < 0) {
+            ofs = mid;
+        } else {
+            last_ofs = mid + 1;
+        }
+    }
+
+    return ofs;
+}
+
+/**
+ * @brief Merges two adjacent runs where the first is the shorter, copying
+ * the first run into the buffer and merging from the left
+ * @note The first item of run 2 must be less than the first item of run 1,
+ * and the last item of run 1 greater than every item of run 2
+ *
+ * @param ts
+ * @param base1 Index of run 1
+ * @param len1
+ * @param base2 Index of run 2, directly after run 1
+ * @param len2
+ * @return int 0 if successful, 1 if the buffer could not be allocated
+ */
+static int merge_lo(
+    struct timsort *ts,
+    ptrdiff_t base1,
+    ptrdiff_t len1,
+    ptrdiff_t base2,
+    ptrdiff_t len2
+) {
+    char *a = ts->base;
+    char *tmp = buffer_reserve(ts, len1);
+
+    if (!tmp) {
+        return 1;
+    }
+
+    copy_items(ts, tmp, item(ts, a, base1), len1);
+
+    ptrdiff_t cursor1 = 0;          // Into tmp
+    ptrdiff_t cursor2 = base2;      // Into a
+    ptrdiff_t dest = base1;         // Into a
+    ptrdiff_t min_gallop = ts->min_gallop;
+
+    copy_items(ts, item(ts, a, dest++), item(ts, a, cursor2++), 1);
+
+    if (--len2 == 0) {
+        copy_items(ts, item(ts, a, dest), item(ts, tmp, cursor1), len1);
+        return 0;
+    }
+
+    if (len1 == 1) {
+        copy_items(ts, item(ts, a, dest), item(ts, a, cursor2), len2);
+        copy_items(ts, item(ts, a, dest + len2), item(ts, tmp, cursor1), 1);
+        return 0;
+    }
+
+    for (;;) {
+        ptrdiff_t count1 = 0;       // Number of times in a row run 1 won
+        ptrdiff_t count2 = 0;       // Number of times in a row run 2 won
+
+        // Merge one item at a time until one run starts winning consistently
+        do {
+            if (ts->compare(item(ts, a, cursor2), item(ts, tmp, cursor1)) < 0) {
+                copy_items(ts, item(ts, a, dest++), item(ts, a, cursor2++), 1);
+                count2++;
+                count1 = 0;
+
+                if (--len2 == 0) {
+                    goto done;
+                }
+            } else {
+                copy_items(ts, item(ts, a, dest++), item(ts, tmp, cursor1++), 1);
+                count1++;
+                count2 = 0;
+
+                if (--len1 == 1) {
+                    goto done;
+                }
+            }
+        } while ((count1 | count2) < min_gallop);
+
+        // Gallop, copying whole stretches of one run at a time, until
+        // neither run is winning by much
+        do {
+            count1 = gallop_right(ts, item(ts, a, cursor2), item(ts, tmp, cursor1), len1, 0);
+
+            if (count1 != 0) {
+                copy_items(ts, item(ts, a, dest), item(ts, tmp, cursor1), count1);
+                dest += count1;
+                cursor1 += count1;
+                len1 -= count1;
+
+                if (len1 <= 1) {
+                    goto done;
+                }
+            }
+
+            copy_items(ts, item(ts, a, dest++), item(ts, a, cursor2++), 1);
+
+            if (--len2 == 0) {
+                goto done;
+            }
+
+            count2 = gallop_left(ts, item(ts, tmp, cursor1), item(ts, a, cursor2), len2, 0);
+
+            if (count2 != 0) {
+                copy_items(ts, item(ts, a, dest), item(ts, a, cursor2), count2);
+                dest += count2;
+                cursor2 += count2;
+                len2 -= count2;
+
+                if (len2 == 0) {
+                    goto done;
+                }
+            }
+
+            copy_items(ts, item(ts, a, dest++), item(ts, tmp, cursor1++), 1);
+
+            if (--len1 == 1) {
+                goto done;
+            }
+
+            min_gallop--;
+        } while (count1 >= MIN_GALLOP || count2 >= MIN_GALLOP);
+
+        // Penalise leaving galloping mode
+        if (min_gallop < 0) {
+            min_gallop = 0;
+        }
+
+        min_gallop += 2;
+    }
+
+done:
+    ts->min_gallop = min_gallop < 1 ? 1 : min_gallop;
+
+    if (len1 == 1) {
+        copy_items(ts, item(ts, a, dest), item(ts, a, cursor2), len2);
+        copy_items(ts, item(ts, a, dest + len2), item(ts, tmp, cursor1), 1);
+    } else {
+        // len1 is only 0 here if the comparitor is inconsistent
+        copy_items(ts, item(ts, a, dest), item(ts, tmp, cursor1), len1);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Merges two adjacent runs where the second is the shorter, copying
+ * the second run into the buffer and merging from the right
+ * @note Has the same preconditions as `merge_lo`
+ *
+ * @param ts
+ * @param base1
+ * @param len1
+ * @param base2
+ * @param len2
+ * @return int 0 if successful, 1 if the buffer could not be allocated
+ */
+static int merge_hi(
+    struct timsort *ts,
+    ptrdiff_t base1,
+    ptrdiff_t len1,
+    ptrdiff_t base2,
+    ptrdiff_t len2
+) {
+    char *a = ts->base;
+    char *tmp = buffer_reserve(ts, len2);
+
+    if (!tmp) {
+        return 1;
+    }
+
+    copy_items(ts, tmp, item(ts, a, base2), len2);
+
+    ptrdiff_t cursor1 = base1 + len1 - 1;   // Into a
+    ptrdiff_t cursor2 = len2 - 1;           // Into tmp
+    ptrdiff_t dest = base2 + len2 - 1;      // Into a
+    ptrdiff_t min_gallop = ts->min_gallop;
+
+    copy_items(ts, item(ts, a, dest--), item(ts, a, cursor1--), 1);
+
+    if (--len1 == 0) {
+        copy_items(ts, item(ts, a, dest - (len2 - 1)), tmp, len2);
+        return 0;
+    }
+
+    if (len2 == 1) {
+        dest -= len1;
+        cursor1 -= len1;
+        copy_items(ts, item(ts, a, dest + 1), item(ts, a, cursor1 + 1), len1);
+        copy_items(ts, item(ts, a, dest), item(ts, tmp, cursor2), 1);
+        return 0;
+    }
+
+    for (;;) {
+        ptrdiff_t count1 = 0;
+        ptrdiff_t count2 = 0;
+
+        do {
+            if (ts->compare(item(ts, tmp, cursor2), item(ts, a, cursor1)) < 0) {
+                copy_items(ts, item(ts, a, dest--), item(ts, a, cursor1--), 1);
+                count1++;
+                count2 = 0;
+
+                if (--len1 == 0) {
+                    goto done;
+                }
+            } else {
+                copy_items(ts, item(ts, a, dest--), item(ts, tmp, cursor2--), 1);
+                count2++;
+                count1 = 0;
+
+                if (--len2 == 1) {
+                    goto done;
+                }
+            }
+        } while ((count1 | count2) < min_gallop);
+
+        do {
+            count1 = len1 - gallop_right(
+                ts, item(ts, tmp, cursor2), item(ts, a, base1), len1, len1 - 1
+            );
+
+            if (count1 != 0) {
+                dest -= count1;
+                cursor1 -= count1;
+                len1 -= count1;
+                copy_items(ts, item(ts, a, dest + 1), item(ts, a, cursor1 + 1), count1);
+
+                if (len1 == 0) {
+                    goto done;
+                }
+            }
+
+            copy_items(ts, item(ts, a, dest--), item(ts, tmp, cursor2--), 1);
+
+            if (--len2 == 1) {
+                goto done;
+            }
+
+            count2 = len2 - gallop_left(ts, item(ts, a, cursor1), tmp, len2, len2 - 1);
+
+            if (count2 != 0) {
+                dest -= count2;
+                cursor2 -= count2;
+                len2 -= count2;
+                copy_items(ts, item(ts, a, dest + 1), item(ts, tmp, cursor2 + 1), count2);
+
+                if (len2 <= 1) {
+                    goto done;
+                }
+            }
+
+            copy_items(ts, item(ts, a, dest--), item(ts, a, cursor1--), 1);
+
+            if (--len1 == 0) {
+                goto done;
+            }
+
+            min_gallop--;
+        } while (count1 >= MIN_GALLOP || count2 >= MIN_GALLOP);
+
+        if (min_gallop < 0) {
+            min_gallop = 0;
+        }
+
+        min_gallop += 2;
+    }
+
+done:
+    ts->min_gallop = min_gallop < 1 ? 1 : min_gallop;
+
+    if (len2 == 1) {
+        dest -= len1;
+        cursor1 -= len1;
+        copy_items(ts, item(ts, a, dest + 1), item(ts, a, cursor1 + 1), len1);
+        copy_items(ts, item(ts, a, dest), item(ts, tmp, cursor2), 1);
+    } else {
+        copy_items(ts, item(ts, a, dest - (len2 - 1)), tmp, len2);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Merges the pending runs i and i + 1
+ *
+ * @param ts
+ * @param i
+ * @return int 0 if successful, 1 if the buffer could not be allocated
+ */
+static int merge_at(struct timsort *ts, size_t i) {
+    ptrdiff_t base1 = ts->runs[i].base;
+    ptrdiff_t len1 = ts->runs[i].length;
+    ptrdiff_t base2 = ts->runs[i + 1].base;
+    ptrdiff_t len2 = ts->runs[i + 1].length;
+
+    ts->runs[i].length = len1 + len2;
+
+    if (i + 3 == ts->n_runs) {
+        ts->runs[i + 1] = ts->runs[i + 2];
+    }
+
+    ts->n_runs--;
+
+    // Items of run 1 before the first item of run 2 are already in place
+    ptrdiff_t k = gallop_right(ts, item(ts, ts->base, base2), item(ts, ts->base, base1), len1, 0);
+    base1 += k;
+    len1 -= k;
+
+    if (len1 == 0) {
+        return 0;
+    }
+
+    // As are items of run 2 after the last item of run 1
+    len2 = gallop_left(
+        ts, item(ts, ts->base, base1 + len1 - 1), item(ts, ts->base, base2), len2, len2 - 1
+    );
+
+    if (len2 == 0) {
+        return 0;
+    }
+
+    if (len1 <= len2) {
+        return merge_lo(ts, base1, len1, base2, len2);
+    }
+
+    return merge_hi(ts, base1, len1, base2, len2);
+}
+
+/**
+ * @brief Merges pending runs until their lengths satisfy the stack
+ * invariants, which keep merges balanced
+ * @note Checks the top four runs rather than three, which is needed for the
+ * invariants to hold for the whole stack
+ *
+ * @param ts
+ * @return int 0 if successful, 1 if the buffer could not be allocated
+ */
+static int merge_collapse(struct timsort *ts) {
+    struct run *r = ts->runs;
+
+    while (ts->n_runs > 1) {
+        size_t n = ts->n_runs - 2;
+
+        if ((n > 0 && r[n - 1].length <= r[n].length + r[n + 1].length)
+            || (n > 1 && r[n - 2].length <= r[n - 1].length + r[n].length)) {
+            if (r[n - 1].length < r[n + 1].length) {
+                n--;
+            }
+        } else if (r[n].length > r[n + 1].length) {
+            break;
+        }
+
+        if (merge_at(ts, n) != 0) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Merges all pending runs into one
+ *
+ * @param ts
+ * @return int 0 if successful, 1 if the buffer could not be allocated
+ */
+static int merge_force_collapse(struct timsort *ts) {
+    struct run *r = ts->runs;
+
+    while (ts->n_runs > 1) {
+        size_t n = ts->n_runs - 2;
+
+        if (n > 0 && r[n - 1].length < r[n + 1].length) {
+            n--;
+        }
+
+        if (merge_at(ts, n) != 0) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Sorts the items of a timsort state
+ *
+ * @param ts
+ * @param n Number of items
+ * @return int 0 if successful, 1 if the buffer could not be allocated
+ */
+static int timsort(struct timsort *ts, size_t n) {
+    if (n < MIN_MERGE) {
+        binary_sort(ts, 0, n, count_run(ts, 0, n));
+        return 0;
+    }
+
+    size_t min_run = min_run_length(n);
+    size_t lo = 0;
+
+    while (lo < n) {
+        size_t run_length = count_run(ts, lo, n);
+
+        // Extend short runs to min_run items
+        if (run_length < min_run) {
+            size_t force = n - lo < min_run ? n - lo : min_run;
+            binary_sort(ts, lo, lo + force, lo + run_length);
+            run_length = force;
+        }
+
+        ts->runs[ts->n_runs].base = lo;
+        ts->runs[ts->n_runs].length = run_length;
+        ts->n_runs++;
+
+        if (merge_collapse(ts) != 0) {
+            return 1;
+        }
+
+        lo += run_length;
+    }
+
+    return merge_force_collapse(ts);
+}
+
+
+// +---------------------------------------------------------------------------+
+// |                           Public Functions                                |
+// +---------------------------------------------------------------------------+
+
+
+//----------
+void *array_sort_stable(
+    void *array,
+    int (*compare)(const void *a, const void *b)
+) {
+    size_t n = array_length(array);
+
+    if (n < 2) {
+        return array;
+    }
+
+    struct timsort ts;
+    ts.size = array_item_size(array);
+    ts.compare = compare;
+    ts.buffer = NULL;
+    ts.min_gallop = MIN_GALLOP;
+    ts.n_runs = 0;
+    ts.pivot = (char *) malloc(ts.size);
+
+    if (!ts.pivot) {
+        return NULL;
+    }
+
+    // Sort a copy of a shared array, and release the caller's reference
+    // only once the sort has succeeded
+    void *sorted = array_is_unique(array) ? array : array_copy(array);
+
+    if (!sorted) {
+        free(ts.pivot);
+        return NULL;
+    }
+
+    ts.base = (char *) sorted;
+
+    int err = timsort(&ts, n);
+
+    free(ts.pivot);
+
+    if (ts.buffer) {
+        array_destroy(ts.buffer);
+    }
+
+    if (err) {
+        if (sorted != array) {
+            array_destroy(sorted);
+        }
+
+        return NULL;
+    }
+
+    if (sorted != array) {
+        array_destroy(array);
+    }
+
+    return sorted;
+}
@@ -0,0 +1,44 @@
+/**
+ * @file array_sort.h
+ * @brief Adaptive stable sorting for arrays
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * `array_sort_stable` is a timsort: it splits the array into natural runs
+ * that are already ascending or strictly descending, extends short runs
+ * with binary insertion sort, and merges runs with galloping merges. Input
+ * that is already sorted, reversed, or made of a few sorted runs is sorted
+ * in close to linear time.
+ *
+ */
+
+#ifndef ARRAY_SORT_H
+#define ARRAY_SORT_H
+
+#include "array.h"
+
+#include <stddef.h>
+
+// +---------------------------------------------------------------------------+
+// |                           Public Interface                                |
+// +---------------------------------------------------------------------------+
+
+/**
+ * @brief Sorts an array in place, keeping items that compare equal in their
+ * original order
+ * @note A shared array is copied before it is sorted. Merges share one
+ * buffer, grown as needed up to half the length of the array.
+ *
+ * @param array The array to sort
+ * @param compare A comparitor function, as for `array_sort`
+ * @return void* Pointer to the start of the sorted array, or NULL if memory
+ * could not be allocated. On failure the array is still owned by the
+ * caller and holds the same items, in an unspecified order if it was not
+ * shared.
+ */
+void *array_sort_stable(
+    void *array,
+    int (*compare)(const void *a, const void *b)
+);
+
+#endif // ARRAY_SORT_H
@@ -0,0 +1,574 @@
+#include "bitarray.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BITARRAY_X86
+#include <immintrin.h>
+
+#define TARGET_SSE42 __attribute__((target("sse4.2")))
+#define TARGET_POPCNT __attribute__((target("popcnt")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+#define WORD_BITS 64
+
+// Number of words covered by each entry of the rank index
+#define BLOCK_WORDS 8
+
+/**
+ * @brief Word-wise operations applied by the bulk functions
+ *
+ */
+enum bit_op {
+    BIT_AND,
+    BIT_OR,
+    BIT_XOR,
+    BIT_ANDNOT
+};
+
+
+// +---------------------------------------------------------------------------+
+// |                           Static Functions                                |
+// +---------------------------------------------------------------------------+
+
+static size_t words_for(size_t length) {
+    return (length + WORD_BITS - 1) / WORD_BITS;
+}
+
+/**
+ * @brief Clears the bits of the last word that are past the length
+ *
+ * @param bits
+ */
+static void clear_tail(bitarray_t *bits) {
+    size_t used = bits->length % WORD_BITS;
+
+    if (used) {
+        bits->words[bits->length / WORD_BITS] &= ((uint64_t)1 << used) - 1;
+    }
+}
+
+static uint64_t apply_op(uint64_t a, uint64_t b, enum bit_op op) {
+    switch (op) {
+        case BIT_AND: return a & b;
+        case BIT_OR: return a | b;
+        case BIT_XOR: return a ^ b;
+        case BIT_ANDNOT: return a & ~b;
+    }
+
+    return a;
+}
+
+
+// -------------------- Scalar kernels
+
+static void op_scalar(uint64_t *dest, const uint64_t *src, size_t n, enum bit_op op) {
+    for (size_t i = 0; i < n; i++) {
+        dest[i] = apply_op(dest[i], src[i], op);
+    }
+}
+
+static size_t popcount_scalar(const uint64_t *p, size_t n) {
+    size_t count = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        count += __builtin_popcountll(p[i]);
+    }
+
+    return count;
+}
+
+
+// -------------------- SSE4.2 kernels
+
+#ifdef BITARRAY_X86
+
+TARGET_SSE42
+static void op_sse42(uint64_t *dest, const uint64_t *src, size_t n, enum bit_op op) {
+    size_t i = 0;
+
+    for (; i + 2 <= n; i += 2) {
+        __m128i a = _mm_loadu_si128((const __m128i *)(dest + i));
+        __m128i b = _mm_loadu_si128((const __m128i *)(src + i));
+
+        switch (op) {
+            case BIT_AND: a = _mm_and_si128(a, b); break;
+            case BIT_OR: a = _mm_or_si128(a, b); break;
+            case BIT_XOR: a = _mm_xor_si128(a, b); break;
+            case BIT_ANDNOT: a = _mm_andnot_si128(b, a); break;
+        }
+
+        _mm_storeu_si128((__m128i *)(dest + i), a);
+    }
+
+    op_scalar(dest + i, src + i, n - i, op);
+}
+
+/**
+ * @brief Checks for the POPCNT instruction, which has its own CPUID bit
+ * separate from SSE4.2
+ *
+ */
+static int cpu_has_popcnt(void) {
+    static int supported = -1;
+    int cached = __atomic_load_n(&supported, __ATOMIC_RELAXED);
+
+    if (cached < 0) {
+        __builtin_cpu_init();
+        cached = __builtin_cpu_supports("popcnt") ? 1 : 0;
+        __atomic_store_n(&supported, cached, __ATOMIC_RELAXED);
+    }
+
+    return cached;
+}
+
+TARGET_POPCNT
+static size_t popcount_popcnt(const uint64_t *p, size_t n) {
+    size_t count = 0;
+
+    for (size_t i = 0; i < n; i++) {
+#if defined(__x86_64__)
+        count += _mm_popcnt_u64(p[i]);
+#else
+        // The 64-bit form needs x86-64
+        count += _mm_popcnt_u32((uint32_t) p[i]) + _mm_popcnt_u32((uint32_t) (p[i] >> 32));
+#endif
+    }
+
+    return count;
+}
+
+
+// -------------------- AVX2 kernels
+
+TARGET_AVX2
+static void op_avx2(uint64_t *dest, const uint64_t *src, size_t n, enum bit_op op) {
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(dest + i));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(src + i));
+
+        switch (op) {
+            case BIT_AND: a = _mm256_and_si256(a, b); break;
+            case BIT_OR: a = _mm256_or_si256(a, b); break;
+            case BIT_XOR: a = _mm256_xor_si256(a, b); break;
+            case BIT_ANDNOT: a = _mm256_andnot_si256(b, a); break;
+        }
+
+        _mm256_storeu_si256((__m256i *)(dest + i), a);
+    }
+
+    op_scalar(dest + i, src + i, n - i, op);
+}
+
+/**
+ * @brief Counts bits by looking up each nibble in a 16-entry table with
+ * `pshufb`, summing the byte counts with `psadbw`
+ *
+ */
+TARGET_AVX2
+static size_t popcount_avx2(const uint64_t *p, size_t n) {
+    const __m256i table = _mm256_setr_epi8(
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+    );
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+    __m256i total = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(p + i));
+        __m256i lo = _mm256_and_si256(v, low_mask);
+        __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+        __m256i bytes = _mm256_add_epi8(
+            _mm256_shuffle_epi8(table, lo),
+            _mm256_shuffle_epi8(table, hi)
+        );
+
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+    }
+
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i *)lanes, total);
+
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + popcount_scalar(p + i, n - i);
+}
+
+#endif
+
+
+// -------------------- Dispatch
+
+static void op_dispatch(uint64_t *dest, const uint64_t *src, size_t n, enum bit_op op) {
+    enum array_simd_level level = array_simd_level();
+
+#ifdef BITARRAY_X86
+    if (level == ARRAY_SIMD_AVX2) {
+        op_avx2(dest, src, n, op);
+        return;
+    }
+
+    if (level == ARRAY_SIMD_SSE42) {
+        op_sse42(dest, src, n, op);
+        return;
+    }
+#endif
+
+    (void)level;
+    op_scalar(dest, src, n, op);
+}
+
+static size_t popcount_dispatch(const uint64_t *p, size_t n) {
+    enum array_simd_level level = array_simd_level();
+
+#ifdef BITARRAY_X86
+    if (level == ARRAY_SIMD_AVX2) {
+        return popcount_avx2(p, n);
+    }
+
+    if (level == ARRAY_SIMD_SSE42 && cpu_has_popcnt()) {
+        return popcount_popcnt(p, n);
+    }
+#endif
+
+    (void)level;
+
+    return popcount_scalar(p, n);
+}
+
+/**
+ * @brief Applies a word-wise operation to two bit arrays of the same length
+ *
+ * @param dest
+ * @param src
+ * @param op
+ * @return int 0 if successful, 1 if the lengths differ
+ */
+static int bulk_op(bitarray_t *dest, bitarray_t *src, enum bit_op op) {
+    if (dest->length != src->length) {
+        return 1;
+    }
+
+    // Bits past the length are 0 in both, so they stay 0 for every op
+    op_dispatch(dest->words, src->words, words_for(dest->length), op);
+    dest->ranks_valid = 0;
+
+    return 0;
+}
+
+
+// -------------------- Rank and select
+
+/**
+ * @brief Rebuilds the rank index if it is out of date
+ * @note Entry b of the index is the number of set bits before block b, and
+ * one extra entry holds the total
+ *
+ * @param bits
+ * @return int 0 if successful, 1 if memory could not be allocated
+ */
+static int ranks_build(bitarray_t *bits) {
+    if (bits->ranks_valid) {
+        return 0;
+    }
+
+    size_t n_words = words_for(bits->length);
+    size_t n_blocks = (n_words + BLOCK_WORDS - 1) / BLOCK_WORDS;
+
+    if (!bits->ranks) {
+        bits->ranks = (uint64_t *) array_init(sizeof(uint64_t), 0);
+
+        if (!bits->ranks) {
+            return 1;
+        }
+    }
+
+    uint64_t *ranks = (uint64_t *) array_set_length(bits->ranks, n_blocks + 1);
+
+    if (!ranks) {
+        return 1;
+    }
+
+    uint64_t total = 0;
+
+    for (size_t b = 0; b < n_blocks; b++) {
+        size_t start = b * BLOCK_WORDS;
+        size_t n = n_words - start < BLOCK_WORDS ? n_words - start : BLOCK_WORDS;
+
+        ranks[b] = total;
+        total += popcount_dispatch(bits->words + start, n);
+    }
+
+    ranks[n_blocks] = total;
+    bits->ranks = ranks;
+    bits->ranks_valid = 1;
+
+    return 0;
+}
+
+/**
+ * @brief Finds the position of the k-th set bit of a word
+ *
+ * @param word A word with more than k bits set
+ * @param k
+ * @return size_t
+ */
+static size_t select_in_word(uint64_t word, size_t k) {
+    for (size_t i = 0; i < k; i++) {
+        word &= word - 1;
+    }
+
+    return __builtin_ctzll(word);
+}
+
+
+// +---------------------------------------------------------------------------+
+// |                           Public Functions                                |
+// +---------------------------------------------------------------------------+
+
+
+// --------------------
+int bitarray_init(bitarray_t *bits, size_t length) {
+    size_t n_words = words_for(length);
+
+    bits->words = (uint64_t *) array_init(sizeof(uint64_t), n_words);
+    bits->length = length;
+    bits->ranks = NULL;
+    bits->ranks_valid = 0;
+
+    if (!bits->words) {
+        return 1;
+    }
+
+    memset(bits->words, 0, n_words * sizeof(uint64_t));
+
+    return 0;
+}
+
+
+// --------------------
+void bitarray_destroy(bitarray_t *bits) {
+    array_destroy(bits->words);
+
+    if (bits->ranks) {
+        array_destroy(bits->ranks);
+    }
+
+    bits->words = NULL;
+    bits->ranks = NULL;
+    bits->length = 0;
+    bits->ranks_valid = 0;
+}
+
+
+// --------------------
+size_t bitarray_length(bitarray_t *bits) {
+    return bits->length;
+}
+
+
+// --------------------
+uint64_t *bitarray_words(bitarray_t *bits) {
+    return bits->words;
+}
+
+
+// --------------------
+void bitarray_invalidate(bitarray_t *bits) {
+    clear_tail(bits);
+    bits->ranks_valid = 0;
+}
+
+
+// --------------------
+int bitarray_resize(bitarray_t *bits, size_t length) {
+    size_t old_words = array_length(bits->words);
+    size_t new_words = words_for(length);
+    uint64_t *words = (uint64_t *) array_set_length(bits->words, new_words);
+
+    if (!words) {
+        return 1;
+    }
+
+    if (new_words > old_words) {
+        memset(words + old_words, 0, (new_words - old_words) * sizeof(uint64_t));
+    }
+
+    bits->words = words;
+    bits->length = length;
+    bits->ranks_valid = 0;
+    clear_tail(bits);
+
+    return 0;
+}
+
+
+// --------------------
+int bitarray_append(bitarray_t *bits, int value) {
+    if (bits->length % WORD_BITS == 0) {
+        uint64_t zero = 0;
+        uint64_t *words = (uint64_t *) array_append(bits->words, &zero);
+
+        if (!words) {
+            return 1;
+        }
+
+        bits->words = words;
+    }
+
+    bits->length++;
+    bits->ranks_valid = 0;
+
+    if (value) {
+        bitarray_set(bits, bits->length - 1);
+    }
+
+    return 0;
+}
+
+
+// --------------------
+int bitarray_set(bitarray_t *bits, size_t index) {
+    if (index >= bits->length) {
+        return 1;
+    }
+
+    bits->words[index / WORD_BITS] |= (uint64_t)1 << (index % WORD_BITS);
+    bits->ranks_valid = 0;
+
+    return 0;
+}
+
+
+// --------------------
+int bitarray_clear(bitarray_t *bits, size_t index) {
+    if (index >= bits->length) {
+        return 1;
+    }
+
+    bits->words[index / WORD_BITS] &= ~((uint64_t)1 << (index % WORD_BITS));
+    bits->ranks_valid = 0;
+
+    return 0;
+}
+
+
+// --------------------
+int bitarray_test(bitarray_t *bits, size_t index) {
+    if (index >= bits->length) {
+        return 0;
+    }
+
+    return (bits->words[index / WORD_BITS] >> (index % WORD_BITS)) & 1;
+}
+
+
+// --------------------
+void bitarray_fill(bitarray_t *bits, int value) {
+    memset(bits->words, value ? 0xff : 0, array_length(bits->words) * sizeof(uint64_t));
+    clear_tail(bits);
+    bits->ranks_valid = 0;
+}
+
+
+// --------------------
+int bitarray_and(bitarray_t *dest, bitarray_t *src) {
+    return bulk_op(dest, src, BIT_AND);
+}
+
+
+// --------------------
+int bitarray_or(bitarray_t *dest, bitarray_t *src) {
+    return bulk_op(dest, src, BIT_OR);
+}
+
+
+// --------------------
+int bitarray_xor(bitarray_t *dest, bitarray_t *src) {
+    return bulk_op(dest, src, BIT_XOR);
+}
+
+
+// --------------------
+int bitarray_andnot(bitarray_t *dest, bitarray_t *src) {
+    return bulk_op(dest, src, BIT_ANDNOT);
+}
+
+
+// --------------------
+size_t bitarray_count(bitarray_t *bits) {
+    if (bits->ranks_valid) {
+        return bits->ranks[array_length(bits->ranks) - 1];
+    }
+
+    return popcount_dispatch(bits->words, words_for(bits->length));
+}
+
+
+// --------------------
+size_t bitarray_rank(bitarray_t *bits, size_t index) {
+    if (index >= bits->length) {
+        return bitarray_count(bits);
+    }
+
+    size_t word = index / WORD_BITS;
+    size_t block = word / BLOCK_WORDS;
+    size_t count;
+
+    // Without an index, count from the start of the array
+    if (ranks_build(bits) == 0) {
+        count = bits->ranks[block];
+    } else {
+        block = 0;
+        count = 0;
+    }
+
+    count += popcount_dispatch(bits->words + block * BLOCK_WORDS, word - block * BLOCK_WORDS);
+
+    size_t used = index % WORD_BITS;
+
+    if (used) {
+        count += __builtin_popcountll(bits->words[word] & (((uint64_t)1 << used) - 1));
+    }
+
+    return count;
+}
+
+
+// --------------------
+size_t bitarray_select(bitarray_t *bits, size_t k) {
+    if (ranks_build(bits) != 0) {
+        return bits->length;
+    }
+
+    size_t n_blocks = array_length(bits->ranks) - 1;
+
+    if (k >= bits->ranks[n_blocks]) {
+        return bits->length;
+    }
+
+    // Find the last block with fewer than k + 1 set bits before it
+    size_t lo = 0, hi = n_blocks;
+
+    while (hi - lo > 1) {
+        size_t mid = lo + (hi - lo) / 2;
+
+        if (bits->ranks[mid] <= k) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+
+    k -= bits->ranks[lo];
+
+    for (size_t w = lo * BLOCK_WORDS; ; w++) {
+        size_t count = __builtin_popcountll(bits->words[w]);
+
+        if (k < count) {
+            return w * WORD_BITS + select_in_word(bits->words[w], k);
+        }
+
+        k -= count;
+    }
+}
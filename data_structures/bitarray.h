@@ -0,0 +1,215 @@
+/**
+ * @file bitarray.h
+ * @brief Packed array of bits with rank and select
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * Bits are packed into 64-bit words stored in an `array`, so a bit array
+ * uses one eighth of the memory of an `array(char)` of flags and grows the
+ * same way as any other array. Bulk operations work a word at a time and
+ * use the instruction set selected by `array_simd_level`.
+ *
+ * `bitarray_rank` and `bitarray_select` use an index of the number of set
+ * bits before every 512-bit block. The index is built on first use and
+ * rebuilt after the bits change.
+ *
+ */
+
+#ifndef BITARRAY_H
+#define BITARRAY_H
+
+#include "array.h"
+#include "array_kernels.h"
+
+#include <stdint.h>
+#include <stddef.h>
+
+// -------------------- Types
+
+/**
+ * @brief A bit array object
+ *
+ * @param words An `array` of words holding the bits, least significant bit
+ * first. Bits past the length are always 0.
+ * @param length Number of bits in the array
+ * @param ranks An `array` of the number of set bits before each block, or
+ * NULL until first built
+ * @param ranks_valid 1 if `ranks` matches the current bits
+ *
+ */
+typedef struct bitarray {
+    uint64_t *words;
+    size_t length;
+    uint64_t *ranks;
+    int ranks_valid;
+} bitarray_t;
+
+// +---------------------------------------------------------------------------+
+// |                           Public Interface                                |
+// +---------------------------------------------------------------------------+
+
+/**
+ * @brief Initialise a bit array with all bits cleared
+ *
+ * @param bits A pointer to the bit array object
+ * @param length The initial number of bits
+ * @return int 0 if successful, 1 otherwise
+ */
+int bitarray_init(bitarray_t *bits, size_t length);
+
+/**
+ * @brief Destroy a bit array
+ *
+ * @param bits A pointer to the bit array object
+ */
+void bitarray_destroy(bitarray_t *bits);
+
+/**
+ * @brief Get the number of bits in the array
+ *
+ * @param bits A pointer to the bit array object
+ * @return size_t
+ */
+size_t bitarray_length(bitarray_t *bits);
+
+/**
+ * @brief Get the words holding the bits
+ * @note The result is an `array` of `uint64_t`. Writing to it directly
+ * requires a call to `bitarray_invalidate` afterwards.
+ *
+ * @param bits A pointer to the bit array object
+ * @return uint64_t* The words of the array
+ */
+uint64_t *bitarray_words(bitarray_t *bits);
+
+/**
+ * @brief Marks the rank index as out of date after the words have been
+ * written directly
+ *
+ * @param bits A pointer to the bit array object
+ */
+void bitarray_invalidate(bitarray_t *bits);
+
+/**
+ * @brief Change the number of bits in the array
+ * @note Bits added by growing the array are cleared
+ *
+ * @param bits A pointer to the bit array object
+ * @param length The new number of bits
+ * @return int 0 if successful, 1 otherwise
+ */
+int bitarray_resize(bitarray_t *bits, size_t length);
+
+/**
+ * @brief Append a bit to the end of the array
+ *
+ * @param bits A pointer to the bit array object
+ * @param value 0 to append a cleared bit, otherwise a set bit
+ * @return int 0 if successful, 1 otherwise
+ */
+int bitarray_append(bitarray_t *bits, int value);
+
+/**
+ * @brief Set the bit at the given index
+ *
+ * @param bits A pointer to the bit array object
+ * @param index
+ * @return int 0 if successful, 1 if the index is out of range
+ */
+int bitarray_set(bitarray_t *bits, size_t index);
+
+/**
+ * @brief Clear the bit at the given index
+ *
+ * @param bits A pointer to the bit array object
+ * @param index
+ * @return int 0 if successful, 1 if the index is out of range
+ */
+int bitarray_clear(bitarray_t *bits, size_t index);
+
+/**
+ * @brief Test the bit at the given index
+ *
+ * @param bits A pointer to the bit array object
+ * @param index
+ * @return int 1 if the bit is set, 0 if it is cleared or out of range
+ */
+int bitarray_test(bitarray_t *bits, size_t index);
+
+/**
+ * @brief Set or clear every bit in the array
+ *
+ * @param bits A pointer to the bit array object
+ * @param value 0 to clear every bit, otherwise set every bit
+ */
+void bitarray_fill(bitarray_t *bits, int value);
+
+/**
+ * @brief Computes `dest &= src`
+ *
+ * @param dest A pointer to the bit array to update
+ * @param src A pointer to a bit array of the same length
+ * @return int 0 if successful, 1 if the lengths differ
+ */
+int bitarray_and(bitarray_t *dest, bitarray_t *src);
+
+/**
+ * @brief Computes `dest |= src`
+ *
+ * @param dest A pointer to the bit array to update
+ * @param src A pointer to a bit array of the same length
+ * @return int 0 if successful, 1 if the lengths differ
+ */
+int bitarray_or(bitarray_t *dest, bitarray_t *src);
+
+/**
+ * @brief Computes `dest ^= src`
+ *
+ * @param dest A pointer to the bit array to update
+ * @param src A pointer to a bit array of the same length
+ * @return int 0 if successful, 1 if the lengths differ
+ */
+int bitarray_xor(bitarray_t *dest, bitarray_t *src);
+
+/**
+ * @brief Computes `dest &= ~src`, clearing every bit of `dest` set in `src`
+ *
+ * @param dest A pointer to the bit array to update
+ * @param src A pointer to a bit array of the same length
+ * @return int 0 if successful, 1 if the lengths differ
+ */
+int bitarray_andnot(bitarray_t *dest, bitarray_t *src);
+
+/**
+ * @brief Count the set bits in the array
+ *
+ * @param bits A pointer to the bit array object
+ * @return size_t The number of set bits
+ */
+size_t bitarray_count(bitarray_t *bits);
+
+/**
+ * @brief Count the set bits before the given index
+ * @note Builds the rank index if it is out of date, after which each call
+ * is O(1)
+ *
+ * @param bits A pointer to the bit array object
+ * @param index One past the last bit to count. Indices past the end count
+ * every bit.
+ * @return size_t The number of set bits in [0, index)
+ */
+size_t bitarray_rank(bitarray_t *bits, size_t index);
+
+/**
+ * @brief Find the position of the k-th set bit, counting from 0
+ * @note Builds the rank index if it is out of date, after which each call
+ * is O(log n)
+ *
+ * @param bits A pointer to the bit array object
+ * @param k
+ * @return size_t The index of the bit, or the length of the array if fewer
+ * than k + 1 bits are set
+ */
+size_t bitarray_select(bitarray_t *bits, size_t k);
+
+#endif // BITARRAY_H
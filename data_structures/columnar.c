@@ -0,0 +1,249 @@
+#include "columnar.h"
+
+// +---------------------------------------------------------------------------+
+// |                           Static Functions                                |
+// +---------------------------------------------------------------------------+
+
+/**
+ * @brief Ensures every column is unshared and can hold `n_rows` more rows,
+ * growing the columns geometrically
+ * @note Rows are written past a column's length before `sync_lengths`, so
+ * a shared column must be copied first or the rows would be lost
+ *
+ * @param table
+ * @param n_rows
+ * @return int 0 if successful, 1 otherwise
+ */
+static int ensure_rows(columnar_t *table, size_t n_rows) {
+    size_t required = table->length + n_rows;
+    size_t grown = table->length * 2;
+
+    for (size_t c = 0; c < array_length(table->columns); c++) {
+        void *data = array_unshare(table->columns[c].data);
+
+        if (!data) {
+            return 1;
+        }
+
+        table->columns[c].data = data;
+    }
+
+    for (size_t c = 0; c < array_length(table->columns); c++) {
+        if (array_capacity(table->columns[c].data) >= required) {
+            continue;
+        }
+
+        if (columnar_reserve(table, grown > required ? grown : required) != 0) {
+            return 1;
+        }
+
+        break;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Sets the length of every column to the table's length
+ * @note The columns must already have enough capacity
+ *
+ * @param table
+ * @return int 0 if successful, 1 otherwise
+ */
+static int sync_lengths(columnar_t *table) {
+    for (size_t c = 0; c < array_length(table->columns); c++) {
+        void *data = array_set_length(table->columns[c].data, table->length);
+
+        if (!data) {
+            return 1;
+        }
+
+        table->columns[c].data = data;
+    }
+
+    return 0;
+}
+
+
+// +---------------------------------------------------------------------------+
+// |                           Public Functions                                |
+// +---------------------------------------------------------------------------+
+
+
+// --------------------
+int columnar_init(columnar_t *table) {
+    table->columns = array(struct column);
+    table->length = 0;
+
+    return table->columns ? 0 : 1;
+}
+
+
+// --------------------
+void columnar_destroy(columnar_t *table) {
+    for (size_t c = 0; c < array_length(table->columns); c++) {
+        array_destroy(table->columns[c].data);
+    }
+
+    array_destroy(table->columns);
+
+    table->columns = NULL;
+    table->length = 0;
+}
+
+
+// --------------------
+int columnar_add_column(columnar_t *table, size_t item_size, size_t offset) {
+    if (item_size == 0) {
+        return 1;
+    }
+
+    struct column column;
+    column.data = array_init(item_size, table->length);
+    column.offset = offset;
+
+    if (!column.data) {
+        return 1;
+    }
+
+    memset(column.data, 0, item_size * table->length);
+
+    struct column *columns = (struct column *) array_append(table->columns, &column);
+
+    if (!columns) {
+        array_destroy(column.data);
+        return 1;
+    }
+
+    table->columns = columns;
+
+    return 0;
+}
+
+
+// --------------------
+size_t columnar_length(columnar_t *table) {
+    return table->length;
+}
+
+
+// --------------------
+size_t columnar_n_columns(columnar_t *table) {
+    return array_length(table->columns);
+}
+
+
+// --------------------
+void *columnar_column(columnar_t *table, size_t column) {
+    if (column >= array_length(table->columns)) {
+        return NULL;
+    }
+
+    return table->columns[column].data;
+}
+
+
+// --------------------
+void *columnar_at(columnar_t *table, size_t column, size_t row) {
+    void *data = columnar_column(table, column);
+
+    return data ? array_at(data, row) : NULL;
+}
+
+
+// --------------------
+int columnar_reserve(columnar_t *table, size_t capacity) {
+    for (size_t c = 0; c < array_length(table->columns); c++) {
+        void *data = table->columns[c].data;
+
+        if (array_capacity(data) >= capacity) {
+            continue;
+        }
+
+        // On failure the column is left as it was
+        data = array_resize(data, capacity);
+
+        if (!data) {
+            return 1;
+        }
+
+        table->columns[c].data = data;
+    }
+
+    return 0;
+}
+
+
+// --------------------
+int columnar_set_length(columnar_t *table, size_t length) {
+    if (length > table->length && columnar_reserve(table, length) != 0) {
+        return 1;
+    }
+
+    table->length = length;
+
+    return sync_lengths(table);
+}
+
+
+// --------------------
+int columnar_append_row(columnar_t *table, const void *row) {
+    return columnar_append_rows(table, row, 1, 0);
+}
+
+
+// --------------------
+int columnar_append_rows(
+    columnar_t *table,
+    const void *rows,
+    size_t n_rows,
+    size_t row_size
+) {
+    if (ensure_rows(table, n_rows) != 0) {
+        return 1;
+    }
+
+    const char *src = (const char *) rows;
+
+    for (size_t c = 0; c < array_length(table->columns); c++) {
+        struct column *column = &table->columns[c];
+        size_t item_size = array_item_size(column->data);
+        char *dest = (char *) column->data + table->length * item_size;
+
+        for (size_t r = 0; r < n_rows; r++) {
+            memcpy(dest + r * item_size, src + r * row_size + column->offset, item_size);
+        }
+    }
+
+    table->length += n_rows;
+
+    return sync_lengths(table);
+}
+
+
+// --------------------
+int columnar_gather_rows(
+    columnar_t *table,
+    size_t start,
+    size_t n_rows,
+    void *rows,
+    size_t row_size
+) {
+    if (start > table->length || n_rows > table->length - start) {
+        return 1;
+    }
+
+    char *dest = (char *) rows;
+
+    for (size_t c = 0; c < array_length(table->columns); c++) {
+        struct column *column = &table->columns[c];
+        size_t item_size = array_item_size(column->data);
+        const char *src = (const char *) column->data + start * item_size;
+
+        for (size_t r = 0; r < n_rows; r++) {
+            memcpy(dest + r * row_size + column->offset, src + r * item_size, item_size);
+        }
+    }
+
+    return 0;
+}
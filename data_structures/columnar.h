@@ -0,0 +1,213 @@
+/**
+ * @file columnar.h
+ * @brief Columnar (structure of arrays) table built on `array`
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * Each field of a record is stored in its own `array`, so scans over one
+ * field only touch that field's memory and can use the kernels in
+ * array_kernels.h. All columns share the table's length.
+ *
+ * Columns are registered with the size of the field and its offset in the
+ * record struct, which lets rows be appended from and gathered into
+ * ordinary structs:
+ *
+ *     struct record { int id; double price; };
+ *
+ *     columnar_t table;
+ *     columnar_init(&table);
+ *     columnar_add_field(&table, struct record, id);
+ *     columnar_add_field(&table, struct record, price);
+ *
+ *     columnar_append_row(&table, &rec);
+ *     double *prices = (double *) columnar_column(&table, 1);
+ *
+ */
+
+#ifndef COLUMNAR_H
+#define COLUMNAR_H
+
+#include "array.h"
+
+#include <stddef.h>
+
+// -------------------- Types
+
+/**
+ * @brief A column of a columnar table
+ *
+ * @param data The `array` holding the column's items
+ * @param offset Offset of the field within a row struct
+ *
+ */
+struct column {
+    void *data;
+    size_t offset;
+};
+
+/**
+ * @brief A columnar table object
+ *
+ * @param columns An `array` of the table's columns
+ * @param length Number of rows in the table
+ *
+ */
+typedef struct columnar {
+    struct column *columns;
+    size_t length;
+} columnar_t;
+
+// -------------------- Macros
+
+/**
+ * @brief Registers a column for a field of a row struct
+ *
+ * @param table A pointer to the table
+ * @param type The row struct type, e.g. `struct record`
+ * @param field The name of the field
+ * @return int 0 if successful, 1 otherwise
+ */
+#define columnar_add_field(table, type, field) \
+    columnar_add_column((table), sizeof(((type *) 0)->field), offsetof(type, field))
+
+// +---------------------------------------------------------------------------+
+// |                           Public Interface                                |
+// +---------------------------------------------------------------------------+
+
+/**
+ * @brief Initialise an empty table with no columns
+ *
+ * @param table A pointer to the table
+ * @return int 0 if successful, 1 otherwise
+ */
+int columnar_init(columnar_t *table);
+
+/**
+ * @brief Destroy a table and all of its columns
+ *
+ * @param table A pointer to the table
+ */
+void columnar_destroy(columnar_t *table);
+
+/**
+ * @brief Registers a new column. Columns are numbered in the order they are
+ * added, starting from 0.
+ * @note If the table already has rows, the new column is zero-filled
+ *
+ * @param table A pointer to the table
+ * @param item_size Size of the column's items in bytes
+ * @param offset Offset of the field within a row struct, used by the row
+ * functions
+ * @return int 0 if successful, 1 otherwise
+ */
+int columnar_add_column(columnar_t *table, size_t item_size, size_t offset);
+
+/**
+ * @brief Get the number of rows in the table
+ *
+ * @param table A pointer to the table
+ * @return size_t
+ */
+size_t columnar_length(columnar_t *table);
+
+/**
+ * @brief Get the number of columns in the table
+ *
+ * @param table A pointer to the table
+ * @return size_t
+ */
+size_t columnar_n_columns(columnar_t *table);
+
+/**
+ * @brief Get the `array` holding a column
+ * @note The column may be read and its items written with any `array_*`
+ * function. Functions that change its length or move it, e.g.
+ * `array_append`, must not be used; change the table instead. The pointer
+ * is invalidated by any call that adds rows.
+ *
+ * @param table A pointer to the table
+ * @param column The index of the column
+ * @return void* The column, or NULL if the index is out of range
+ */
+void *columnar_column(columnar_t *table, size_t column);
+
+/**
+ * @brief Returns a pointer to a single item of a column
+ *
+ * @param table A pointer to the table
+ * @param column The index of the column
+ * @param row The index of the row
+ * @return void* Pointer to the item, or NULL if either index is out of range
+ */
+void *columnar_at(columnar_t *table, size_t column, size_t row);
+
+/**
+ * @brief Reserve space in every column for at least `capacity` rows
+ *
+ * @param table A pointer to the table
+ * @param capacity
+ * @return int 0 if successful, 1 otherwise. On failure the rows are
+ * unchanged.
+ */
+int columnar_reserve(columnar_t *table, size_t capacity);
+
+/**
+ * @brief Sets the number of rows in the table
+ * @note Rows added by growing the length are uninitialised
+ *
+ * @param table A pointer to the table
+ * @param length
+ * @return int 0 if successful, 1 otherwise
+ */
+int columnar_set_length(columnar_t *table, size_t length);
+
+/**
+ * @brief Appends a row, scattering each field of the row struct into its
+ * column
+ *
+ * @param table A pointer to the table
+ * @param row A pointer to the row struct
+ * @return int 0 if successful, 1 otherwise
+ */
+int columnar_append_row(columnar_t *table, const void *row);
+
+/**
+ * @brief Appends a batch of rows from an array of row structs
+ * @note Rows are scattered one column at a time
+ *
+ * @param table A pointer to the table
+ * @param rows A pointer to the first row struct
+ * @param n_rows Number of rows to append
+ * @param row_size Size of a row struct in bytes, i.e. the distance between
+ * consecutive rows
+ * @return int 0 if successful, 1 otherwise. On failure no rows are added.
+ */
+int columnar_append_rows(
+    columnar_t *table,
+    const void *rows,
+    size_t n_rows,
+    size_t row_size
+);
+
+/**
+ * @brief Gathers the rows [start, start + n_rows) into an array of row
+ * structs
+ * @note Rows are gathered one column at a time. Bytes of the row structs
+ * not covered by a column are left unchanged.
+ *
+ * @param table A pointer to the table
+ * @param start Index of the first row to gather
+ * @param n_rows Number of rows to gather
+ * @param rows A pointer to store the row structs in
+ * @param row_size Size of a row struct in bytes
+ * @return int 0 if successful, 1 if the range is invalid
+ */
+int columnar_gather_rows(
+    columnar_t *table,
+    size_t start,
+    size_t n_rows,
+    void *rows,
+    size_t row_size
+);
+
+#endif // COLUMNAR_H
@@ -0,0 +1,155 @@
+#include "ilist.h"
+
+// +---------------------------------------------------------------------------+
+// |                           Static Functions                                |
+// +---------------------------------------------------------------------------+
+
+/**
+ * @brief Links `link` between two adjacent links
+ *
+ * @param prev
+ * @param next
+ * @param link
+ */
+static void link_between(ilist_link_t *prev, ilist_link_t *next, ilist_link_t *link) {
+    link->prev = prev;
+    link->next = next;
+    prev->next = link;
+    next->prev = link;
+}
+
+/**
+ * @brief Returns a link, or NULL if it is the sentinel
+ *
+ * @param list
+ * @param link
+ * @return ilist_link_t*
+ */
+static ilist_link_t *member_or_null(ilist_t *list, ilist_link_t *link) {
+    return link == &list->sentinel ? NULL : link;
+}
+
+
+// +---------------------------------------------------------------------------+
+// |                           Public Functions                                |
+// +---------------------------------------------------------------------------+
+
+
+// --------------------
+int ilist_init(ilist_t *list) {
+    list->sentinel.next = &list->sentinel;
+    list->sentinel.prev = &list->sentinel;
+    list->length = 0;
+
+    return 0;
+}
+
+
+// --------------------
+void ilist_link_init(ilist_link_t *link) {
+    link->next = NULL;
+    link->prev = NULL;
+}
+
+
+// --------------------
+int ilist_is_linked(ilist_link_t *link) {
+    return link->next != NULL;
+}
+
+
+// --------------------
+size_t ilist_length(ilist_t *list) {
+    return list->length;
+}
+
+
+// --------------------
+int ilist_empty(ilist_t *list) {
+    return list->length == 0;
+}
+
+
+// --------------------
+void ilist_push_front(ilist_t *list, ilist_link_t *link) {
+    link_between(&list->sentinel, list->sentinel.next, link);
+    list->length++;
+}
+
+
+// --------------------
+void ilist_push_back(ilist_t *list, ilist_link_t *link) {
+    link_between(list->sentinel.prev, &list->sentinel, link);
+    list->length++;
+}
+
+
+// --------------------
+void ilist_insert_after(ilist_t *list, ilist_link_t *pos, ilist_link_t *link) {
+    link_between(pos, pos->next, link);
+    list->length++;
+}
+
+
+// --------------------
+void ilist_insert_before(ilist_t *list, ilist_link_t *pos, ilist_link_t *link) {
+    link_between(pos->prev, pos, link);
+    list->length++;
+}
+
+
+// --------------------
+void ilist_remove(ilist_t *list, ilist_link_t *link) {
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+    ilist_link_init(link);
+    list->length--;
+}
+
+
+// --------------------
+ilist_link_t *ilist_pop_front(ilist_t *list) {
+    ilist_link_t *link = ilist_first(list);
+
+    if (link) {
+        ilist_remove(list, link);
+    }
+
+    return link;
+}
+
+
+// --------------------
+ilist_link_t *ilist_pop_back(ilist_t *list) {
+    ilist_link_t *link = ilist_last(list);
+
+    if (link) {
+        ilist_remove(list, link);
+    }
+
+    return link;
+}
+
+
+// --------------------
+ilist_link_t *ilist_first(ilist_t *list) {
+    return member_or_null(list, list->sentinel.next);
+}
+
+
+// --------------------
+ilist_link_t *ilist_last(ilist_t *list) {
+    return member_or_null(list, list->sentinel.prev);
+}
+
+
+// --------------------
+ilist_link_t *ilist_next(ilist_t *list, ilist_link_t *link) {
+    return member_or_null(list, link->next);
+}
+
+
+// --------------------
+ilist_link_t *ilist_prev(ilist_t *list, ilist_link_t *link) {
+    return member_or_null(list, link->prev);
+}
@@ -0,0 +1,204 @@
+/**
+ * @file ilist.h
+ * @brief Intrusive doubly linked list
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * Instead of the list allocating nodes, callers embed an `ilist_link_t` in
+ * their own structs and link those. Adding and removing an object never
+ * allocates, and an object can be removed in O(1) given only a pointer to
+ * it. Use `ilist_entry` to get from a link back to the object:
+ *
+ *     struct task { int id; ilist_link_t link; };
+ *
+ *     ilist_push_back(&list, &task->link);
+ *     struct task *first = ilist_entry(ilist_first(&list), struct task, link);
+ *
+ * The list does not own its objects; they must outlive their membership.
+ *
+ */
+
+#ifndef ILIST_H
+#define ILIST_H
+
+#include <stddef.h>
+
+// -------------------- Types
+
+/**
+ * @brief A link embedded in an object that can be a member of a list
+ *
+ * @param next Pointer to the next link, or NULL if not in a list
+ * @param prev Pointer to the previous link, or NULL if not in a list
+ *
+ */
+typedef struct ilist_link {
+    struct ilist_link *next;
+    struct ilist_link *prev;
+} ilist_link_t;
+
+/**
+ * @brief An intrusive list object
+ * @note The list is circular through `sentinel`, so linking and unlinking
+ * never need to special-case the ends
+ *
+ * @param sentinel Link before the first and after the last member
+ * @param length Number of members in the list
+ *
+ */
+typedef struct ilist {
+    ilist_link_t sentinel;
+    size_t length;
+} ilist_t;
+
+// -------------------- Macros
+
+/**
+ * @brief Get the object containing a link
+ *
+ * @param link A pointer to the link
+ * @param type The type of the containing struct
+ * @param member The name of the link within the struct
+ * @return type* Pointer to the containing object
+ */
+#define ilist_entry(link, type, member) \
+    ((type *) ((char *) (link) - offsetof(type, member)))
+
+// +---------------------------------------------------------------------------+
+// |                           Public Interface                                |
+// +---------------------------------------------------------------------------+
+
+/**
+ * @brief Initialise an empty list
+ *
+ * @param list A pointer to the list object
+ * @return int 0 if successful, 1 otherwise
+ */
+int ilist_init(ilist_t *list);
+
+/**
+ * @brief Initialise a link that is not in any list
+ *
+ * @param link A pointer to the link
+ */
+void ilist_link_init(ilist_link_t *link);
+
+/**
+ * @brief Check if a link is currently in a list
+ * @note The link must have been initialised with `ilist_link_init` or have
+ * been in a list
+ *
+ * @param link A pointer to the link
+ * @return int 1 if the link is in a list, 0 otherwise
+ */
+int ilist_is_linked(ilist_link_t *link);
+
+/**
+ * @brief Get the number of members in the list
+ *
+ * @param list A pointer to the list object
+ * @return size_t
+ */
+size_t ilist_length(ilist_t *list);
+
+/**
+ * @brief Check if the list is empty
+ *
+ * @param list A pointer to the list object
+ * @return int 1 if the list is empty, 0 otherwise
+ */
+int ilist_empty(ilist_t *list);
+
+/**
+ * @brief Add a link to the front of the list
+ *
+ * @param list A pointer to the list object
+ * @param link A pointer to a link that is not in any list
+ */
+void ilist_push_front(ilist_t *list, ilist_link_t *link);
+
+/**
+ * @brief Add a link to the end of the list
+ *
+ * @param list A pointer to the list object
+ * @param link A pointer to a link that is not in any list
+ */
+void ilist_push_back(ilist_t *list, ilist_link_t *link);
+
+/**
+ * @brief Add a link directly after a member of the list
+ *
+ * @param list A pointer to the list object
+ * @param pos A pointer to a link in the list
+ * @param link A pointer to a link that is not in any list
+ */
+void ilist_insert_after(ilist_t *list, ilist_link_t *pos, ilist_link_t *link);
+
+/**
+ * @brief Add a link directly before a member of the list
+ *
+ * @param list A pointer to the list object
+ * @param pos A pointer to a link in the list
+ * @param link A pointer to a link that is not in any list
+ */
+void ilist_insert_before(ilist_t *list, ilist_link_t *pos, ilist_link_t *link);
+
+/**
+ * @brief Remove a link from the list in O(1)
+ *
+ * @param list A pointer to the list object
+ * @param link A pointer to a link in the list
+ */
+void ilist_remove(ilist_t *list, ilist_link_t *link);
+
+/**
+ * @brief Remove the first link of the list
+ *
+ * @param list A pointer to the list object
+ * @return ilist_link_t* The removed link, or NULL if the list is empty
+ */
+ilist_link_t *ilist_pop_front(ilist_t *list);
+
+/**
+ * @brief Remove the last link of the list
+ *
+ * @param list A pointer to the list object
+ * @return ilist_link_t* The removed link, or NULL if the list is empty
+ */
+ilist_link_t *ilist_pop_back(ilist_t *list);
+
+/**
+ * @brief Get the first link of the list
+ *
+ * @param list A pointer to the list object
+ * @return ilist_link_t* The first link, or NULL if the list is empty
+ */
+ilist_link_t *ilist_first(ilist_t *list);
+
+/**
+ * @brief Get the last link of the list
+ *
+ * @param list A pointer to the list object
+ * @return ilist_link_t* The last link, or NULL if the list is empty
+ */
+ilist_link_t *ilist_last(ilist_t *list);
+
+/**
+ * @brief Get the link after a member of the list
+ *
+ * @param list A pointer to the list object
+ * @param link A pointer to a link in the list
+ * @return ilist_link_t* The next link, or NULL if `link` is the last
+ */
+ilist_link_t *ilist_next(ilist_t *list, ilist_link_t *link);
+
+/**
+ * @brief Get the link before a member of the list
+ *
+ * @param list A pointer to the list object
+ * @param link A pointer to a link in the list
+ * @return ilist_link_t* The previous link, or NULL if `link` is the first
+ */
+ilist_link_t *ilist_prev(ilist_t *list, ilist_link_t *link);
+
+#endif // ILIST_H
@@ -0,0 +1,262 @@
+#include "lflist.h"
+
+#include <stdint.h>
+
+// Items start at this offset in a node, aligned for any scalar type
+#define ITEM_OFFSET ((sizeof(lflist_node_t) + 15) / 16 * 16)
+
+// +---------------------------------------------------------------------------+
+// |                           Static Functions                                |
+// +---------------------------------------------------------------------------+
+
+static void *node_data(lflist_node_t *node) {
+    return (char *) node + ITEM_OFFSET;
+}
+
+static int is_marked(lflist_node_t *next) {
+    return ((uintptr_t) next & 1) != 0;
+}
+
+static lflist_node_t *marked(lflist_node_t *next) {
+    return (lflist_node_t *) ((uintptr_t) next | 1);
+}
+
+static lflist_node_t *unmarked(lflist_node_t *next) {
+    return (lflist_node_t *) ((uintptr_t) next & ~(uintptr_t) 1);
+}
+
+static lflist_node_t *load(lflist_node_t **link) {
+    return __atomic_load_n(link, __ATOMIC_ACQUIRE);
+}
+
+static int cas(lflist_node_t **link, lflist_node_t *expected, lflist_node_t *desired) {
+    return __atomic_compare_exchange_n(
+        link, &expected, desired, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE
+    );
+}
+
+static void node_free(epoch_retired_t *retired) {
+    free((char *) retired - offsetof(lflist_node_t, retired));
+}
+
+/**
+ * @brief Finds the first node not less than `key`, unlinking marked nodes
+ * on the way
+ * @note Must be called inside a critical section
+ *
+ * @param list
+ * @param thread
+ * @param key
+ * @param prev_out Set to the link that points to the node found
+ * @param curr_out Set to the node found, or NULL at the end of the list
+ * @return int 1 if the node found is equal to `key`, 0 otherwise
+ */
+static int find(
+    lflist_t *list,
+    epoch_thread_t *thread,
+    const void *key,
+    lflist_node_t ***prev_out,
+    lflist_node_t **curr_out
+) {
+retry:;
+    lflist_node_t **prev = &list->head;
+    lflist_node_t *curr = load(prev);
+
+    while (curr) {
+        lflist_node_t *next = load(&curr->next);
+
+        // The link to curr changed, e.g. its predecessor was removed
+        if (load(prev) != curr) {
+            goto retry;
+        }
+
+        if (is_marked(next)) {
+            // curr is logically removed, so help unlink it
+            if (!cas(prev, curr, unmarked(next))) {
+                goto retry;
+            }
+
+            epoch_retire(thread, &curr->retired, node_free);
+            curr = unmarked(next);
+            continue;
+        }
+
+        int order = list->compare(node_data(curr), key);
+
+        if (order >= 0) {
+            *prev_out = prev;
+            *curr_out = curr;
+            return order == 0;
+        }
+
+        prev = &curr->next;
+        curr = next;
+    }
+
+    *prev_out = prev;
+    *curr_out = NULL;
+
+    return 0;
+}
+
+/**
+ * @brief Finds the node equal to `key` without modifying the list
+ * @note Must be called inside a critical section
+ *
+ * @param list
+ * @param key
+ * @return lflist_node_t* The node, or NULL if none is present
+ */
+static lflist_node_t *lookup(lflist_t *list, const void *key) {
+    lflist_node_t *curr = load(&list->head);
+
+    while (curr && list->compare(node_data(curr), key) < 0) {
+        curr = unmarked(load(&curr->next));
+    }
+
+    if (!curr || list->compare(node_data(curr), key) != 0 || is_marked(load(&curr->next))) {
+        return NULL;
+    }
+
+    return curr;
+}
+
+
+// +---------------------------------------------------------------------------+
+// |                           Public Functions                                |
+// +---------------------------------------------------------------------------+
+
+
+// --------------------
+int lflist_init(lflist_t *list, size_t item_size, int (*compare)(const void *, const void *)) {
+    list->head = NULL;
+    list->item_size = item_size;
+    list->compare = compare;
+    list->length = 0;
+
+    return 0;
+}
+
+
+// --------------------
+void lflist_destroy(lflist_t *list) {
+    lflist_node_t *node = list->head;
+
+    while (node) {
+        lflist_node_t *next = unmarked(node->next);
+        free(node);
+        node = next;
+    }
+
+    list->head = NULL;
+    list->length = 0;
+}
+
+
+// --------------------
+size_t lflist_length(lflist_t *list) {
+    return __atomic_load_n(&list->length, __ATOMIC_RELAXED);
+}
+
+
+// --------------------
+int lflist_insert(lflist_t *list, epoch_thread_t *thread, const void *item) {
+    lflist_node_t *node = (lflist_node_t *) malloc(ITEM_OFFSET + list->item_size);
+
+    if (!node) {
+        return 1;
+    }
+
+    memcpy(node_data(node), item, list->item_size);
+
+    epoch_enter(thread);
+
+    for (;;) {
+        lflist_node_t **prev;
+        lflist_node_t *curr;
+
+        if (find(list, thread, item, &prev, &curr)) {
+            epoch_exit(thread);
+            free(node);
+            return 1;
+        }
+
+        node->next = curr;
+
+        if (cas(prev, curr, node)) {
+            break;
+        }
+    }
+
+    epoch_exit(thread);
+    __atomic_fetch_add(&list->length, 1, __ATOMIC_RELAXED);
+
+    return 0;
+}
+
+
+// --------------------
+int lflist_remove(lflist_t *list, epoch_thread_t *thread, const void *key, void *item) {
+    epoch_enter(thread);
+
+    for (;;) {
+        lflist_node_t **prev;
+        lflist_node_t *curr;
+
+        if (!find(list, thread, key, &prev, &curr)) {
+            epoch_exit(thread);
+            return 1;
+        }
+
+        lflist_node_t *next = load(&curr->next);
+
+        // Marking the node is the removal; whoever marks it owns it
+        if (is_marked(next) || !cas(&curr->next, next, marked(next))) {
+            continue;
+        }
+
+        if (item) {
+            memcpy(item, node_data(curr), list->item_size);
+        }
+
+        if (cas(prev, curr, next)) {
+            epoch_retire(thread, &curr->retired, node_free);
+        } else {
+            // Another thread changed prev; a traversal unlinks the node
+            find(list, thread, key, &prev, &curr);
+        }
+
+        break;
+    }
+
+    epoch_exit(thread);
+    __atomic_fetch_sub(&list->length, 1, __ATOMIC_RELAXED);
+
+    return 0;
+}
+
+
+// --------------------
+int lflist_contains(lflist_t *list, epoch_thread_t *thread, const void *key) {
+    epoch_enter(thread);
+    int found = lookup(list, key) != NULL;
+    epoch_exit(thread);
+
+    return found;
+}
+
+
+// --------------------
+int lflist_get(lflist_t *list, epoch_thread_t *thread, const void *key, void *item) {
+    epoch_enter(thread);
+
+    lflist_node_t *node = lookup(list, key);
+
+    if (node) {
+        memcpy(item, node_data(node), list->item_size);
+    }
+
+    epoch_exit(thread);
+
+    return node ? 0 : 1;
+}
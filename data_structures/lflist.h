@@ -0,0 +1,132 @@
+/**
+ * @file lflist.h
+ * @brief Lock-free sorted linked list, for sets shared between threads
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * The Harris/Michael algorithm: a node is removed by first marking the low
+ * bit of its `next` pointer, which stops any insert after it, and then
+ * unlinking it with a compare-and-swap. Traversals help unlink marked nodes
+ * they pass. Unlinked nodes are freed through epoch-based reclamation, so
+ * readers never touch freed memory.
+ *
+ * Every operation takes the calling thread's `epoch_thread_t`, registered
+ * with the domain the list was created with.
+ *
+ */
+
+#ifndef LFLIST_H
+#define LFLIST_H
+
+#include "../synchronization/epoch.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// -------------------- Types
+
+/**
+ * @brief A node of a lock-free list
+ * @note The item is stored inline, after the node
+ *
+ * @param next Pointer to the next node, with the low bit set once this
+ * node is logically removed
+ * @param retired Record used to free the node after it is unlinked
+ *
+ */
+typedef struct lflist_node {
+    struct lflist_node *next;
+    epoch_retired_t retired;
+} lflist_node_t;
+
+/**
+ * @brief A lock-free sorted list object
+ *
+ * @param head Pointer to the first node
+ * @param item_size Size of each item in bytes
+ * @param compare Orders the items; items that compare equal are the same
+ * @param length Number of items, exact once concurrent operations finish
+ *
+ */
+typedef struct lflist {
+    lflist_node_t *head;
+    size_t item_size;
+    int (*compare)(const void *, const void *);
+    size_t length;
+} lflist_t;
+
+// +---------------------------------------------------------------------------+
+// |                           Public Interface                                |
+// +---------------------------------------------------------------------------+
+
+/**
+ * @brief Initialise an empty list
+ *
+ * @param list A pointer to the list object
+ * @param item_size The size of an item in the list
+ * @param compare A function to order two items
+ * @return int 0 if successful, 1 otherwise
+ */
+int lflist_init(lflist_t *list, size_t item_size, int (*compare)(const void *, const void *));
+
+/**
+ * @brief Free every node of the list
+ * @note No other thread may be using the list
+ *
+ * @param list A pointer to the list object
+ */
+void lflist_destroy(lflist_t *list);
+
+/**
+ * @brief Get the number of items in the list
+ *
+ * @param list A pointer to the list object
+ * @return size_t
+ */
+size_t lflist_length(lflist_t *list);
+
+/**
+ * @brief Insert an item in order, unless an equal item is present
+ *
+ * @param list A pointer to the list object
+ * @param thread The calling thread's epoch state
+ * @param item A pointer to the item to insert
+ * @return int 0 if inserted, 1 if an equal item is present or memory could
+ * not be allocated
+ */
+int lflist_insert(lflist_t *list, epoch_thread_t *thread, const void *item);
+
+/**
+ * @brief Remove the item equal to `key`
+ *
+ * @param list A pointer to the list object
+ * @param thread The calling thread's epoch state
+ * @param key A pointer to an item comparing equal to the one to remove
+ * @param item A pointer to store the removed item, or NULL
+ * @return int 0 if removed, 1 if no equal item is present
+ */
+int lflist_remove(lflist_t *list, epoch_thread_t *thread, const void *key, void *item);
+
+/**
+ * @brief Check if an item equal to `key` is present
+ * @note Never writes to the list, so it does not slow down other readers
+ *
+ * @param list A pointer to the list object
+ * @param thread The calling thread's epoch state
+ * @param key A pointer to the item to look for
+ * @return int 1 if present, 0 otherwise
+ */
+int lflist_contains(lflist_t *list, epoch_thread_t *thread, const void *key);
+
+/**
+ * @brief Copy the item equal to `key`
+ *
+ * @param list A pointer to the list object
+ * @param thread The calling thread's epoch state
+ * @param key A pointer to the item to look for
+ * @param item A pointer to store the item found
+ * @return int 0 if found, 1 otherwise
+ */
+int lflist_get(lflist_t *list, epoch_thread_t *thread, const void *key, void *item);
+
+#endif // LFLIST_H
@@ -8,26 +8,32 @@
 /**
  * @brief Creates a new node
  * 
- * @param item_size 
+ * @param list 
  * @param item 
  * @return linkedlist_node_t* Pointer to the new node
  */
-static linkedlist_node_t *node_create(size_t item_size, const void *item) {
-    linkedlist_node_t *node = (linkedlist_node_t *) malloc(sizeof(linkedlist_node_t));
-
-    if (!node) {
-        return NULL;
+static linkedlist_node_t *node_create(linkedlist_t *list, const void *item) {
+    size_t item_size = list->header.item_size;
+    linkedlist_node_t *node;
+
+    // The item is stored directly after the links, in the same allocation
+    if (list->spare) {
+        // Reuse a node kept by linkedlist_clear
+        node = list->spare;
+        list->spare = node->next;
+        list->n_spare--;
+    } else if (list->pool) {
+        node = (linkedlist_node_t *) nodepool_alloc(list->pool);
+    } else {
+        node = (linkedlist_node_t *) malloc(linkedlist_node_size(item_size));
     }
 
-    node->data = malloc(item_size);
-
-    if (!node->data) {
-        free(node);
+    if (!node) {
         return NULL;
     }
 
     // Copy the item to the node
-    memcpy(node->data, item, item_size);
+    memcpy(linkedlist_node_data(node), item, item_size);
     node->next = NULL;
     node->prev = NULL;
 
@@ -37,11 +43,29 @@ static linkedlist_node_t *node_create(size_t item_size, const void *item) {
 /**
  * @brief De-allocates a node's memory
  * 
- * @param current 
+ * @param list 
+ * @param node 
+ */
+static void node_destroy(linkedlist_t *list, linkedlist_node_t *node) {
+    if (list->pool) {
+        nodepool_free(list->pool, node);
+    } else {
+        free(node);
+    }
+}
+
+/**
+ * @brief Frees every node of a chain linked through `next`
+ * 
+ * @param list 
+ * @param node The first node of the chain, or NULL
  */
-static void node_destroy(linkedlist_node_t *node) {
-    free(node->data);
-    free(node);
+static void nodes_destroy(linkedlist_t *list, linkedlist_node_t *node) {
+    while (node) {
+        linkedlist_node_t *next = node->next;
+        node_destroy(list, node);
+        node = next;
+    }
 }
 
 /**
@@ -76,6 +100,268 @@ static void node_detach(linkedlist_node_t *node) {
     }
 }
 
+/**
+ * @brief Links a node into the list after `prev`, or at the head
+ * 
+ * @param list 
+ * @param prev The node to link after, or NULL to link at the head
+ * @param node A node that is not in any list
+ */
+static void list_link_after(linkedlist_t *list, linkedlist_node_t *prev, linkedlist_node_t *node) {
+    if (prev) {
+        node_insert(prev, node);
+    } else {
+        node->prev = NULL;
+        node->next = list->head;
+
+        if (list->head) {
+            list->head->prev = node;
+        }
+
+        list->head = node;
+    }
+
+    if (prev == list->tail) {
+        list->tail = node;
+    }
+
+    list->header.length++;
+}
+
+/**
+ * @brief Unlinks a node from the list without freeing it
+ * 
+ * @param list 
+ * @param node 
+ */
+static void list_unlink(linkedlist_t *list, linkedlist_node_t *node) {
+    if (node == list->head) {
+        list->head = node->next;
+    }
+
+    if (node == list->tail) {
+        list->tail = node->prev;
+    }
+
+    node_detach(node);
+    list->header.length--;
+}
+
+/**
+ * @brief Forgets the cached finger, after a mutation that moves nodes
+ * 
+ * @param list 
+ */
+static void finger_reset(linkedlist_t *list) {
+    list->finger = NULL;
+    list->finger_index = 0;
+}
+
+/**
+ * @brief Finds the node at an index, walking from the head, the tail or the
+ * finger, whichever is closest, and moves the finger there
+ * 
+ * @param list 
+ * @param index 
+ * @return linkedlist_node_t* The node, or NULL if the index is out of range
+ */
+static linkedlist_node_t *node_at(linkedlist_t *list, size_t index) {
+    size_t length = list->header.length;
+
+    if (index >= length) {
+        return NULL;
+    }
+
+    linkedlist_node_t *node = list->head;
+    size_t position = 0;
+    size_t distance = index;
+
+    if (length - 1 - index < distance) {
+        node = list->tail;
+        position = length - 1;
+        distance = length - 1 - index;
+    }
+
+    if (list->finger) {
+        size_t from_finger = index > list->finger_index
+            ? index - list->finger_index
+            : list->finger_index - index;
+
+        if (from_finger < distance) {
+            node = list->finger;
+            position = list->finger_index;
+        }
+    }
+
+    for (; position < index; position++) {
+        node = node->next;
+    }
+
+    for (; position > index; position--) {
+        node = node->prev;
+    }
+
+    list->finger = node;
+    list->finger_index = index;
+
+    return node;
+}
+
+/**
+ * @brief A chain of nodes built before it is attached to a list
+ * 
+ */
+struct chain {
+    linkedlist_node_t *first;
+    linkedlist_node_t *last;
+    size_t length;
+};
+
+/**
+ * @brief Copies an item into a new node at the end of a chain
+ * 
+ * @param chain 
+ * @param list The list the chain is for
+ * @param item 
+ * @return int 0 if successful, 1 otherwise
+ */
+static int chain_push(struct chain *chain, linkedlist_t *list, const void *item) {
+    linkedlist_node_t *node = node_create(list, item);
+
+    if (!node) {
+        return 1;
+    }
+
+    node->prev = chain->last;
+
+    if (chain->last) {
+        chain->last->next = node;
+    } else {
+        chain->first = node;
+    }
+
+    chain->last = node;
+    chain->length++;
+
+    return 0;
+}
+
+/**
+ * @brief Frees every node of a chain that was not attached
+ * 
+ * @param chain 
+ * @param list The list the chain is for
+ */
+static void chain_destroy(struct chain *chain, linkedlist_t *list) {
+    nodes_destroy(list, chain->first);
+}
+
+/**
+ * @brief Attaches a chain to the end of the list in O(1)
+ * 
+ * @param list 
+ * @param chain 
+ */
+static void chain_attach_tail(linkedlist_t *list, struct chain *chain) {
+    if (!chain->first) {
+        return;
+    }
+
+    chain->first->prev = list->tail;
+
+    if (list->tail) {
+        list->tail->next = chain->first;
+    } else {
+        list->head = chain->first;
+    }
+
+    list->tail = chain->last;
+    list->header.length += chain->length;
+}
+
+
+/**
+ * @brief Cuts a chain after its first `n` nodes
+ * @note Only `next` links are followed; `prev` links are fixed up later
+ * 
+ * @param node First node of the chain, or NULL
+ * @param n Number of nodes to keep, at least 1
+ * @return linkedlist_node_t* The first node after the cut, or NULL
+ */
+static linkedlist_node_t *chain_cut(linkedlist_node_t *node, size_t n) {
+    for (size_t i = 1; node && i < n; i++) {
+        node = node->next;
+    }
+
+    if (!node) {
+        return NULL;
+    }
+
+    linkedlist_node_t *rest = node->next;
+    node->next = NULL;
+
+    return rest;
+}
+
+/**
+ * @brief Merges two sorted chains by relinking their `next` links
+ * @note Ties are taken from `a` first, which keeps the merge stable
+ * 
+ * @param a 
+ * @param b 
+ * @param compare 
+ * @param last Set to the last node of the merged chain
+ * @return linkedlist_node_t* The first node of the merged chain
+ */
+static linkedlist_node_t *chain_merge(
+    linkedlist_node_t *a,
+    linkedlist_node_t *b,
+    int (*compare)(const void *, const void *),
+    linkedlist_node_t **last
+) {
+    linkedlist_node_t head;
+    linkedlist_node_t *tail = &head;
+
+    while (a && b) {
+        if (compare(linkedlist_node_data(a), linkedlist_node_data(b)) <= 0) {
+            tail->next = a;
+            a = a->next;
+        } else {
+            tail->next = b;
+            b = b->next;
+        }
+
+        tail = tail->next;
+    }
+
+    tail->next = a ? a : b;
+
+    while (tail->next) {
+        tail = tail->next;
+    }
+
+    *last = tail;
+
+    return head.next;
+}
+
+/**
+ * @brief Restores the `prev` links and `tail` of a list after its `next`
+ * links were rearranged
+ * 
+ * @param list 
+ */
+static void relink_prev(linkedlist_t *list) {
+    linkedlist_node_t *prev = NULL;
+
+    for (linkedlist_node_t *node = list->head; node; node = node->next) {
+        node->prev = prev;
+        prev = node;
+    }
+
+    list->tail = prev;
+}
+
 
 // +---------------------------------------------------------------------------+
 // |                           Public Functions                                |
@@ -88,26 +374,112 @@ int linkedlist_init(linkedlist_t *list, size_t item_size) {
     list->tail = NULL;
     list->header.length = 0;
     list->header.item_size = item_size;
+    list->pool = NULL;
+    list->owns_pool = 0;
+    list->spare = NULL;
+    list->n_spare = 0;
+    finger_reset(list);
+
+    return 0;
+}
+
+
+// --------------------
+int linkedlist_init_pooled(linkedlist_t *list, size_t item_size) {
+    nodepool_t *pool = (nodepool_t *) malloc(sizeof(nodepool_t));
+
+    if (!pool) {
+        return 1;
+    }
+
+    if (nodepool_init(pool, linkedlist_node_size(item_size)) != 0) {
+        free(pool);
+        return 1;
+    }
+
+    linkedlist_init(list, item_size);
+    list->pool = pool;
+    list->owns_pool = 1;
+
+    return 0;
+}
+
+
+// --------------------
+int linkedlist_init_with_pool(linkedlist_t *list, size_t item_size, nodepool_t *pool) {
+    if (nodepool_node_size(pool) < linkedlist_node_size(item_size)) {
+        return 1;
+    }
+
+    linkedlist_init(list, item_size);
+    list->pool = pool;
 
     return 0;
 }
 
 
+// --------------------
+size_t linkedlist_node_size(size_t item_size) {
+    return sizeof(linkedlist_node_t) + item_size;
+}
+
+
+// --------------------
+nodepool_t *linkedlist_pool(linkedlist_t *list) {
+    return list->pool;
+}
+
+
 // --------------------
 void linkedlist_destroy(linkedlist_t *list) {
-    linkedlist_node_t *current = list->head;
-    linkedlist_node_t *next;
+    if (list->owns_pool) {
+        // Every node lives in the list's own slabs, so free those instead
+        nodepool_destroy(list->pool);
+        free(list->pool);
+        list->pool = NULL;
+        list->owns_pool = 0;
+    } else {
+        // Free each node in the list, and each kept for reuse
+        nodes_destroy(list, list->head);
+        nodes_destroy(list, list->spare);
+    }
+
+    list->head = NULL;
+    list->tail = NULL;
+    list->header.length = 0;
+    list->spare = NULL;
+    list->n_spare = 0;
+    finger_reset(list);
+}
+
 
-    // Free each node in the list
-    while (current) {
-        next = current->next;
-        node_destroy(current);
-        current = next;
+// --------------------
+void linkedlist_clear(linkedlist_t *list) {
+    if (list->head) {
+        // Only the ends of the chain are touched, so clearing is O(1)
+        list->tail->next = list->spare;
+        list->spare = list->head;
+        list->n_spare += list->header.length;
     }
 
     list->head = NULL;
     list->tail = NULL;
     list->header.length = 0;
+    finger_reset(list);
+}
+
+
+// --------------------
+size_t linkedlist_spare(linkedlist_t *list) {
+    return list->n_spare;
+}
+
+
+// --------------------
+void linkedlist_shrink(linkedlist_t *list) {
+    nodes_destroy(list, list->spare);
+    list->spare = NULL;
+    list->n_spare = 0;
 }
 
 size_t linkedlist_length(linkedlist_t *list) {
@@ -130,37 +502,29 @@ int linkedlist_insert(linkedlist_t *list, size_t index, const void *item) {
         return 1;
     }
 
-    linkedlist_node_t *node = node_create(list->header.item_size, item);
+    linkedlist_node_t *node = node_create(list, item);
 
     if (!node) {
         return 1;
     }
 
-    if (index == 0) {
-        node->next = list->head;
-        
-        if (list->head) {
-            list->head->prev = node;
-        }
+    linkedlist_node_t *prev;
 
-        list->head = node;
+    if (index == 0) {
+        prev = NULL;
+    } else if (index == list->header.length) {
+        // The tail is tracked, so appending needs no traversal
+        prev = list->tail;
     } else {
-        linkedlist_node_t *current = list->head;
-
-        // Traverse to the node at the given index
-        for (size_t i = 0; i < index - 1; i++) {
-            current = current->next;
-        }
-
-        // insert the new node after the current node
-        node_insert(current, node);
+        prev = node_at(list, index - 1);
     }
 
-    if (index == list->header.length) {
-        list->tail = node;
-    }
+    list_link_after(list, prev, node);
 
-    list->header.length++;
+    // The finger's node moved up one place
+    if (list->finger && list->finger_index >= index) {
+        list->finger_index++;
+    }
 
     return 0;
 }
@@ -171,29 +535,21 @@ int linkedlist_remove(linkedlist_t *list, size_t index, void *item) {
         return 1;
     }
 
-    linkedlist_node_t *current = list->head;
+    linkedlist_node_t *current = node_at(list, index);
 
-    // Traverse to the node at the given index
-    for (size_t i = 0; i < index; i++) {
-        current = current->next;
+    // Keep the finger at the same index, now held by the next node
+    if (list->finger == current) {
+        list->finger = current->next;
+    } else if (list->finger && list->finger_index > index) {
+        list->finger_index--;
     }
 
     if (item) {
-        memcpy(item, current->data, list->header.item_size);
+        memcpy(item, linkedlist_node_data(current), list->header.item_size);
     }
 
-    if (current == list->head) {
-        list->head = current->next;
-    }
-
-    if (current == list->tail) {
-        list->tail = current->prev;
-    }
-
-    node_detach(current);
-    node_destroy(current);
-
-    list->header.length--;
+    list_unlink(list, current);
+    node_destroy(list, current);
 
     return 0;
 }
@@ -214,37 +570,45 @@ int linkedlist_get(linkedlist_t *list, size_t index, void *item) {
         return 1;
     }
 
-    linkedlist_node_t *current = list->head;
+    linkedlist_node_t *current = node_at(list, index);
 
-    // Traverse to the node at the given index
-    for (size_t i = 0; i < index; i++) {
-        current = current->next;
-    }
-
-    memcpy(item, current->data, list->header.item_size);
+    memcpy(item, linkedlist_node_data(current), list->header.item_size);
 
     return 0;
 }
 
 // --------------------
-int linkedlist_from_raw(linkedlist_t *list, size_t item_size, size_t length, const void *raw) {
-    linkedlist_init(list, item_size);
-
+int linkedlist_extend(linkedlist_t *list, size_t length, const void *raw) {
+    struct chain chain = {NULL, NULL, 0};
     const char *raw_ptr = (const char *) raw;
+    size_t item_size = list->header.item_size;
 
+    // Build the nodes off to the side so a failure leaves the list unchanged
     for (size_t i = 0; i < length; i++) {
-        linkedlist_append(list, raw_ptr + i * item_size);
+        if (chain_push(&chain, list, raw_ptr + i * item_size) != 0) {
+            chain_destroy(&chain, list);
+            return 1;
+        }
     }
 
+    chain_attach_tail(list, &chain);
+
     return 0;
 }
 
+// --------------------
+int linkedlist_from_raw(linkedlist_t *list, size_t item_size, size_t length, const void *raw) {
+    linkedlist_init(list, item_size);
+
+    return linkedlist_extend(list, length, raw);
+}
+
 int linkedlist_head(linkedlist_t *list, void *item) {
     if (!list->head) {
         return 1;
     }
 
-    memcpy(item, list->head->data, list->header.item_size);
+    memcpy(item, linkedlist_node_data(list->head), list->header.item_size);
 
     return 0;
 }
@@ -254,44 +618,118 @@ int linkedlist_tail(linkedlist_t *list, void *item) {
         return 1;
     }
 
-    memcpy(item, list->tail->data, list->header.item_size);
+    memcpy(item, linkedlist_node_data(list->tail), list->header.item_size);
 
     return 0;
 }
 
 // --------------------
 void linkedlist_sort(linkedlist_t *list, int (*compare)(const void *, const void *)) {
-    linkedlist_node_t *current = list->head;
-    linkedlist_node_t *next;
+    size_t length = list->header.length;
+
+    // Bottom-up: merge adjacent runs of `width` nodes, doubling the width
+    // each pass, so no recursion or buffer is needed
+    for (size_t width = 1; width < length; width *= 2) {
+        linkedlist_node_t *rest = list->head;
+        linkedlist_node_t head;
+        linkedlist_node_t *tail = &head;
+
+        while (rest) {
+            linkedlist_node_t *a = rest;
+            linkedlist_node_t *b = chain_cut(a, width);
+            rest = chain_cut(b, width);
+
+            linkedlist_node_t *last;
+            tail->next = chain_merge(a, b, compare, &last);
+            tail = last;
+        }
 
-    while (current) {
-        next = current->next;
+        list->head = head.next;
+    }
 
-        while (next) {
-            if (compare(current->data, next->data) > 0) {
-                void *temp = current->data;
-                current->data = next->data;
-                next->data = temp;
-            }
+    relink_prev(list);
+    finger_reset(list);
+}
 
-            next = next->next;
-        }
+// --------------------
+int linkedlist_merge(
+    linkedlist_t *dest,
+    linkedlist_t *src,
+    int (*compare)(const void *, const void *)
+) {
+    if (dest == src || dest->pool != src->pool || src->owns_pool
+        || dest->header.item_size != src->header.item_size) {
+        return 1;
+    }
+
+    linkedlist_node_t *last;
+
+    dest->head = chain_merge(dest->head, src->head, compare, &last);
+    dest->header.length += src->header.length;
+    relink_prev(dest);
+    finger_reset(dest);
+
+    src->head = NULL;
+    src->tail = NULL;
+    src->header.length = 0;
+    finger_reset(src);
+
+    return 0;
+}
+
+// --------------------
+int linkedlist_split(linkedlist_t *list, size_t index, linkedlist_t *rest) {
+    if (index > list->header.length) {
+        return 1;
+    }
+
+    linkedlist_init(rest, list->header.item_size);
+    rest->pool = list->pool;
+
+    if (index == list->header.length) {
+        return 0;
+    }
+
+    linkedlist_node_t *first = node_at(list, index);
+
+    rest->head = first;
+    rest->tail = list->tail;
+    rest->header.length = list->header.length - index;
+
+    list->tail = first->prev;
+    list->header.length = index;
 
-        current = current->next;
+    if (list->finger_index >= index) {
+        finger_reset(list);
     }
+
+    if (list->tail) {
+        list->tail->next = NULL;
+    } else {
+        list->head = NULL;
+    }
+
+    first->prev = NULL;
+
+    return 0;
 }
 
 // --------------------
 int linkedlist_copy(linkedlist_t *dest, linkedlist_t *src) {
-    linkedlist_init(dest, src->header.item_size);
+    struct chain chain = {NULL, NULL, 0};
+    size_t item_size = src->header.item_size;
 
-    linkedlist_node_t *current = src->head;
+    linkedlist_init(dest, item_size);
 
-    while (current) {
-        linkedlist_append(dest, current->data);
-        current = current->next;
+    for (linkedlist_node_t *current = src->head; current; current = current->next) {
+        if (chain_push(&chain, dest, linkedlist_node_data(current)) != 0) {
+            chain_destroy(&chain, dest);
+            return 1;
+        }
     }
 
+    chain_attach_tail(dest, &chain);
+
     return 0;
 }
 
@@ -308,14 +746,10 @@ int linkedlist_iter_init(
 
     size_t start_idx = start < 0 ? (int)list->header.length + start : start;
 
-    // Find the node at the start index
-    linkedlist_node_t *current = list->head;
-
-    for (size_t i = 0; i < start_idx; i++) {
-        current = current->next;
-    }
-
-    iterator->next = current;
+    // Find the node at the start index, NULL if it is the end
+    iterator->next = node_at(list, start_idx);
+    iterator->current = NULL;
+    iterator->list = list;
     iterator->reverse = reverse;
     iterator->item_size = list->header.item_size;
 
@@ -324,17 +758,146 @@ int linkedlist_iter_init(
 
 // --------------------
 int linkedlist_iter_next(linkedlist_iterator_t *iterator, void *item) {
-    if (!iterator->next) {
+    void *data = linkedlist_iter_next_ptr(iterator);
+
+    if (!data) {
         return 1;
     }
 
-    memcpy(item, iterator->next->data, iterator->item_size);
+    memcpy(item, data, iterator->item_size);
+
+    return 0;
+}
+
+// --------------------
+void *linkedlist_iter_next_ptr(linkedlist_iterator_t *iterator) {
+    linkedlist_node_t *node = iterator->next;
+
+    iterator->current = node;
+
+    if (!node) {
+        return NULL;
+    }
+
+    iterator->next = iterator->reverse ? node->prev : node->next;
+
+    return linkedlist_node_data(node);
+}
+
+// --------------------
+linkedlist_node_t *linkedlist_iter_node(linkedlist_iterator_t *iterator) {
+    return iterator->current;
+}
+
+// --------------------
+int linkedlist_erase_at(linkedlist_iterator_t *iterator) {
+    linkedlist_t *list = iterator->list;
+    linkedlist_node_t *node = iterator->current;
+
+    if (!node) {
+        return 1;
+    }
+
+    // The iterator already points past the node, so it stays valid
+    list_unlink(list, node);
+    node_destroy(list, node);
+    finger_reset(list);
+    iterator->current = NULL;
+
+    return 0;
+}
+
+// --------------------
+int linkedlist_insert_before(linkedlist_iterator_t *iterator, const void *item) {
+    linkedlist_t *list = iterator->list;
+
+    if (!iterator->current) {
+        return 1;
+    }
 
-    if (iterator->reverse) {
-        iterator->next = iterator->next->prev;
+    linkedlist_node_t *node = node_create(list, item);
+
+    if (!node) {
+        return 1;
+    }
+
+    list_link_after(list, iterator->current->prev, node);
+    finger_reset(list);
+
+    return 0;
+}
+
+// --------------------
+int linkedlist_insert_after(linkedlist_iterator_t *iterator, const void *item) {
+    linkedlist_t *list = iterator->list;
+
+    if (!iterator->current) {
+        return 1;
+    }
+
+    linkedlist_node_t *node = node_create(list, item);
+
+    if (!node) {
+        return 1;
+    }
+
+    list_link_after(list, iterator->current, node);
+    finger_reset(list);
+
+    return 0;
+}
+
+// --------------------
+int linkedlist_splice(
+    linkedlist_t *dest,
+    linkedlist_node_t *pos,
+    linkedlist_t *src,
+    linkedlist_node_t *first,
+    linkedlist_node_t *last,
+    size_t count
+) {
+    if (dest->header.item_size != src->header.item_size || dest->pool != src->pool
+        || (dest != src && src->owns_pool) || !first || !last || count == 0) {
+        return 1;
+    }
+
+    // Cut the range out of the source
+    if (first->prev) {
+        first->prev->next = last->next;
     } else {
-        iterator->next = iterator->next->next;
+        src->head = last->next;
     }
 
+    if (last->next) {
+        last->next->prev = first->prev;
+    } else {
+        src->tail = first->prev;
+    }
+
+    src->header.length -= count;
+
+    // Link it in after `pos`
+    linkedlist_node_t *next = pos ? pos->next : dest->head;
+
+    first->prev = pos;
+    last->next = next;
+
+    if (pos) {
+        pos->next = first;
+    } else {
+        dest->head = first;
+    }
+
+    if (next) {
+        next->prev = last;
+    } else {
+        dest->tail = last;
+    }
+
+    dest->header.length += count;
+
+    finger_reset(src);
+    finger_reset(dest);
+
     return 0;
 }
\ No newline at end of file
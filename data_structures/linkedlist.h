@@ -1,20 +1,22 @@
 #ifndef LINKEDLIST_H
 #define LINKEDLIST_H
 
+#include "nodepool.h"
+
 #include <stdlib.h>
 #include <string.h>
 
 // -------------------- Types
 /**
  * @brief A node in a doubly linked list
+ * @note The item is stored inline, directly after the node, so each node
+ * is a single allocation. Use `linkedlist_node_data` to access it.
  * 
- * @param data Pointer to the data stored in the node
  * @param next Pointer to the next node in the list
  * @param prev Pointer to the previous node in the list
  * 
  */
 typedef struct linkedlist_node {
-    void *data;
     struct linkedlist_node *next;
     struct linkedlist_node *prev;
 } linkedlist_node_t;
@@ -37,27 +39,53 @@ typedef struct linkedlist_header {
  * @param head Pointer to the first node in the list
  * @param tail Pointer to the last node in the list
  * @param header Header for the list
+ * @param pool Pool the nodes are allocated from, or NULL to use `malloc`
+ * @param owns_pool Flag to indicate if the pool is destroyed with the list
+ * @param finger The node last found by index, or NULL
+ * @param finger_index The index of `finger`
+ * @param spare Nodes kept by `linkedlist_clear` for reuse, linked by `next`
+ * @param n_spare Number of nodes in `spare`
  * 
  */
 typedef struct linkedlist {
     linkedlist_node_t *head;
     linkedlist_node_t *tail;
     linkedlist_header_t header;
+    nodepool_t *pool;
+    int owns_pool;
+    linkedlist_node_t *finger;
+    size_t finger_index;
+    linkedlist_node_t *spare;
+    size_t n_spare;
 } linkedlist_t;
 
 /**
  * @brief An iterator for a linked list
  * 
  * @param next Pointer to the next node in the list
+ * @param current Pointer to the node last returned, or NULL
+ * @param list The list being iterated
  * @param reverse Flag to indicate if the iterator is in reverse
  * 
  */
 typedef struct linkedlist_iterator {
     linkedlist_node_t *next;
+    linkedlist_node_t *current;
+    struct linkedlist *list;
     int reverse;
     size_t item_size;
 } linkedlist_iterator_t;
 
+// -------------------- Macros
+
+/**
+ * @brief Get a pointer to the item stored in a node
+ * 
+ * @param node A pointer to the node
+ * @return void* Pointer to the item
+ */
+#define linkedlist_node_data(node) ((void *) ((linkedlist_node_t *) (node) + 1))
+
 
 /**
  * @brief Initialise a linked list
@@ -68,13 +96,78 @@ typedef struct linkedlist_iterator {
  */
 int linkedlist_init(linkedlist_t *list, size_t item_size);
 
+/**
+ * @brief Initialise a linked list whose nodes come from its own pool
+ * @note Freed nodes are recycled by later inserts, and destroying the list
+ * frees the pool's slabs at once instead of each node
+ * 
+ * @param list A pointer to the linked list object
+ * @param item_size The size of an item in the list
+ * @return int 0 if successful, 1 otherwise
+ */
+int linkedlist_init_pooled(linkedlist_t *list, size_t item_size);
+
+/**
+ * @brief Initialise a linked list whose nodes come from a shared pool
+ * @note The pool must outlive the list. Destroying the list returns its
+ * nodes to the pool.
+ * 
+ * @param list A pointer to the linked list object
+ * @param item_size The size of an item in the list
+ * @param pool A pool of nodes of `linkedlist_node_size(item_size)` bytes
+ * @return int 0 if successful, 1 if the pool's nodes are the wrong size
+ */
+int linkedlist_init_with_pool(linkedlist_t *list, size_t item_size, nodepool_t *pool);
+
+/**
+ * @brief Get the size of a node holding an item, for creating a pool
+ * 
+ * @param item_size The size of an item in the list
+ * @return size_t The size of a node in bytes
+ */
+size_t linkedlist_node_size(size_t item_size);
+
+/**
+ * @brief Get the pool the list's nodes come from
+ * @note Use it to read the pool's counters or to trim idle slabs
+ * 
+ * @param list A pointer to the linked list object
+ * @return nodepool_t* The pool, or NULL if nodes are allocated with `malloc`
+ */
+nodepool_t *linkedlist_pool(linkedlist_t *list);
+
 /**
  * @brief Destroy a linked list
+ * @note A list with its own pool frees the pool's slabs rather than each
+ * node
  * 
  * @param list A pointer to the linked list object
  */
 void linkedlist_destroy(linkedlist_t *list);
 
+/**
+ * @brief Remove every item in O(1), keeping the nodes for later inserts
+ * @note The nodes are freed by `linkedlist_shrink` or `linkedlist_destroy`
+ * 
+ * @param list A pointer to the linked list object
+ */
+void linkedlist_clear(linkedlist_t *list);
+
+/**
+ * @brief Get the number of nodes kept for reuse by `linkedlist_clear`
+ * 
+ * @param list A pointer to the linked list object
+ * @return size_t
+ */
+size_t linkedlist_spare(linkedlist_t *list);
+
+/**
+ * @brief Free the nodes kept for reuse by `linkedlist_clear`
+ * 
+ * @param list A pointer to the linked list object
+ */
+void linkedlist_shrink(linkedlist_t *list);
+
 /**
  * @brief Get the length of the list
  * 
@@ -101,7 +194,9 @@ size_t linkedlist_item_size(linkedlist_t *list);
 
 /**
  * @brief Insert an item at the given index
- * @note If the index is invalid, the item is not inserted
+ * @note If the index is invalid, the item is not inserted. Like every
+ * indexed operation, it walks from the head, the tail or the last index
+ * used, whichever is closest, so accessing nearby indices in turn is cheap.
  * 
  * @param list A pointer to the linked list object
  * @param index The index to insert the item
@@ -125,7 +220,7 @@ int linkedlist_insert(
 int linkedlist_remove(linkedlist_t *list, size_t index, void *item);
 
 /**
- * @brief Append an item to the end of the list
+ * @brief Append an item to the end of the list in O(1)
  * @note A copy of the item is stored in the list
  * 
  * @param list A pointer to the linked list object
@@ -182,6 +277,8 @@ int linkedlist_copy(linkedlist_t *dest, linkedlist_t *src);
 
 /**
  * @brief Sort the list in place
+ * @note A stable bottom-up merge sort that relinks the nodes, so it takes
+ * O(n log n) comparisons, O(1) extra memory and never copies items
  * 
  * @param list A pointer to the linked list object
  * @param compare A function to compare two items
@@ -191,6 +288,47 @@ void linkedlist_sort(
     int (*compare)(const void *, const void *)
 );
 
+/**
+ * @brief Merge a sorted list into another sorted list in O(n + m)
+ * @note The nodes of `src` are moved, not copied, and `src` is left empty.
+ * Equal items of `dest` come before those of `src`.
+ * 
+ * @param dest A pointer to the sorted list to merge into
+ * @param src A pointer to the sorted list to merge from
+ * @param compare A function to compare two items
+ * @return int 0 if successful, 1 if the lists are the same, have different
+ * item sizes or do not share the same pool, or `src` owns its pool
+ */
+int linkedlist_merge(
+    linkedlist_t *dest,
+    linkedlist_t *src,
+    int (*compare)(const void *, const void *)
+);
+
+/**
+ * @brief Move the items from an index onwards into a new list
+ * @note `rest` allocates from the same pool as `list` without owning it,
+ * so if `list` owns its pool, `rest` must be destroyed first
+ * 
+ * @param list A pointer to the linked list object
+ * @param index The index of the first item to move
+ * @param rest A pointer to an uninitialised list to move the items to
+ * @return int 0 if successful, 1 if the index is invalid
+ */
+int linkedlist_split(linkedlist_t *list, size_t index, linkedlist_t *rest);
+
+
+/**
+ * @brief Append every item of a raw array to the end of the list
+ * @note The nodes are built in a single pass and attached at once. If
+ * memory runs out, the list is unchanged.
+ * 
+ * @param list A pointer to the linked list object
+ * @param length The length of the raw array
+ * @param raw A pointer to the raw array, of the list's item size
+ * @return int 0 if successful, 1 otherwise
+ */
+int linkedlist_extend(linkedlist_t *list, size_t length, const void *raw);
 
 /**
  * @brief Create a linked list from a raw array
@@ -233,4 +371,81 @@ int linkedlist_iter_init(
  */
 int linkedlist_iter_next(linkedlist_iterator_t *iterator, void *item);
 
+/**
+ * @brief Get a pointer to the next item from the iterator, without copying
+ * @note The item can be modified in place. The pointer stays valid until
+ * its node is removed.
+ * 
+ * @param iterator A pointer to the iterator object
+ * @return void* Pointer to the item in its node, or NULL if the end of the
+ * list is reached
+ */
+void *linkedlist_iter_next_ptr(linkedlist_iterator_t *iterator);
+
+/**
+ * @brief Get the node of the item last returned by the iterator
+ * @note Use it as a handle for `linkedlist_splice`
+ * 
+ * @param iterator A pointer to the iterator object
+ * @return linkedlist_node_t* The node, or NULL if there is none
+ */
+linkedlist_node_t *linkedlist_iter_node(linkedlist_iterator_t *iterator);
+
+/**
+ * @brief Remove the item last returned by the iterator in O(1)
+ * @note The iterator stays valid and continues with the following item,
+ * so a list can be filtered in one pass
+ * 
+ * @param iterator A pointer to the iterator object
+ * @return int 0 if successful, 1 if no item was returned since the
+ * iterator was created or the item was already erased
+ */
+int linkedlist_erase_at(linkedlist_iterator_t *iterator);
+
+/**
+ * @brief Insert an item before the item last returned by the iterator
+ * @note "Before" is towards the head, whatever the iterator's direction.
+ * The iterator does not visit the new item.
+ * 
+ * @param iterator A pointer to the iterator object
+ * @param item A pointer to the item to insert
+ * @return int 0 if successful, 1 otherwise
+ */
+int linkedlist_insert_before(linkedlist_iterator_t *iterator, const void *item);
+
+/**
+ * @brief Insert an item after the item last returned by the iterator
+ * @note "After" is towards the tail, whatever the iterator's direction.
+ * The iterator does not visit the new item.
+ * 
+ * @param iterator A pointer to the iterator object
+ * @param item A pointer to the item to insert
+ * @return int 0 if successful, 1 otherwise
+ */
+int linkedlist_insert_after(linkedlist_iterator_t *iterator, const void *item);
+
+/**
+ * @brief Move a range of nodes from one list to another in O(1)
+ * @note The nodes are relinked, not copied, so pointers to their items
+ * stay valid. `count` is trusted, since checking it would take a walk.
+ * 
+ * @param dest A pointer to the list to move the nodes to
+ * @param pos The node of `dest` to insert after, or NULL for the front.
+ * It must not be in the range.
+ * @param src A pointer to the list holding the range, which may be `dest`
+ * @param first The first node of the range
+ * @param last The last node of the range, at or after `first`
+ * @param count The number of nodes from `first` to `last` inclusive
+ * @return int 0 if successful, 1 if the lists have different item sizes or
+ * pools, `src` owns its pool and is not `dest`, or the range is empty
+ */
+int linkedlist_splice(
+    linkedlist_t *dest,
+    linkedlist_node_t *pos,
+    linkedlist_t *src,
+    linkedlist_node_t *first,
+    linkedlist_node_t *last,
+    size_t count
+);
+
 #endif // LINKEDLIST_H
\ No newline at end of file
@@ -0,0 +1,215 @@
+#include "linkedlist_parallel.h"
+
+// Pieces shorter than this are not worth a thread
+#define MIN_PIECE_LENGTH 4096
+
+/**
+ * @brief State of a parallel sort
+ *
+ * @param list The list being sorted, which holds the first piece
+ * @param pieces The other pieces, split off the list
+ * @param n_pieces Number of pieces, including the list
+ * @param stride Distance between the pieces merged in the current round
+ * @param compare
+ */
+struct sort_job {
+    linkedlist_t *list;
+    linkedlist_t *pieces;
+    size_t n_pieces;
+    size_t stride;
+    int (*compare)(const void *, const void *);
+};
+
+/**
+ * @brief A list handed to the reclaimer thread
+ *
+ * @param next The next list queued
+ * @param list The list to destroy, moved out of the caller's object
+ */
+struct reclaim_job {
+    struct reclaim_job *next;
+    linkedlist_t list;
+};
+
+// Lists waiting for the reclaimer thread, and whether it is destroying one
+static pthread_mutex_t reclaim_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t reclaim_queued = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t reclaim_idle = PTHREAD_COND_INITIALIZER;
+static pthread_once_t reclaim_once = PTHREAD_ONCE_INIT;
+static struct reclaim_job *reclaim_queue = NULL;
+static int reclaim_busy = 0;
+static int reclaim_started = 0;
+
+
+// +---------------------------------------------------------------------------+
+// |                           Static Functions                                |
+// +---------------------------------------------------------------------------+
+
+static linkedlist_t *piece(struct sort_job *job, size_t index) {
+    return index == 0 ? job->list : &job->pieces[index - 1];
+}
+
+static void sort_task(void *ctx, size_t index) {
+    struct sort_job *job = (struct sort_job *) ctx;
+
+    linkedlist_sort(piece(job, index), job->compare);
+}
+
+static void merge_task(void *ctx, size_t index) {
+    struct sort_job *job = (struct sort_job *) ctx;
+    size_t left = index * 2 * job->stride;
+
+    // Merging right into left keeps equal items in their original order
+    linkedlist_merge(piece(job, left), piece(job, left + job->stride), job->compare);
+}
+
+/**
+ * @brief Destroys queued lists until the process exits
+ *
+ * @param arg Unused
+ * @return void*
+ */
+static void *reclaim_worker(void *arg) {
+    (void) arg;
+
+    pthread_mutex_lock(&reclaim_lock);
+
+    for (;;) {
+        while (!reclaim_queue) {
+            pthread_cond_wait(&reclaim_queued, &reclaim_lock);
+        }
+
+        // Take the whole queue, so callers are not held up while it is freed
+        struct reclaim_job *job = reclaim_queue;
+        reclaim_queue = NULL;
+        reclaim_busy = 1;
+        pthread_mutex_unlock(&reclaim_lock);
+
+        while (job) {
+            struct reclaim_job *next = job->next;
+            linkedlist_destroy(&job->list);
+            free(job);
+            job = next;
+        }
+
+        pthread_mutex_lock(&reclaim_lock);
+        reclaim_busy = 0;
+
+        if (!reclaim_queue) {
+            pthread_cond_broadcast(&reclaim_idle);
+        }
+    }
+
+    return NULL;
+}
+
+static void reclaim_start(void) {
+    pthread_t thread;
+
+    if (pthread_create(&thread, NULL, reclaim_worker, NULL) == 0) {
+        pthread_detach(thread);
+        reclaim_started = 1;
+    }
+}
+
+
+// +---------------------------------------------------------------------------+
+// |                           Public Functions                                |
+// +---------------------------------------------------------------------------+
+
+
+// --------------------
+int linkedlist_sort_parallel(
+    linkedlist_t *list,
+    int (*compare)(const void *, const void *),
+    threadpool_t *pool
+) {
+    pool = pool ? pool : threadpool_shared();
+
+    size_t length = linkedlist_length(list);
+    size_t n_pieces = threadpool_size(pool) + 1;
+
+    if (n_pieces > length / MIN_PIECE_LENGTH) {
+        n_pieces = length / MIN_PIECE_LENGTH;
+    }
+
+    if (n_pieces <= 1) {
+        linkedlist_sort(list, compare);
+        return 0;
+    }
+
+    struct sort_job job;
+    job.list = list;
+    job.pieces = (linkedlist_t *) malloc((n_pieces - 1) * sizeof(linkedlist_t));
+    job.n_pieces = n_pieces;
+    job.compare = compare;
+
+    if (!job.pieces) {
+        return 1;
+    }
+
+    // Each split walks only the piece it keeps, so splitting is O(n)
+    for (size_t i = 0; i + 1 < n_pieces; i++) {
+        size_t keep = length / n_pieces + (i < length % n_pieces);
+
+        linkedlist_split(piece(&job, i), keep, &job.pieces[i]);
+    }
+
+    threadpool_run(pool, n_pieces, sort_task, &job);
+
+    for (job.stride = 1; job.stride < n_pieces; job.stride *= 2) {
+        size_t n_merges = (n_pieces - job.stride + 2 * job.stride - 1) / (2 * job.stride);
+
+        threadpool_run(pool, n_merges, merge_task, &job);
+    }
+
+    // Every piece was merged back into the list and is empty
+    free(job.pieces);
+
+    return 0;
+}
+
+
+// --------------------
+void linkedlist_destroy_async(linkedlist_t *list) {
+    size_t item_size = list->header.item_size;
+
+    // Nodes of a shared pool may only be freed by the pool's own thread
+    if (list->pool && !list->owns_pool) {
+        linkedlist_destroy(list);
+        return;
+    }
+
+    pthread_once(&reclaim_once, reclaim_start);
+
+    struct reclaim_job *job = reclaim_started
+        ? (struct reclaim_job *) malloc(sizeof(struct reclaim_job))
+        : NULL;
+
+    if (!job) {
+        linkedlist_destroy(list);
+        return;
+    }
+
+    // The nodes, spare nodes and any owned pool all move with the object
+    job->list = *list;
+    linkedlist_init(list, item_size);
+
+    pthread_mutex_lock(&reclaim_lock);
+    job->next = reclaim_queue;
+    reclaim_queue = job;
+    pthread_cond_signal(&reclaim_queued);
+    pthread_mutex_unlock(&reclaim_lock);
+}
+
+
+// --------------------
+void linkedlist_reclaim_wait(void) {
+    pthread_mutex_lock(&reclaim_lock);
+
+    while (reclaim_queue || reclaim_busy) {
+        pthread_cond_wait(&reclaim_idle, &reclaim_lock);
+    }
+
+    pthread_mutex_unlock(&reclaim_lock);
+}
@@ -0,0 +1,62 @@
+/**
+ * @file linkedlist_parallel.h
+ * @brief Parallel algorithms over linked lists
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * Each function takes the thread pool to run on; pass NULL to use the
+ * shared pool from `threadpool_shared`.
+ *
+ * `linkedlist_destroy_async` instead hands lists to a single background
+ * reclaimer thread, started on first use.
+ *
+ */
+
+#ifndef LINKEDLIST_PARALLEL_H
+#define LINKEDLIST_PARALLEL_H
+
+#include "linkedlist.h"
+#include "../synchronization/threadpool.h"
+
+// +---------------------------------------------------------------------------+
+// |                           Public Interface                                |
+// +---------------------------------------------------------------------------+
+
+/**
+ * @brief Sorts the list in place on several threads
+ * @note The list is split into one piece per thread, the pieces are sorted
+ * with `linkedlist_sort` concurrently, then merged pairwise. The result is
+ * the same stable order as `linkedlist_sort`. Short lists are sorted on the
+ * calling thread.
+ *
+ * @param list A pointer to the linked list object
+ * @param compare A function to compare two items, called concurrently
+ * @param pool The pool to run on, or NULL for the shared pool
+ * @return int 0 if successful, 1 otherwise
+ */
+int linkedlist_sort_parallel(
+    linkedlist_t *list,
+    int (*compare)(const void *, const void *),
+    threadpool_t *pool
+);
+
+/**
+ * @brief Destroys the list on the background reclaimer thread, returning
+ * at once
+ * @note The list is left empty and unpooled, as after `linkedlist_init`.
+ * A list whose nodes come from a shared pool is destroyed on the calling
+ * thread, since the pool is not thread-safe; so is any list if the
+ * reclaimer cannot be started.
+ *
+ * @param list A pointer to the linked list object
+ */
+void linkedlist_destroy_async(linkedlist_t *list);
+
+/**
+ * @brief Waits until every list handed to `linkedlist_destroy_async` has
+ * been freed
+ *
+ */
+void linkedlist_reclaim_wait(void);
+
+#endif // LINKEDLIST_PARALLEL_H
@@ -0,0 +1,226 @@
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE         // posix_memalign
+#endif
+
+#include "nodepool.h"
+
+#include <stdint.h>
+
+// Default size of a slab
+#define SLAB_BYTES (64 * 1024)
+
+// Every slab holds at least this many nodes
+#define MIN_SLAB_NODES 8
+
+// Alignment of every node, enough for any scalar type
+#define NODE_ALIGN 16
+
+/**
+ * @brief Header at the start of each slab
+ * @note Slabs are aligned to their size, so the slab of a node is found by
+ * masking the node's address
+ *
+ * @param link Membership of the pool's partial or full list
+ * @param free First free node, each of which stores the next
+ * @param in_use Number of nodes of the slab in use
+ * @param bump Number of nodes never handed out yet start at this index
+ */
+struct slab {
+    ilist_link_t link;
+    void *free;
+    size_t in_use;
+    size_t bump;
+};
+
+
+// +---------------------------------------------------------------------------+
+// |                           Static Functions                                |
+// +---------------------------------------------------------------------------+
+
+static size_t round_up(size_t size, size_t multiple) {
+    return (size + multiple - 1) / multiple * multiple;
+}
+
+static size_t slab_header_size(void) {
+    return round_up(sizeof(struct slab), NODE_ALIGN);
+}
+
+static char *slab_node(nodepool_t *pool, struct slab *slab, size_t index) {
+    return (char *) slab + slab_header_size() + index * pool->node_size;
+}
+
+static struct slab *slab_of(nodepool_t *pool, void *node) {
+    return (struct slab *) ((uintptr_t) node & ~(uintptr_t) (pool->slab_bytes - 1));
+}
+
+/**
+ * @brief Allocates a new empty slab and adds it to the partial list
+ *
+ * @param pool
+ * @return struct slab* The slab, or NULL if memory could not be allocated
+ */
+static struct slab *slab_create(nodepool_t *pool) {
+    void *memory = NULL;
+
+    if (posix_memalign(&memory, pool->slab_bytes, pool->slab_bytes) != 0) {
+        return NULL;
+    }
+
+    struct slab *slab = (struct slab *) memory;
+    slab->free = NULL;
+    slab->in_use = 0;
+    slab->bump = 0;
+
+    ilist_push_front(&pool->partial, &slab->link);
+    pool->n_slabs++;
+
+    return slab;
+}
+
+static void slab_list_destroy(ilist_t *slabs) {
+    ilist_link_t *link;
+
+    while ((link = ilist_pop_front(slabs))) {
+        free(ilist_entry(link, struct slab, link));
+    }
+}
+
+
+// +---------------------------------------------------------------------------+
+// |                           Public Functions                                |
+// +---------------------------------------------------------------------------+
+
+
+// --------------------
+int nodepool_init(nodepool_t *pool, size_t node_size) {
+    if (node_size == 0) {
+        return 1;
+    }
+
+    // Free nodes hold the free-list pointer
+    if (node_size < sizeof(void *)) {
+        node_size = sizeof(void *);
+    }
+
+    pool->node_size = round_up(node_size, NODE_ALIGN);
+    pool->slab_bytes = SLAB_BYTES;
+
+    // Large nodes get larger slabs, still a power of two for masking
+    while (pool->slab_bytes < slab_header_size() + MIN_SLAB_NODES * pool->node_size) {
+        pool->slab_bytes *= 2;
+    }
+
+    pool->nodes_per_slab = (pool->slab_bytes - slab_header_size()) / pool->node_size;
+    pool->n_slabs = 0;
+    pool->in_use = 0;
+    ilist_init(&pool->partial);
+    ilist_init(&pool->full);
+
+    return 0;
+}
+
+
+// --------------------
+void nodepool_destroy(nodepool_t *pool) {
+    slab_list_destroy(&pool->partial);
+    slab_list_destroy(&pool->full);
+
+    pool->n_slabs = 0;
+    pool->in_use = 0;
+}
+
+
+// --------------------
+void *nodepool_alloc(nodepool_t *pool) {
+    ilist_link_t *link = ilist_first(&pool->partial);
+    struct slab *slab = link ? ilist_entry(link, struct slab, link) : slab_create(pool);
+
+    if (!slab) {
+        return NULL;
+    }
+
+    void *node;
+
+    if (slab->free) {
+        node = slab->free;
+        slab->free = *(void **) node;
+    } else {
+        // Hand out untouched nodes in order rather than threading them all
+        // onto the free list up front
+        node = slab_node(pool, slab, slab->bump++);
+    }
+
+    slab->in_use++;
+    pool->in_use++;
+
+    if (slab->in_use == pool->nodes_per_slab) {
+        ilist_remove(&pool->partial, &slab->link);
+        ilist_push_front(&pool->full, &slab->link);
+    }
+
+    return node;
+}
+
+
+// --------------------
+void nodepool_free(nodepool_t *pool, void *node) {
+    struct slab *slab = slab_of(pool, node);
+
+    if (slab->in_use == pool->nodes_per_slab) {
+        ilist_remove(&pool->full, &slab->link);
+        ilist_push_front(&pool->partial, &slab->link);
+    }
+
+    *(void **) node = slab->free;
+    slab->free = node;
+    slab->in_use--;
+    pool->in_use--;
+}
+
+
+// --------------------
+size_t nodepool_trim(nodepool_t *pool) {
+    size_t freed = 0;
+    ilist_link_t *link = ilist_first(&pool->partial);
+
+    while (link) {
+        ilist_link_t *next = ilist_next(&pool->partial, link);
+        struct slab *slab = ilist_entry(link, struct slab, link);
+
+        if (slab->in_use == 0) {
+            ilist_remove(&pool->partial, link);
+            free(slab);
+            freed++;
+        }
+
+        link = next;
+    }
+
+    pool->n_slabs -= freed;
+
+    return freed;
+}
+
+
+// --------------------
+size_t nodepool_node_size(nodepool_t *pool) {
+    return pool->node_size;
+}
+
+
+// --------------------
+size_t nodepool_slab_count(nodepool_t *pool) {
+    return pool->n_slabs;
+}
+
+
+// --------------------
+size_t nodepool_in_use(nodepool_t *pool) {
+    return pool->in_use;
+}
+
+
+// --------------------
+size_t nodepool_capacity(nodepool_t *pool) {
+    return pool->n_slabs * pool->nodes_per_slab;
+}
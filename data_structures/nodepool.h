@@ -0,0 +1,128 @@
+/**
+ * @file nodepool.h
+ * @brief Fixed-size node allocator built from slabs
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * Nodes are carved out of large slabs, and freed nodes are kept on a free
+ * list in their slab for reuse, so allocating and freeing a node is O(1)
+ * and rarely calls `malloc`. Slabs that hold no live nodes can be returned
+ * to the system with `nodepool_trim`, and `nodepool_destroy` frees every
+ * slab at once.
+ *
+ * A pool is not thread-safe. It may be shared by several lists as long as
+ * they are used from one thread.
+ *
+ */
+
+#ifndef NODEPOOL_H
+#define NODEPOOL_H
+
+#include "ilist.h"
+
+#include <stdlib.h>
+#include <stddef.h>
+
+// -------------------- Types
+
+/**
+ * @brief A node pool object
+ *
+ * @param node_size Size of each node in bytes, rounded up for alignment
+ * @param slab_bytes Size and alignment of each slab, a power of two
+ * @param nodes_per_slab Number of nodes in each slab
+ * @param partial Slabs with at least one free node
+ * @param full Slabs with no free nodes
+ * @param n_slabs Number of slabs allocated
+ * @param in_use Number of nodes handed out and not yet freed
+ *
+ */
+typedef struct nodepool {
+    size_t node_size;
+    size_t slab_bytes;
+    size_t nodes_per_slab;
+    ilist_t partial;
+    ilist_t full;
+    size_t n_slabs;
+    size_t in_use;
+} nodepool_t;
+
+// +---------------------------------------------------------------------------+
+// |                           Public Interface                                |
+// +---------------------------------------------------------------------------+
+
+/**
+ * @brief Initialise an empty pool
+ * @note No memory is allocated until the first node is
+ *
+ * @param pool A pointer to the pool object
+ * @param node_size The size of each node in bytes
+ * @return int 0 if successful, 1 otherwise
+ */
+int nodepool_init(nodepool_t *pool, size_t node_size);
+
+/**
+ * @brief Free every slab of the pool, including nodes still in use
+ *
+ * @param pool A pointer to the pool object
+ */
+void nodepool_destroy(nodepool_t *pool);
+
+/**
+ * @brief Allocate a node
+ *
+ * @param pool A pointer to the pool object
+ * @return void* Pointer to the node, aligned for any type, or NULL if
+ * memory could not be allocated
+ */
+void *nodepool_alloc(nodepool_t *pool);
+
+/**
+ * @brief Return a node to the pool for reuse
+ *
+ * @param pool A pointer to the pool object
+ * @param node A pointer to a node allocated from this pool
+ */
+void nodepool_free(nodepool_t *pool, void *node);
+
+/**
+ * @brief Free every slab that holds no nodes in use
+ *
+ * @param pool A pointer to the pool object
+ * @return size_t The number of slabs freed
+ */
+size_t nodepool_trim(nodepool_t *pool);
+
+/**
+ * @brief Get the size of the nodes in the pool
+ *
+ * @param pool A pointer to the pool object
+ * @return size_t The node size requested in `nodepool_init`, rounded up
+ */
+size_t nodepool_node_size(nodepool_t *pool);
+
+/**
+ * @brief Get the number of slabs allocated
+ *
+ * @param pool A pointer to the pool object
+ * @return size_t
+ */
+size_t nodepool_slab_count(nodepool_t *pool);
+
+/**
+ * @brief Get the number of nodes in use
+ *
+ * @param pool A pointer to the pool object
+ * @return size_t
+ */
+size_t nodepool_in_use(nodepool_t *pool);
+
+/**
+ * @brief Get the number of nodes the allocated slabs can hold
+ *
+ * @param pool A pointer to the pool object
+ * @return size_t
+ */
+size_t nodepool_capacity(nodepool_t *pool);
+
+#endif // NODEPOOL_H
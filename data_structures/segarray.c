@@ -0,0 +1,212 @@
+#include "segarray.h"
+
+// Default chunk size in bytes when no item count is given
+#define SEGARRAY_DEFAULT_CHUNK_BYTES (64 * 1024)
+
+// +---------------------------------------------------------------------------+
+// |                           Static Functions                                |
+// +---------------------------------------------------------------------------+
+
+/**
+ * @brief Returns the number of items per chunk
+ *
+ * @param array
+ * @return size_t
+ */
+static size_t items_per_chunk(segarray_t *array) {
+    return (size_t)1 << array->chunk_shift;
+}
+
+/**
+ * @brief Allocates one more chunk, growing the directory if needed
+ * @note Growing the directory only moves the chunk pointers, never the items
+ *
+ * @param array
+ * @return int 0 if successful, 1 otherwise
+ */
+static int chunk_add(segarray_t *array) {
+    if (array->n_chunks == array->dir_capacity) {
+        size_t new_capacity = array->dir_capacity ? array->dir_capacity * 2 : 8;
+        char **chunks = (char **) realloc(array->chunks, new_capacity * sizeof(char *));
+
+        if (!chunks) {
+            return 1;
+        }
+
+        array->chunks = chunks;
+        array->dir_capacity = new_capacity;
+    }
+
+    char *chunk = (char *) malloc(items_per_chunk(array) * array->item_size);
+
+    if (!chunk) {
+        return 1;
+    }
+
+    array->chunks[array->n_chunks++] = chunk;
+
+    return 0;
+}
+
+/**
+ * @brief Returns a pointer to the slot for an index without bounds checks
+ *
+ * @param array
+ * @param index
+ * @return char*
+ */
+static char *item_ptr(segarray_t *array, size_t index) {
+    char *chunk = array->chunks[index >> array->chunk_shift];
+    size_t offset = index & (items_per_chunk(array) - 1);
+
+    return chunk + offset * array->item_size;
+}
+
+
+// +---------------------------------------------------------------------------+
+// |                           Public Functions                                |
+// +---------------------------------------------------------------------------+
+
+
+// --------------------
+int segarray_init(segarray_t *array, size_t item_size, size_t chunk_items) {
+    if (item_size == 0) {
+        return 1;
+    }
+
+    if (chunk_items == 0) {
+        chunk_items = SEGARRAY_DEFAULT_CHUNK_BYTES / item_size;
+    }
+
+    // Round up to a power of two so indexing is a shift and a mask
+    array->chunk_shift = 0;
+
+    while (((size_t)1 << array->chunk_shift) < chunk_items) {
+        array->chunk_shift++;
+    }
+
+    array->chunks = NULL;
+    array->n_chunks = 0;
+    array->dir_capacity = 0;
+    array->length = 0;
+    array->item_size = item_size;
+
+    return 0;
+}
+
+
+// --------------------
+void segarray_destroy(segarray_t *array) {
+    for (size_t i = 0; i < array->n_chunks; i++) {
+        free(array->chunks[i]);
+    }
+
+    free(array->chunks);
+
+    array->chunks = NULL;
+    array->n_chunks = 0;
+    array->dir_capacity = 0;
+    array->length = 0;
+}
+
+
+// --------------------
+size_t segarray_length(segarray_t *array) {
+    return array->length;
+}
+
+
+// --------------------
+size_t segarray_item_size(segarray_t *array) {
+    return array->item_size;
+}
+
+
+// --------------------
+size_t segarray_capacity(segarray_t *array) {
+    return array->n_chunks << array->chunk_shift;
+}
+
+
+// --------------------
+int segarray_reserve(segarray_t *array, size_t capacity) {
+    while (segarray_capacity(array) < capacity) {
+        if (chunk_add(array)) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+
+// --------------------
+int segarray_append(segarray_t *array, const void *item) {
+    if (array->length == segarray_capacity(array) && chunk_add(array)) {
+        return 1;
+    }
+
+    memcpy(item_ptr(array, array->length), item, array->item_size);
+    array->length++;
+
+    return 0;
+}
+
+
+// --------------------
+int segarray_pop(segarray_t *array, void *item) {
+    if (array->length == 0) {
+        return 1;
+    }
+
+    array->length--;
+
+    if (item) {
+        memcpy(item, item_ptr(array, array->length), array->item_size);
+    }
+
+    return 0;
+}
+
+
+// --------------------
+void *segarray_at(segarray_t *array, size_t index) {
+    if (index >= array->length) {
+        return NULL;
+    }
+
+    return item_ptr(array, index);
+}
+
+
+// --------------------
+int segarray_get(segarray_t *array, size_t index, void *item) {
+    if (index >= array->length) {
+        return 1;
+    }
+
+    memcpy(item, item_ptr(array, index), array->item_size);
+
+    return 0;
+}
+
+
+// --------------------
+size_t segarray_chunk_count(segarray_t *array) {
+    return (array->length + items_per_chunk(array) - 1) >> array->chunk_shift;
+}
+
+
+// --------------------
+void *segarray_chunk(segarray_t *array, size_t chunk, size_t *n_items) {
+    if (chunk >= segarray_chunk_count(array)) {
+        return NULL;
+    }
+
+    size_t start = chunk << array->chunk_shift;
+    size_t remaining = array->length - start;
+
+    *n_items = remaining < items_per_chunk(array) ? remaining : items_per_chunk(array);
+
+    return array->chunks[chunk];
+}
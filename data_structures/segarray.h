@@ -0,0 +1,158 @@
+/**
+ * @file segarray.h
+ * @brief Segmented array built from fixed-size chunks
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * Items are stored in chunks of a fixed power-of-two number of items. A
+ * small directory of chunk pointers gives O(1) random access. Growing the
+ * array allocates new chunks and never moves existing items, so pointers
+ * to items stay valid until the item is popped or the array is destroyed.
+ *
+ */
+
+#ifndef SEGARRAY_H
+#define SEGARRAY_H
+
+#include <stdlib.h>
+#include <string.h>
+
+// -------------------- Types
+
+/**
+ * @brief A segmented array object
+ *
+ * @param chunks Directory of pointers to the chunks
+ * @param n_chunks Number of allocated chunks
+ * @param dir_capacity Number of entries the directory can hold
+ * @param length Number of items in the array
+ * @param item_size Size of each item in bytes
+ * @param chunk_shift log2 of the number of items per chunk
+ *
+ */
+typedef struct segarray {
+    char **chunks;
+    size_t n_chunks;
+    size_t dir_capacity;
+    size_t length;
+    size_t item_size;
+    size_t chunk_shift;
+} segarray_t;
+
+
+/**
+ * @brief Initialise a segmented array
+ *
+ * @param array A pointer to the segmented array object
+ * @param item_size The size of an item in the array
+ * @param chunk_items The number of items per chunk, rounded up to a power of
+ * two. If 0, chunks are sized to roughly 64 KiB.
+ * @return int 0 if successful, 1 otherwise
+ */
+int segarray_init(segarray_t *array, size_t item_size, size_t chunk_items);
+
+/**
+ * @brief Destroy a segmented array
+ *
+ * @param array A pointer to the segmented array object
+ */
+void segarray_destroy(segarray_t *array);
+
+/**
+ * @brief Get the length of the array
+ *
+ * @param array A pointer to the segmented array object
+ * @return size_t The length of the array
+ */
+size_t segarray_length(segarray_t *array);
+
+/**
+ * @brief Get the size of an item in the array
+ *
+ * @param array A pointer to the segmented array object
+ * @return size_t The size of an item in the array
+ */
+size_t segarray_item_size(segarray_t *array);
+
+/**
+ * @brief Get the number of items the array can hold without allocating
+ *
+ * @param array A pointer to the segmented array object
+ * @return size_t The capacity of the array
+ */
+size_t segarray_capacity(segarray_t *array);
+
+/**
+ * @brief Allocate chunks so the array can hold at least `capacity` items
+ *
+ * @param array A pointer to the segmented array object
+ * @param capacity The number of items to reserve space for
+ * @return int 0 if successful, 1 otherwise
+ */
+int segarray_reserve(segarray_t *array, size_t capacity);
+
+/**
+ * @brief Append an item to the end of the array
+ * @note A copy of the item is stored in the array. Existing items are never
+ * moved.
+ *
+ * @param array A pointer to the segmented array object
+ * @param item A pointer to the item to append
+ * @return int 0 if successful, 1 otherwise
+ */
+int segarray_append(segarray_t *array, const void *item);
+
+/**
+ * @brief Pop an item from the end of the array
+ * @note The chunk holding the item is kept for reuse by later appends
+ *
+ * @param array A pointer to the segmented array object
+ * @param item A pointer to store the popped item. If NULL, the item is not
+ * returned
+ * @return int 0 if successful, 1 if the array is empty
+ */
+int segarray_pop(segarray_t *array, void *item);
+
+/**
+ * @brief Get the item at the given index
+ *
+ * @param array A pointer to the segmented array object
+ * @param index The index of the item to get
+ * @param item A pointer to store the retrieved item
+ * @return int 0 if successful, 1 otherwise
+ */
+int segarray_get(segarray_t *array, size_t index, void *item);
+
+/**
+ * @brief Get a pointer to the item at the given index without copying
+ * @note The pointer stays valid until the item is popped or the array is
+ * destroyed
+ *
+ * @param array A pointer to the segmented array object
+ * @param index The index of the item
+ * @return void* Pointer to the item, or NULL if the index is out of range
+ */
+void *segarray_at(segarray_t *array, size_t index);
+
+/**
+ * @brief Get the number of chunks holding items
+ *
+ * @param array A pointer to the segmented array object
+ * @return size_t The number of non-empty chunks
+ */
+size_t segarray_chunk_count(segarray_t *array);
+
+/**
+ * @brief Get a chunk for bulk processing
+ * @note Items within a chunk are contiguous. Every chunk but the last is
+ * full.
+ *
+ * @param array A pointer to the segmented array object
+ * @param chunk The index of the chunk
+ * @param n_items A pointer to store the number of items in the chunk
+ * @return void* Pointer to the first item in the chunk, or NULL if the chunk
+ * index is out of range
+ */
+void *segarray_chunk(segarray_t *array, size_t chunk, size_t *n_items);
+
+#endif // SEGARRAY_H
@@ -0,0 +1,295 @@
+#include "skiplist.h"
+
+// +---------------------------------------------------------------------------+
+// |                           Static Functions                                |
+// +---------------------------------------------------------------------------+
+
+/**
+ * @brief Gets the forward links of a node, one per level
+ *
+ * @param node
+ * @return skiplist_node_t**
+ */
+static skiplist_node_t **node_links(skiplist_node_t *node) {
+    return (skiplist_node_t **) (node + 1);
+}
+
+/**
+ * @brief Offset of the item in a node of the given height, aligned for
+ * any scalar type
+ *
+ * @param height
+ * @return size_t
+ */
+static size_t item_offset(size_t height) {
+    size_t offset = sizeof(skiplist_node_t) + height * sizeof(skiplist_node_t *);
+
+    return (offset + 15) / 16 * 16;
+}
+
+static void *node_data(skiplist_node_t *node) {
+    return (char *) node + item_offset(node->height);
+}
+
+/**
+ * @brief Gets the link to the node after `node` on a level, where a NULL
+ * node stands for the head
+ *
+ * @param list
+ * @param node
+ * @param level
+ * @return skiplist_node_t**
+ */
+static skiplist_node_t **link_after(skiplist_t *list, skiplist_node_t *node, size_t level) {
+    return node ? &node_links(node)[level] : &list->head[level];
+}
+
+/**
+ * @brief Picks the height of a new node: each extra level with chance 1/4
+ *
+ * @param list
+ * @return size_t
+ */
+static size_t random_height(skiplist_t *list) {
+    // xorshift64
+    uint64_t x = list->seed;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    list->seed = x;
+
+    size_t height = 1;
+
+    while ((x & 3) == 0 && height < SKIPLIST_MAX_LEVEL) {
+        height++;
+        x >>= 2;
+    }
+
+    return height;
+}
+
+/**
+ * @brief Finds, on every level, the last node less than `key`
+ *
+ * @param list
+ * @param key
+ * @param before Set to the last node less than `key` on each level in use,
+ * or NULL for the head
+ * @return skiplist_node_t* The first node not less than `key`, or NULL
+ */
+static skiplist_node_t *search(
+    skiplist_t *list,
+    const void *key,
+    skiplist_node_t **before
+) {
+    skiplist_node_t *node = NULL;
+
+    for (size_t level = list->level; level-- > 0;) {
+        skiplist_node_t *next;
+
+        while ((next = *link_after(list, node, level))
+               && list->compare(node_data(next), key) < 0) {
+            node = next;
+        }
+
+        if (before) {
+            before[level] = node;
+        }
+    }
+
+    return *link_after(list, node, 0);
+}
+
+/**
+ * @brief Finds the node equal to `key`
+ *
+ * @param list
+ * @param key
+ * @return skiplist_node_t* The node, or NULL if none is present
+ */
+static skiplist_node_t *find_node(skiplist_t *list, const void *key) {
+    skiplist_node_t *node = search(list, key, NULL);
+
+    if (!node || list->compare(node_data(node), key) != 0) {
+        return NULL;
+    }
+
+    return node;
+}
+
+
+// +---------------------------------------------------------------------------+
+// |                           Public Functions                                |
+// +---------------------------------------------------------------------------+
+
+
+// --------------------
+int skiplist_init(skiplist_t *list, size_t item_size, int (*compare)(const void *, const void *)) {
+    for (size_t level = 0; level < SKIPLIST_MAX_LEVEL; level++) {
+        list->head[level] = NULL;
+    }
+
+    list->level = 1;
+    list->length = 0;
+    list->item_size = item_size;
+    list->compare = compare;
+    list->seed = 0x9E3779B97F4A7C15ull ^ (uintptr_t) list;
+
+    return 0;
+}
+
+
+// --------------------
+void skiplist_destroy(skiplist_t *list) {
+    skiplist_node_t *node = list->head[0];
+
+    while (node) {
+        skiplist_node_t *next = node_links(node)[0];
+        free(node);
+        node = next;
+    }
+
+    for (size_t level = 0; level < SKIPLIST_MAX_LEVEL; level++) {
+        list->head[level] = NULL;
+    }
+
+    list->level = 1;
+    list->length = 0;
+}
+
+
+// --------------------
+size_t skiplist_length(skiplist_t *list) {
+    return list->length;
+}
+
+
+// --------------------
+int skiplist_empty(skiplist_t *list) {
+    return list->length == 0;
+}
+
+
+// --------------------
+int skiplist_insert(skiplist_t *list, const void *item) {
+    skiplist_node_t *before[SKIPLIST_MAX_LEVEL];
+    skiplist_node_t *found = search(list, item, before);
+
+    if (found && list->compare(node_data(found), item) == 0) {
+        return 1;
+    }
+
+    size_t height = random_height(list);
+    skiplist_node_t *node = (skiplist_node_t *) malloc(item_offset(height) + list->item_size);
+
+    if (!node) {
+        return 1;
+    }
+
+    node->height = height;
+    memcpy(node_data(node), item, list->item_size);
+
+    // New levels start from the head
+    for (; list->level < height; list->level++) {
+        before[list->level] = NULL;
+    }
+
+    for (size_t level = 0; level < height; level++) {
+        skiplist_node_t **link = link_after(list, before[level], level);
+
+        node_links(node)[level] = *link;
+        *link = node;
+    }
+
+    list->length++;
+
+    return 0;
+}
+
+
+// --------------------
+void *skiplist_find(skiplist_t *list, const void *key) {
+    skiplist_node_t *node = find_node(list, key);
+
+    return node ? node_data(node) : NULL;
+}
+
+
+// --------------------
+int skiplist_get(skiplist_t *list, const void *key, void *item) {
+    skiplist_node_t *node = find_node(list, key);
+
+    if (!node) {
+        return 1;
+    }
+
+    memcpy(item, node_data(node), list->item_size);
+
+    return 0;
+}
+
+
+// --------------------
+int skiplist_erase(skiplist_t *list, const void *key, void *item) {
+    skiplist_node_t *before[SKIPLIST_MAX_LEVEL];
+    skiplist_node_t *node = search(list, key, before);
+
+    if (!node || list->compare(node_data(node), key) != 0) {
+        return 1;
+    }
+
+    if (item) {
+        memcpy(item, node_data(node), list->item_size);
+    }
+
+    for (size_t level = 0; level < node->height; level++) {
+        *link_after(list, before[level], level) = node_links(node)[level];
+    }
+
+    // Drop levels left empty
+    while (list->level > 1 && !list->head[list->level - 1]) {
+        list->level--;
+    }
+
+    free(node);
+    list->length--;
+
+    return 0;
+}
+
+
+// --------------------
+int skiplist_lower_bound(skiplist_iterator_t *iterator, skiplist_t *list, const void *key) {
+    iterator->next = key ? search(list, key, NULL) : list->head[0];
+    iterator->item_size = list->item_size;
+
+    return 0;
+}
+
+
+// --------------------
+int skiplist_iter_next(skiplist_iterator_t *iterator, void *item) {
+    void *data = skiplist_iter_next_ptr(iterator);
+
+    if (!data) {
+        return 1;
+    }
+
+    memcpy(item, data, iterator->item_size);
+
+    return 0;
+}
+
+
+// --------------------
+void *skiplist_iter_next_ptr(skiplist_iterator_t *iterator) {
+    skiplist_node_t *node = iterator->next;
+
+    if (!node) {
+        return NULL;
+    }
+
+    iterator->next = node_links(node)[0];
+
+    return node_data(node);
+}
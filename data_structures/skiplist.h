@@ -0,0 +1,183 @@
+/**
+ * @file skiplist.h
+ * @brief Ordered set or map as a skip list
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * Items are kept sorted by a comparator. Each node links forward on a
+ * random number of levels, with a quarter of the nodes on each level
+ * reaching the next, so insert, find and erase take O(log n) expected
+ * steps. A node's tower of links and its item share one allocation.
+ *
+ * To use it as a map, store a struct of key and value, and compare only
+ * the keys. `skiplist_find` returns a pointer into the node, so a value can
+ * be updated in place.
+ *
+ */
+
+#ifndef SKIPLIST_H
+#define SKIPLIST_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+// -------------------- Types
+
+/**
+ * @brief Most levels a node can have, enough for 4^32 items
+ *
+ */
+#define SKIPLIST_MAX_LEVEL 32
+
+/**
+ * @brief A node of a skip list
+ * @note The node is followed by `height` forward links, then the item
+ *
+ * @param height Number of levels the node is linked on
+ *
+ */
+typedef struct skiplist_node {
+    size_t height;
+} skiplist_node_t;
+
+/**
+ * @brief A skip list object
+ *
+ * @param head The first node on each level
+ * @param level Number of levels in use
+ * @param length Number of items in the list
+ * @param item_size Size of each item in bytes
+ * @param compare Orders the items; items that compare equal are the same
+ * @param seed State of the generator of node heights
+ *
+ */
+typedef struct skiplist {
+    skiplist_node_t *head[SKIPLIST_MAX_LEVEL];
+    size_t level;
+    size_t length;
+    size_t item_size;
+    int (*compare)(const void *, const void *);
+    uint64_t seed;
+} skiplist_t;
+
+/**
+ * @brief An iterator over a skip list, in ascending order
+ *
+ * @param next The node of the next item, or NULL at the end
+ * @param item_size Size of each item in bytes
+ *
+ */
+typedef struct skiplist_iterator {
+    skiplist_node_t *next;
+    size_t item_size;
+} skiplist_iterator_t;
+
+// +---------------------------------------------------------------------------+
+// |                           Public Interface                                |
+// +---------------------------------------------------------------------------+
+
+/**
+ * @brief Initialise an empty skip list
+ *
+ * @param list A pointer to the skip list object
+ * @param item_size The size of an item in the list
+ * @param compare A function to order two items
+ * @return int 0 if successful, 1 otherwise
+ */
+int skiplist_init(skiplist_t *list, size_t item_size, int (*compare)(const void *, const void *));
+
+/**
+ * @brief Destroy a skip list
+ *
+ * @param list A pointer to the skip list object
+ */
+void skiplist_destroy(skiplist_t *list);
+
+/**
+ * @brief Get the number of items in the list
+ *
+ * @param list A pointer to the skip list object
+ * @return size_t
+ */
+size_t skiplist_length(skiplist_t *list);
+
+/**
+ * @brief Check if the list is empty
+ *
+ * @param list A pointer to the skip list object
+ * @return int 1 if the list is empty, 0 otherwise
+ */
+int skiplist_empty(skiplist_t *list);
+
+/**
+ * @brief Insert an item in order, unless an equal item is present
+ *
+ * @param list A pointer to the skip list object
+ * @param item A pointer to the item to insert
+ * @return int 0 if inserted, 1 if an equal item is present or memory could
+ * not be allocated
+ */
+int skiplist_insert(skiplist_t *list, const void *item);
+
+/**
+ * @brief Find the item equal to `key`
+ *
+ * @param list A pointer to the skip list object
+ * @param key A pointer to an item comparing equal to the one to find
+ * @return void* Pointer to the item in its node, valid until it is erased,
+ * or NULL if none is present. The item must not be changed in a way that
+ * changes its order.
+ */
+void *skiplist_find(skiplist_t *list, const void *key);
+
+/**
+ * @brief Copy the item equal to `key`
+ *
+ * @param list A pointer to the skip list object
+ * @param key A pointer to an item comparing equal to the one to get
+ * @param item A pointer to store the item found
+ * @return int 0 if found, 1 otherwise
+ */
+int skiplist_get(skiplist_t *list, const void *key, void *item);
+
+/**
+ * @brief Remove the item equal to `key`
+ *
+ * @param list A pointer to the skip list object
+ * @param key A pointer to an item comparing equal to the one to remove
+ * @param item A pointer to store the removed item, or NULL
+ * @return int 0 if removed, 1 if no equal item is present
+ */
+int skiplist_erase(skiplist_t *list, const void *key, void *item);
+
+/**
+ * @brief Position an iterator at the first item not less than `key`
+ * @note Iterate while the items are below an upper bound to scan a range
+ *
+ * @param iterator A pointer to the iterator object
+ * @param list A pointer to the skip list object
+ * @param key A pointer to the lower bound, or NULL to start at the first item
+ * @return int 0 if successful, 1 otherwise
+ */
+int skiplist_lower_bound(skiplist_iterator_t *iterator, skiplist_t *list, const void *key);
+
+/**
+ * @brief Get the next item from the iterator
+ *
+ * @param iterator A pointer to the iterator object
+ * @param item A pointer to store the retrieved item
+ * @return int 0 if successful, 1 if the end of the list is reached
+ */
+int skiplist_iter_next(skiplist_iterator_t *iterator, void *item);
+
+/**
+ * @brief Get a pointer to the next item from the iterator, without copying
+ *
+ * @param iterator A pointer to the iterator object
+ * @return void* Pointer to the item in its node, or NULL if the end of the
+ * list is reached
+ */
+void *skiplist_iter_next_ptr(skiplist_iterator_t *iterator);
+
+#endif // SKIPLIST_H
@@ -0,0 +1,455 @@
+#include "ulist.h"
+#include "array.h"
+#include "array_sort.h"
+
+// Every node holds at least this many items, however large they are
+#define MIN_NODE_ITEMS 4
+
+// Items start at this offset in a node, aligned for any scalar type
+#define ITEMS_OFFSET ((sizeof(ulist_node_t) + 15) / 16 * 16)
+
+// +---------------------------------------------------------------------------+
+// |                           Static Functions                                |
+// +---------------------------------------------------------------------------+
+
+static char *node_items(ulist_node_t *node) {
+    return (char *) node + ITEMS_OFFSET;
+}
+
+static char *node_item(ulist_t *list, ulist_node_t *node, size_t offset) {
+    return node_items(node) + offset * list->item_size;
+}
+
+/**
+ * @brief Creates an empty node and links it after `prev`, or at the head
+ *
+ * @param list
+ * @param prev The node to link after, or NULL for the head
+ * @return ulist_node_t* The new node, or NULL on failure
+ */
+static ulist_node_t *node_create(ulist_t *list, ulist_node_t *prev) {
+    ulist_node_t *node = (ulist_node_t *) malloc(ITEMS_OFFSET + list->node_capacity * list->item_size);
+
+    if (!node) {
+        return NULL;
+    }
+
+    node->count = 0;
+    node->prev = prev;
+    node->next = prev ? prev->next : list->head;
+
+    if (node->next) {
+        node->next->prev = node;
+    } else {
+        list->tail = node;
+    }
+
+    if (prev) {
+        prev->next = node;
+    } else {
+        list->head = node;
+    }
+
+    list->n_nodes++;
+
+    return node;
+}
+
+/**
+ * @brief Unlinks and frees a node
+ *
+ * @param list
+ * @param node
+ */
+static void node_destroy(ulist_t *list, ulist_node_t *node) {
+    if (node->prev) {
+        node->prev->next = node->next;
+    } else {
+        list->head = node->next;
+    }
+
+    if (node->next) {
+        node->next->prev = node->prev;
+    } else {
+        list->tail = node->prev;
+    }
+
+    list->n_nodes--;
+    free(node);
+}
+
+/**
+ * @brief Finds the node holding an index, walking from the closer end
+ *
+ * @param list
+ * @param index An index less than the length
+ * @param offset Set to the position of the item within the node
+ * @return ulist_node_t*
+ */
+static ulist_node_t *node_find(ulist_t *list, size_t index, size_t *offset) {
+    ulist_node_t *node;
+
+    if (index < list->length / 2) {
+        node = list->head;
+
+        while (index >= node->count) {
+            index -= node->count;
+            node = node->next;
+        }
+    } else {
+        // Count from the end: `index` becomes the position from the back
+        size_t from_end = list->length - 1 - index;
+        node = list->tail;
+
+        while (from_end >= node->count) {
+            from_end -= node->count;
+            node = node->prev;
+        }
+
+        index = node->count - 1 - from_end;
+    }
+
+    *offset = index;
+
+    return node;
+}
+
+/**
+ * @brief Moves the second half of a full node into a new node after it
+ *
+ * @param list
+ * @param node
+ * @return ulist_node_t* The new node, or NULL on failure
+ */
+static ulist_node_t *node_split(ulist_t *list, ulist_node_t *node) {
+    ulist_node_t *next = node_create(list, node);
+
+    if (!next) {
+        return NULL;
+    }
+
+    size_t keep = node->count - node->count / 2;
+
+    next->count = node->count - keep;
+    memcpy(node_items(next), node_item(list, node, keep), next->count * list->item_size);
+    node->count = keep;
+
+    return next;
+}
+
+/**
+ * @brief Moves every item of `node->next` into `node` and frees it
+ *
+ * @param list
+ * @param node A node whose next node's items fit in it
+ */
+static void node_absorb_next(ulist_t *list, ulist_node_t *node) {
+    ulist_node_t *next = node->next;
+
+    memcpy(node_item(list, node, node->count), node_items(next), next->count * list->item_size);
+    node->count += next->count;
+    node_destroy(list, next);
+}
+
+
+// +---------------------------------------------------------------------------+
+// |                           Public Functions                                |
+// +---------------------------------------------------------------------------+
+
+
+// --------------------
+int ulist_init(ulist_t *list, size_t item_size) {
+    if (item_size == 0) {
+        return 1;
+    }
+
+    size_t capacity = ULIST_NODE_BYTES > ITEMS_OFFSET
+        ? (ULIST_NODE_BYTES - ITEMS_OFFSET) / item_size
+        : 0;
+
+    list->head = NULL;
+    list->tail = NULL;
+    list->length = 0;
+    list->item_size = item_size;
+    list->node_capacity = capacity < MIN_NODE_ITEMS ? MIN_NODE_ITEMS : capacity;
+    list->n_nodes = 0;
+
+    return 0;
+}
+
+
+// --------------------
+void ulist_destroy(ulist_t *list) {
+    ulist_node_t *node = list->head;
+
+    while (node) {
+        ulist_node_t *next = node->next;
+        free(node);
+        node = next;
+    }
+
+    list->head = NULL;
+    list->tail = NULL;
+    list->length = 0;
+    list->n_nodes = 0;
+}
+
+
+// --------------------
+size_t ulist_length(ulist_t *list) {
+    return list->length;
+}
+
+
+// --------------------
+int ulist_empty(ulist_t *list) {
+    return list->length == 0;
+}
+
+
+// --------------------
+size_t ulist_item_size(ulist_t *list) {
+    return list->item_size;
+}
+
+
+// --------------------
+size_t ulist_node_count(ulist_t *list) {
+    return list->n_nodes;
+}
+
+
+// --------------------
+int ulist_insert(ulist_t *list, size_t index, const void *item) {
+    if (index > list->length) {
+        return 1;
+    }
+
+    ulist_node_t *node;
+    size_t offset;
+
+    if (index == list->length) {
+        node = list->tail;
+        offset = node ? node->count : 0;
+
+        // Appending starts a new node rather than splitting a full one
+        if (!node || node->count == list->node_capacity) {
+            node = node_create(list, list->tail);
+            offset = 0;
+        }
+    } else {
+        node = node_find(list, index, &offset);
+
+        if (node->count == list->node_capacity) {
+            ulist_node_t *next = node_split(list, node);
+
+            if (!next) {
+                return 1;
+            }
+
+            if (offset > node->count) {
+                offset -= node->count;
+                node = next;
+            }
+        }
+    }
+
+    if (!node) {
+        return 1;
+    }
+
+    char *slot = node_item(list, node, offset);
+
+    memmove(slot + list->item_size, slot, (node->count - offset) * list->item_size);
+    memcpy(slot, item, list->item_size);
+    node->count++;
+    list->length++;
+
+    return 0;
+}
+
+
+// --------------------
+int ulist_remove(ulist_t *list, size_t index, void *item) {
+    if (index >= list->length) {
+        return 1;
+    }
+
+    size_t offset;
+    ulist_node_t *node = node_find(list, index, &offset);
+    char *slot = node_item(list, node, offset);
+
+    if (item) {
+        memcpy(item, slot, list->item_size);
+    }
+
+    memmove(slot, slot + list->item_size, (node->count - offset - 1) * list->item_size);
+    node->count--;
+    list->length--;
+
+    size_t capacity = list->node_capacity;
+
+    if (node->count == 0) {
+        node_destroy(list, node);
+    } else if (node->count < capacity / 2) {
+        // Merge with a neighbour so nodes stay at least half full
+        if (node->next && node->count + node->next->count <= capacity) {
+            node_absorb_next(list, node);
+        } else if (node->prev && node->prev->count + node->count <= capacity) {
+            node_absorb_next(list, node->prev);
+        }
+    }
+
+    return 0;
+}
+
+
+// --------------------
+int ulist_append(ulist_t *list, const void *item) {
+    return ulist_insert(list, list->length, item);
+}
+
+
+// --------------------
+int ulist_pop(ulist_t *list, void *item) {
+    if (list->length == 0) {
+        return 1;
+    }
+
+    return ulist_remove(list, list->length - 1, item);
+}
+
+
+// --------------------
+int ulist_get(ulist_t *list, size_t index, void *item) {
+    void *slot = ulist_at(list, index);
+
+    if (!slot) {
+        return 1;
+    }
+
+    memcpy(item, slot, list->item_size);
+
+    return 0;
+}
+
+
+// --------------------
+void *ulist_at(ulist_t *list, size_t index) {
+    if (index >= list->length) {
+        return NULL;
+    }
+
+    size_t offset;
+    ulist_node_t *node = node_find(list, index, &offset);
+
+    return node_item(list, node, offset);
+}
+
+
+// --------------------
+int ulist_from_raw(ulist_t *list, size_t item_size, size_t length, const void *raw) {
+    if (ulist_init(list, item_size) != 0) {
+        return 1;
+    }
+
+    const char *raw_ptr = (const char *) raw;
+
+    // Fill whole nodes at a time
+    while (list->length < length) {
+        ulist_node_t *node = node_create(list, list->tail);
+
+        if (!node) {
+            ulist_destroy(list);
+            return 1;
+        }
+
+        size_t remaining = length - list->length;
+        node->count = remaining < list->node_capacity ? remaining : list->node_capacity;
+        memcpy(node_items(node), raw_ptr + list->length * item_size, node->count * item_size);
+        list->length += node->count;
+    }
+
+    return 0;
+}
+
+
+// --------------------
+int ulist_sort(ulist_t *list, int (*compare)(const void *, const void *)) {
+    char *items = (char *) array_init(list->item_size, list->length);
+
+    if (!items) {
+        return 1;
+    }
+
+    size_t done = 0;
+
+    for (ulist_node_t *node = list->head; node; node = node->next) {
+        memcpy(items + done * list->item_size, node_items(node), node->count * list->item_size);
+        done += node->count;
+    }
+
+    if (!array_sort_stable(items, compare)) {
+        array_destroy(items);
+        return 1;
+    }
+
+    done = 0;
+
+    for (ulist_node_t *node = list->head; node; node = node->next) {
+        memcpy(node_items(node), items + done * list->item_size, node->count * list->item_size);
+        done += node->count;
+    }
+
+    array_destroy(items);
+
+    return 0;
+}
+
+
+// --------------------
+int ulist_iter_init(ulist_iterator_t *iterator, ulist_t *list, int start, int reverse) {
+    if ((size_t) abs(start) > list->length) {
+        return 1;
+    }
+
+    size_t start_idx = start < 0 ? list->length + start : (size_t) start;
+
+    iterator->node = NULL;
+    iterator->offset = 0;
+    iterator->reverse = reverse;
+    iterator->item_size = list->item_size;
+
+    if (start_idx < list->length) {
+        iterator->node = node_find(list, start_idx, &iterator->offset);
+    }
+
+    return 0;
+}
+
+
+// --------------------
+int ulist_iter_next(ulist_iterator_t *iterator, void *item) {
+    ulist_node_t *node = iterator->node;
+
+    if (!node) {
+        return 1;
+    }
+
+    char *items = node_items(node);
+    memcpy(item, items + iterator->offset * iterator->item_size, iterator->item_size);
+
+    if (iterator->reverse) {
+        if (iterator->offset == 0) {
+            iterator->node = node->prev;
+            iterator->offset = node->prev ? node->prev->count - 1 : 0;
+        } else {
+            iterator->offset--;
+        }
+    } else if (++iterator->offset == node->count) {
+        iterator->node = node->next;
+        iterator->offset = 0;
+    }
+
+    return 0;
+}
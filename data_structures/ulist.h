@@ -0,0 +1,239 @@
+/**
+ * @file ulist.h
+ * @brief Unrolled doubly linked list
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * Each node holds a small array of items, sized to a few cache lines, so
+ * iterating touches memory almost as sequentially as an array, and the
+ * links cost a few bytes per node rather than per item. Inserting in the
+ * middle only shifts the items of one node: a full node is split in half,
+ * and a node left less than half full by a removal is merged with a
+ * neighbour.
+ *
+ */
+
+#ifndef ULIST_H
+#define ULIST_H
+
+#include <stdlib.h>
+#include <string.h>
+
+// -------------------- Types
+
+/**
+ * @brief Target size of a node in bytes, including its links
+ *
+ */
+#ifndef ULIST_NODE_BYTES
+#define ULIST_NODE_BYTES 256
+#endif
+
+/**
+ * @brief A node of an unrolled list
+ * @note The items are stored inline, after the node
+ *
+ * @param next Pointer to the next node in the list
+ * @param prev Pointer to the previous node in the list
+ * @param count Number of items in the node
+ *
+ */
+typedef struct ulist_node {
+    struct ulist_node *next;
+    struct ulist_node *prev;
+    size_t count;
+} ulist_node_t;
+
+/**
+ * @brief An unrolled list object
+ *
+ * @param head Pointer to the first node in the list
+ * @param tail Pointer to the last node in the list
+ * @param length Number of items in the list
+ * @param item_size Size of each item in bytes
+ * @param node_capacity Number of items a node can hold
+ * @param n_nodes Number of nodes in the list
+ *
+ */
+typedef struct ulist {
+    ulist_node_t *head;
+    ulist_node_t *tail;
+    size_t length;
+    size_t item_size;
+    size_t node_capacity;
+    size_t n_nodes;
+} ulist_t;
+
+/**
+ * @brief An iterator for an unrolled list
+ *
+ * @param node The node holding the next item, or NULL at the end
+ * @param offset Position of the next item within `node`
+ * @param reverse Flag to indicate if the iterator is in reverse
+ * @param item_size Size of each item in bytes
+ *
+ */
+typedef struct ulist_iterator {
+    ulist_node_t *node;
+    size_t offset;
+    int reverse;
+    size_t item_size;
+} ulist_iterator_t;
+
+// +---------------------------------------------------------------------------+
+// |                           Public Interface                                |
+// +---------------------------------------------------------------------------+
+
+/**
+ * @brief Initialise an unrolled list
+ *
+ * @param list A pointer to the list object
+ * @param item_size The size of an item in the list
+ * @return int 0 if successful, 1 otherwise
+ */
+int ulist_init(ulist_t *list, size_t item_size);
+
+/**
+ * @brief Destroy an unrolled list
+ *
+ * @param list A pointer to the list object
+ */
+void ulist_destroy(ulist_t *list);
+
+/**
+ * @brief Get the length of the list
+ *
+ * @param list A pointer to the list object
+ * @return size_t The length of the list
+ */
+size_t ulist_length(ulist_t *list);
+
+/**
+ * @brief Check if the list is empty
+ *
+ * @param list A pointer to the list object
+ * @return int 1 if the list is empty, 0 otherwise
+ */
+int ulist_empty(ulist_t *list);
+
+/**
+ * @brief Get the size of an item in the list
+ *
+ * @param list A pointer to the list object
+ * @return size_t The size of an item in the list
+ */
+size_t ulist_item_size(ulist_t *list);
+
+/**
+ * @brief Get the number of nodes in the list
+ *
+ * @param list A pointer to the list object
+ * @return size_t
+ */
+size_t ulist_node_count(ulist_t *list);
+
+/**
+ * @brief Insert an item at the given index
+ * @note Finding the index walks nodes, not items, from the closer end
+ *
+ * @param list A pointer to the list object
+ * @param index The index to insert the item
+ * @param item A pointer to the item to insert
+ * @return int 0 if successful, 1 otherwise
+ */
+int ulist_insert(ulist_t *list, size_t index, const void *item);
+
+/**
+ * @brief Remove the item at the given index
+ *
+ * @param list A pointer to the list object
+ * @param index The index of the item to remove
+ * @param item A pointer to store the removed item, or NULL
+ * @return int 0 if successful, 1 otherwise
+ */
+int ulist_remove(ulist_t *list, size_t index, void *item);
+
+/**
+ * @brief Append an item to the end of the list
+ * @note Appending fills the last node before starting a new one, so a list
+ * built by appending has full nodes
+ *
+ * @param list A pointer to the list object
+ * @param item A pointer to the item to append
+ * @return int 0 if successful, 1 otherwise
+ */
+int ulist_append(ulist_t *list, const void *item);
+
+/**
+ * @brief Pop an item from the end of the list
+ *
+ * @param list A pointer to the list object
+ * @param item A pointer to store the popped item, or NULL
+ * @return int 0 if successful, 1 otherwise
+ */
+int ulist_pop(ulist_t *list, void *item);
+
+/**
+ * @brief Get the item at the given index
+ *
+ * @param list A pointer to the list object
+ * @param index The index of the item to get
+ * @param item A pointer to store the retrieved item
+ * @return int 0 if successful, 1 otherwise
+ */
+int ulist_get(ulist_t *list, size_t index, void *item);
+
+/**
+ * @brief Get a pointer to the item at the given index
+ * @note The pointer is invalidated by any insert or remove
+ *
+ * @param list A pointer to the list object
+ * @param index The index of the item
+ * @return void* Pointer to the item, or NULL if the index is invalid
+ */
+void *ulist_at(ulist_t *list, size_t index);
+
+/**
+ * @brief Create an unrolled list from a raw array
+ *
+ * @param list A pointer to the list object
+ * @param item_size The size of an item in the list
+ * @param length The length of the raw array
+ * @param raw A pointer to the raw array
+ * @return int 0 if successful, 1 otherwise
+ */
+int ulist_from_raw(ulist_t *list, size_t item_size, size_t length, const void *raw);
+
+/**
+ * @brief Sort the list in place, keeping equal items in their original order
+ * @note The items are gathered into an array, sorted with
+ * `array_sort_stable` and written back, so the node layout is unchanged
+ *
+ * @param list A pointer to the list object
+ * @param compare A function to compare two items
+ * @return int 0 if successful, 1 if memory could not be allocated, in
+ * which case the list is unchanged
+ */
+int ulist_sort(ulist_t *list, int (*compare)(const void *, const void *));
+
+/**
+ * @brief Create an iterator for the list
+ *
+ * @param iterator A pointer to the iterator object
+ * @param list A pointer to the list object
+ * @param start The index to start the iterator. Negative indices are from the end.
+ * @param reverse Flag to indicate if the iterator should be in reverse
+ * @return int 0 if successful, 1 otherwise
+ */
+int ulist_iter_init(ulist_iterator_t *iterator, ulist_t *list, int start, int reverse);
+
+/**
+ * @brief Get the next item from the iterator
+ *
+ * @param iterator A pointer to the iterator object
+ * @param item A pointer to store the retrieved item
+ * @return int 0 if successful, 1 if the end of the list is reached
+ */
+int ulist_iter_next(ulist_iterator_t *iterator, void *item);
+
+#endif // ULIST_H
@@ -0,0 +1,241 @@
+#include "epoch.h"
+
+// Bit of a thread's state set while it is inside a critical section
+#define STATE_ACTIVE 1ul
+
+
+// +---------------------------------------------------------------------------+
+// |                           Static Functions                                |
+// +---------------------------------------------------------------------------+
+
+/**
+ * @brief Checks whether an object retired in `retired_epoch` can be freed
+ *
+ * @param retired_epoch
+ * @param epoch The current global epoch
+ * @return int 1 if it can be freed, 0 otherwise
+ */
+static int is_safe(unsigned long retired_epoch, unsigned long epoch) {
+    // Every thread that could have seen the object has since left
+    return epoch - retired_epoch >= 2;
+}
+
+/**
+ * @brief Frees the oldest records of a chain while they are safe
+ *
+ * @param head The first record of the chain, oldest first
+ * @param epoch The current global epoch
+ * @param freed Incremented for each record freed
+ * @return epoch_retired_t* The first record not freed
+ */
+static epoch_retired_t *free_safe(epoch_retired_t *head, unsigned long epoch, size_t *freed) {
+    while (head && is_safe(head->epoch, epoch)) {
+        epoch_retired_t *next = head->next;
+        head->free_fn(head);
+        head = next;
+        (*freed)++;
+    }
+
+    return head;
+}
+
+static void free_all(epoch_retired_t *head) {
+    while (head) {
+        epoch_retired_t *next = head->next;
+        head->free_fn(head);
+        head = next;
+    }
+}
+
+/**
+ * @brief Advances the global epoch if every thread in a critical section
+ * entered during the current one
+ * @note Called with the domain lock held
+ *
+ * @param domain
+ * @return unsigned long The global epoch after the attempt
+ */
+static unsigned long try_advance(epoch_domain_t *domain) {
+    unsigned long epoch = __atomic_load_n(&domain->epoch, __ATOMIC_RELAXED);
+
+    for (epoch_thread_t *thread = domain->threads; thread; thread = thread->next) {
+        unsigned long state = __atomic_load_n(&thread->state, __ATOMIC_ACQUIRE);
+
+        if ((state & STATE_ACTIVE) && (state >> 1) != epoch) {
+            return epoch;
+        }
+    }
+
+    __atomic_store_n(&domain->epoch, epoch + 1, __ATOMIC_RELEASE);
+
+    return epoch + 1;
+}
+
+
+// +---------------------------------------------------------------------------+
+// |                           Public Functions                                |
+// +---------------------------------------------------------------------------+
+
+
+// --------------------
+int epoch_init(epoch_domain_t *domain) {
+    if (pthread_mutex_init(&domain->lock, NULL) != 0) {
+        return 1;
+    }
+
+    domain->epoch = 0;
+    domain->threads = NULL;
+    domain->orphans = NULL;
+
+    return 0;
+}
+
+
+// --------------------
+void epoch_destroy(epoch_domain_t *domain) {
+    for (epoch_thread_t *thread = domain->threads; thread; thread = thread->next) {
+        free_all(thread->retired_head);
+        thread->retired_head = NULL;
+        thread->retired_tail = NULL;
+        thread->n_retired = 0;
+    }
+
+    free_all(domain->orphans);
+    domain->orphans = NULL;
+    domain->threads = NULL;
+
+    pthread_mutex_destroy(&domain->lock);
+}
+
+
+// --------------------
+int epoch_register(epoch_domain_t *domain, epoch_thread_t *thread) {
+    thread->domain = domain;
+    thread->state = 0;
+    thread->depth = 0;
+    thread->retired_head = NULL;
+    thread->retired_tail = NULL;
+    thread->n_retired = 0;
+
+    pthread_mutex_lock(&domain->lock);
+    thread->next = domain->threads;
+    domain->threads = thread;
+    pthread_mutex_unlock(&domain->lock);
+
+    return 0;
+}
+
+
+// --------------------
+void epoch_unregister(epoch_thread_t *thread) {
+    epoch_domain_t *domain = thread->domain;
+
+    epoch_collect(thread);
+
+    pthread_mutex_lock(&domain->lock);
+
+    epoch_thread_t **link = &domain->threads;
+
+    while (*link != thread) {
+        link = &(*link)->next;
+    }
+
+    *link = thread->next;
+
+    // Keep the orphans oldest first, so they are freed in order
+    if (thread->retired_head) {
+        epoch_retired_t **tail = &domain->orphans;
+
+        while (*tail) {
+            tail = &(*tail)->next;
+        }
+
+        *tail = thread->retired_head;
+    }
+
+    pthread_mutex_unlock(&domain->lock);
+
+    thread->retired_head = NULL;
+    thread->retired_tail = NULL;
+    thread->n_retired = 0;
+}
+
+
+// --------------------
+void epoch_enter(epoch_thread_t *thread) {
+    if (thread->depth++ > 0) {
+        return;
+    }
+
+    unsigned long epoch = __atomic_load_n(&thread->domain->epoch, __ATOMIC_ACQUIRE);
+
+    // The state must be visible before any shared node is read
+    __atomic_store_n(&thread->state, (epoch << 1) | STATE_ACTIVE, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+
+// --------------------
+void epoch_exit(epoch_thread_t *thread) {
+    if (--thread->depth > 0) {
+        return;
+    }
+
+    __atomic_store_n(&thread->state, thread->state & ~STATE_ACTIVE, __ATOMIC_RELEASE);
+}
+
+
+// --------------------
+void epoch_retire(
+    epoch_thread_t *thread,
+    epoch_retired_t *retired,
+    void (*free_fn)(epoch_retired_t *retired)
+) {
+    // Read after the object was unlinked, so no later reader can reach it
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    retired->epoch = __atomic_load_n(&thread->domain->epoch, __ATOMIC_ACQUIRE);
+    retired->free_fn = free_fn;
+    retired->next = NULL;
+
+    if (thread->retired_tail) {
+        thread->retired_tail->next = retired;
+    } else {
+        thread->retired_head = retired;
+    }
+
+    thread->retired_tail = retired;
+    thread->n_retired++;
+
+    if (thread->n_retired % EPOCH_COLLECT_THRESHOLD == 0) {
+        epoch_collect(thread);
+    }
+}
+
+
+// --------------------
+size_t epoch_collect(epoch_thread_t *thread) {
+    epoch_domain_t *domain = thread->domain;
+    size_t freed = 0;
+    size_t orphans_freed = 0;
+
+    pthread_mutex_lock(&domain->lock);
+    unsigned long epoch = try_advance(domain);
+    domain->orphans = free_safe(domain->orphans, epoch, &orphans_freed);
+    pthread_mutex_unlock(&domain->lock);
+
+    thread->retired_head = free_safe(thread->retired_head, epoch, &freed);
+
+    if (!thread->retired_head) {
+        thread->retired_tail = NULL;
+    }
+
+    thread->n_retired -= freed;
+
+    return freed + orphans_freed;
+}
+
+
+// --------------------
+size_t epoch_pending(epoch_thread_t *thread) {
+    return thread->n_retired;
+}
@@ -0,0 +1,178 @@
+/**
+ * @file epoch.h
+ * @brief Epoch-based reclamation for lock-free data structures
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * A lock-free structure cannot free a node as soon as it is unlinked,
+ * because other threads may still be reading it. Each thread instead
+ * brackets its accesses with `epoch_enter` and `epoch_exit`, and hands
+ * unlinked nodes to `epoch_retire`. The domain's global epoch advances
+ * once every thread inside a critical section has seen the current one,
+ * and a node retired in epoch e is freed once the global epoch reaches
+ * e + 2, when no thread can still hold a reference to it.
+ *
+ * Retired nodes embed an `epoch_retired_t`, so retiring never allocates.
+ *
+ */
+
+#ifndef EPOCH_H
+#define EPOCH_H
+
+#include <pthread.h>
+#include <stddef.h>
+
+// -------------------- Types
+
+/**
+ * @brief Number of retirements after which a thread tries to free nodes
+ *
+ */
+#ifndef EPOCH_COLLECT_THRESHOLD
+#define EPOCH_COLLECT_THRESHOLD 64
+#endif
+
+/**
+ * @brief A record embedded in each object that can be retired
+ *
+ * @param next The next record retired by the same thread
+ * @param epoch The global epoch when the object was retired
+ * @param free_fn Frees the object containing the record
+ *
+ */
+typedef struct epoch_retired {
+    struct epoch_retired *next;
+    unsigned long epoch;
+    void (*free_fn)(struct epoch_retired *retired);
+} epoch_retired_t;
+
+/**
+ * @brief The epoch state of one participating thread
+ * @note Owned by the caller, and used only by the thread it registers
+ *
+ * @param next The next registered thread
+ * @param domain The domain the thread is registered with
+ * @param state The epoch the thread entered at, shifted left by one, with
+ * the low bit set while it is inside a critical section
+ * @param depth Nesting depth of critical sections
+ * @param retired_head Oldest object retired and not yet freed
+ * @param retired_tail Newest object retired and not yet freed
+ * @param n_retired Number of objects retired and not yet freed
+ *
+ */
+typedef struct epoch_thread {
+    struct epoch_thread *next;
+    struct epoch_domain *domain;
+    unsigned long state;
+    unsigned int depth;
+    epoch_retired_t *retired_head;
+    epoch_retired_t *retired_tail;
+    size_t n_retired;
+} epoch_thread_t;
+
+/**
+ * @brief A set of threads sharing lock-free structures
+ *
+ * @param epoch The global epoch
+ * @param lock Protects the thread list and orphaned objects
+ * @param threads The registered threads
+ * @param orphans Objects left by threads that unregistered before they
+ * could be freed, oldest first
+ *
+ */
+typedef struct epoch_domain {
+    unsigned long epoch;
+    pthread_mutex_t lock;
+    epoch_thread_t *threads;
+    epoch_retired_t *orphans;
+} epoch_domain_t;
+
+// +---------------------------------------------------------------------------+
+// |                           Public Interface                                |
+// +---------------------------------------------------------------------------+
+
+/**
+ * @brief Initialise a domain
+ *
+ * @param domain A pointer to the domain object
+ * @return int 0 if successful, 1 otherwise
+ */
+int epoch_init(epoch_domain_t *domain);
+
+/**
+ * @brief Free every object still retired and destroy the domain
+ * @note No thread may be inside a critical section. Threads that are still
+ * registered must not be used again.
+ *
+ * @param domain A pointer to the domain object
+ */
+void epoch_destroy(epoch_domain_t *domain);
+
+/**
+ * @brief Register the calling thread with a domain
+ *
+ * @param domain A pointer to the domain object
+ * @param thread A pointer to the caller's thread state
+ * @return int 0 if successful, 1 otherwise
+ */
+int epoch_register(epoch_domain_t *domain, epoch_thread_t *thread);
+
+/**
+ * @brief Unregister a thread
+ * @note The thread must be outside any critical section. Objects it
+ * retired that cannot be freed yet are handed to the domain.
+ *
+ * @param thread A pointer to the thread state
+ */
+void epoch_unregister(epoch_thread_t *thread);
+
+/**
+ * @brief Enter a critical section, during which nodes read from shared
+ * structures stay allocated
+ * @note Critical sections may be nested
+ *
+ * @param thread A pointer to the calling thread's state
+ */
+void epoch_enter(epoch_thread_t *thread);
+
+/**
+ * @brief Leave a critical section
+ *
+ * @param thread A pointer to the calling thread's state
+ */
+void epoch_exit(epoch_thread_t *thread);
+
+/**
+ * @brief Free an object once no thread can hold a reference to it
+ * @note The object must already be unreachable from shared structures.
+ * Every `EPOCH_COLLECT_THRESHOLD` retirements, `epoch_collect` runs.
+ *
+ * @param thread A pointer to the calling thread's state
+ * @param retired The record embedded in the object
+ * @param free_fn Frees the object containing the record
+ */
+void epoch_retire(
+    epoch_thread_t *thread,
+    epoch_retired_t *retired,
+    void (*free_fn)(epoch_retired_t *retired)
+);
+
+/**
+ * @brief Try to advance the global epoch, then free the thread's retired
+ * objects that are now safe
+ *
+ * @param thread A pointer to the calling thread's state
+ * @return size_t The number of objects freed, including ones left by
+ * threads that unregistered
+ */
+size_t epoch_collect(epoch_thread_t *thread);
+
+/**
+ * @brief Get the number of objects the thread retired that are not yet freed
+ *
+ * @param thread A pointer to the thread state
+ * @return size_t
+ */
+size_t epoch_pending(epoch_thread_t *thread);
+
+#endif // EPOCH_H
@@ -0,0 +1,210 @@
+#include "threadpool.h"
+
+#include <stdlib.h>
+#include <unistd.h>
+
+static threadpool_t shared_pool;
+static pthread_once_t shared_pool_once = PTHREAD_ONCE_INIT;
+
+
+/**
+ * @brief Claims and runs tasks of the current job until none are left
+ *
+ * @param pool
+ * @param task
+ * @param ctx
+ * @param n_tasks
+ * @return size_t The number of tasks run
+ */
+static size_t run_tasks(
+    threadpool_t *pool,
+    void (*task)(void *ctx, size_t index),
+    void *ctx,
+    size_t n_tasks
+) {
+    size_t finished = 0;
+
+    for (;;) {
+        size_t index = __atomic_fetch_add(&pool->next_task, 1, __ATOMIC_RELAXED);
+
+        if (index >= n_tasks) {
+            break;
+        }
+
+        task(ctx, index);
+        finished++;
+    }
+
+    return finished;
+}
+
+
+static void *worker(void *arg) {
+    threadpool_t *pool = (threadpool_t *) arg;
+    unsigned long seen = 0;
+
+    pthread_mutex_lock(&pool->lock);
+
+    for (;;) {
+        while (!pool->shutdown && pool->generation == seen) {
+            pthread_cond_wait(&pool->work_cond, &pool->lock);
+        }
+
+        if (pool->shutdown) {
+            break;
+        }
+
+        // Take a snapshot of the job while holding the lock. The job cannot
+        // be replaced while this worker is active.
+        seen = pool->generation;
+        void (*task)(void *, size_t) = pool->task;
+        void *ctx = pool->ctx;
+        size_t n_tasks = pool->n_tasks;
+        pool->active++;
+
+        pthread_mutex_unlock(&pool->lock);
+        size_t finished = run_tasks(pool, task, ctx, n_tasks);
+        pthread_mutex_lock(&pool->lock);
+
+        pool->done_tasks += finished;
+        pool->active--;
+        pthread_cond_broadcast(&pool->done_cond);
+    }
+
+    pthread_mutex_unlock(&pool->lock);
+
+    return NULL;
+}
+
+
+int threadpool_init(threadpool_t *pool, size_t n_threads) {
+    pool->threads = NULL;
+    pool->n_threads = 0;
+    pool->task = NULL;
+    pool->ctx = NULL;
+    pool->n_tasks = 0;
+    pool->next_task = 0;
+    pool->done_tasks = 0;
+    pool->active = 0;
+    pool->generation = 0;
+    pool->shutdown = 0;
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_cond, NULL);
+    pthread_cond_init(&pool->done_cond, NULL);
+    pthread_mutex_init(&pool->run_lock, NULL);
+
+    if (n_threads == 0) {
+        return 0;
+    }
+
+    pool->threads = (pthread_t *) malloc(n_threads * sizeof(pthread_t));
+
+    if (!pool->threads) {
+        threadpool_destroy(pool);
+        return 1;
+    }
+
+    for (size_t i = 0; i < n_threads; i++) {
+        if (pthread_create(&pool->threads[i], NULL, worker, pool) != 0) {
+            threadpool_destroy(pool);
+            return 1;
+        }
+
+        pool->n_threads++;
+    }
+
+    return 0;
+}
+
+
+void threadpool_destroy(threadpool_t *pool) {
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = 1;
+    pthread_cond_broadcast(&pool->work_cond);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (size_t i = 0; i < pool->n_threads; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+
+    free(pool->threads);
+    pool->threads = NULL;
+    pool->n_threads = 0;
+
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->work_cond);
+    pthread_cond_destroy(&pool->done_cond);
+    pthread_mutex_destroy(&pool->run_lock);
+}
+
+
+size_t threadpool_size(threadpool_t *pool) {
+    return pool->n_threads;
+}
+
+
+static void shared_pool_init(void) {
+    long n_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+    // The calling thread also runs tasks
+    threadpool_init(&shared_pool, n_cpus > 1 ? n_cpus - 1 : 0);
+}
+
+threadpool_t *threadpool_shared(void) {
+    pthread_once(&shared_pool_once, shared_pool_init);
+
+    return &shared_pool;
+}
+
+
+int threadpool_run(
+    threadpool_t *pool,
+    size_t n_tasks,
+    void (*task)(void *ctx, size_t index),
+    void *ctx
+) {
+    if (n_tasks == 0) {
+        return 0;
+    }
+
+    // A single task is not worth waking the workers for
+    if (n_tasks == 1 || pool->n_threads == 0) {
+        for (size_t i = 0; i < n_tasks; i++) {
+            task(ctx, i);
+        }
+
+        return 0;
+    }
+
+    pthread_mutex_lock(&pool->run_lock);
+    pthread_mutex_lock(&pool->lock);
+
+    // Workers that woke late for the previous job may still hold a snapshot
+    while (pool->active > 0) {
+        pthread_cond_wait(&pool->done_cond, &pool->lock);
+    }
+
+    pool->task = task;
+    pool->ctx = ctx;
+    pool->n_tasks = n_tasks;
+    pool->next_task = 0;
+    pool->done_tasks = 0;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->work_cond);
+
+    pthread_mutex_unlock(&pool->lock);
+    size_t finished = run_tasks(pool, task, ctx, n_tasks);
+    pthread_mutex_lock(&pool->lock);
+
+    pool->done_tasks += finished;
+
+    while (pool->done_tasks < n_tasks || pool->active > 0) {
+        pthread_cond_wait(&pool->done_cond, &pool->lock);
+    }
+
+    pthread_mutex_unlock(&pool->lock);
+    pthread_mutex_unlock(&pool->run_lock);
+
+    return 0;
+}
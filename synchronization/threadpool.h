@@ -0,0 +1,90 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <pthread.h>
+#include <stddef.h>
+
+/**
+ * @brief A fixed set of worker threads that run batches of indexed tasks
+ *
+ * @param threads The worker threads
+ * @param n_threads Number of worker threads
+ * @param lock Protects the job state below
+ * @param work_cond Signalled when a job is published or the pool shuts down
+ * @param done_cond Signalled when a worker leaves a job
+ * @param run_lock Serialises callers of threadpool_run
+ *
+ */
+typedef struct threadpool {
+    pthread_t *threads;
+    size_t n_threads;
+    pthread_mutex_t lock;
+    pthread_cond_t work_cond;
+    pthread_cond_t done_cond;
+    pthread_mutex_t run_lock;
+
+    void (*task)(void *ctx, size_t index);  // Task of the current job
+    void *ctx;                              // User data of the current job
+    size_t n_tasks;                         // Number of tasks in the job
+    size_t next_task;                       // Next task index to claim
+    size_t done_tasks;                      // Number of finished tasks
+    size_t active;                          // Workers inside the job
+    unsigned long generation;               // Incremented for each job
+    int shutdown;
+} threadpool_t;
+
+/**
+ * @brief Initialise a thread pool and start its workers
+ *
+ * @param pool
+ * @param n_threads The number of worker threads. With 0 workers, jobs run
+ * on the calling thread.
+ * @return int 0 if successful, 1 otherwise
+ */
+int threadpool_init(threadpool_t *pool, size_t n_threads);
+
+/**
+ * @brief Stop the workers and free the pool
+ *
+ * @param pool
+ */
+void threadpool_destroy(threadpool_t *pool);
+
+/**
+ * @brief Get the number of worker threads
+ *
+ * @param pool
+ * @return size_t
+ */
+size_t threadpool_size(threadpool_t *pool);
+
+/**
+ * @brief Get the process-wide pool, started on first use
+ * @note It has one worker fewer than there are CPUs, since the calling
+ * thread also runs tasks. It is never destroyed.
+ *
+ * @return threadpool_t*
+ */
+threadpool_t *threadpool_shared(void);
+
+/**
+ * @brief Runs `task(ctx, i)` for every i in [0, n_tasks) and waits for them
+ * to finish
+ * @note The calling thread runs tasks as well. Tasks are claimed in index
+ * order but may finish in any order. Calling threadpool_run from inside a
+ * task of the same pool deadlocks.
+ *
+ * @param pool
+ * @param n_tasks The number of tasks
+ * @param task The function to run for each task index
+ * @param ctx User data passed to each task
+ * @return int 0 if successful, 1 otherwise
+ */
+int threadpool_run(
+    threadpool_t *pool,
+    size_t n_tasks,
+    void (*task)(void *ctx, size_t index),
+    void *ctx
+);
+
+#endif
@@ -1,7 +1,9 @@
 #include "../../data_structures/array.h"
+#include <fcntl.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
+#include <unistd.h>
 
 #include <gtest/gtest.h>
 
@@ -269,4 +271,665 @@ TEST(ArrayTest, SortDescending) {
     }
 
     array_destroy(array);
-}
\ No newline at end of file
+}
+
+TEST(ArrayTest, At) {
+    int items[] = {1, 2, 3, 4, 5};
+    void *array = raw_to_array(items, sizeof(int), 5);
+
+    for (int i = 0; i < 5; i++) {
+        int *item = (int *)array_at(array, i);
+        ASSERT_NE(item, nullptr);
+        EXPECT_EQ(*item, items[i]);
+    }
+
+    // Pointers refer to the array's own storage
+    *(int *)array_at(array, 2) = 30;
+    EXPECT_EQ(((int *)array)[2], 30);
+
+    EXPECT_EQ(array_at(array, 5), nullptr);
+
+    array_destroy(array);
+}
+
+TEST(ArrayTest, GetOutOfRange) {
+    int items[] = {1, 2, 3};
+    void *array = raw_to_array(items, sizeof(int), 3);
+
+    int item = -1;
+    EXPECT_EQ(array_get(array, 3, &item), nullptr);
+    EXPECT_EQ(item, -1);
+    EXPECT_EQ(array_get(array, 2, &item), array);
+    EXPECT_EQ(item, 3);
+
+    array_destroy(array);
+}
+
+TEST(ArrayTest, Back) {
+    void *array = array_init(sizeof(int), 0);
+    EXPECT_EQ(array_back(array), nullptr);
+
+    int items[] = {1, 2, 3};
+    for (int i = 0; i < 3; i++) {
+        array = array_append(array, &items[i]);
+        EXPECT_EQ(*(int *)array_back(array), items[i]);
+    }
+
+    array_destroy(array);
+}
+
+TEST(ArrayTest, DataRange) {
+    int items[] = {1, 2, 3, 4, 5};
+    void *array = raw_to_array(items, sizeof(int), 5);
+
+    int *range = (int *)array_data_range(array, 1, 4);
+    ASSERT_NE(range, nullptr);
+    EXPECT_EQ(range[0], 2);
+    EXPECT_EQ(range[2], 4);
+
+    EXPECT_NE(array_data_range(array, 5, 5), nullptr);
+    EXPECT_EQ(array_data_range(array, 3, 2), nullptr);
+    EXPECT_EQ(array_data_range(array, 0, 6), nullptr);
+
+    array_destroy(array);
+}
+
+TEST(ArrayTest, Slice) {
+    int items[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    void *array = raw_to_array(items, sizeof(int), 10);
+
+    struct array_view view = array_slice(array, 1, 8, 3);
+    ASSERT_EQ(view.length, 3);
+    EXPECT_EQ(view.stride, 3 * sizeof(int));
+    EXPECT_EQ(*(int *)array_view_at(view, 0), 1);
+    EXPECT_EQ(*(int *)array_view_at(view, 1), 4);
+    EXPECT_EQ(*(int *)array_view_at(view, 2), 7);
+    EXPECT_EQ(array_view_at(view, 3), nullptr);
+
+    struct array_view sub = array_view_slice(view, 1, 3, 1);
+    ASSERT_EQ(sub.length, 2);
+    EXPECT_EQ(*(int *)array_view_at(sub, 0), 4);
+    EXPECT_EQ(*(int *)array_view_at(sub, 1), 7);
+
+    EXPECT_EQ(array_slice(array, 0, 10, 0).length, 0);
+    EXPECT_EQ(array_slice(array, 4, 11, 1).length, 0);
+
+    array_destroy(array);
+}
+
+
+TEST(ArrayTest, GrowthIsGeometric) {
+    void *array = array_init(sizeof(int), 0);
+
+    for (int i = 0; i < 100; i++) {
+        array = array_append(array, &i);
+    }
+
+    EXPECT_EQ(array_length(array), 100);
+    EXPECT_GE(array_capacity(array), 100);
+    EXPECT_LT(array_capacity(array), 200);
+
+    array_destroy(array);
+}
+
+TEST(ArrayTest, ResizeTruncates) {
+    int items[] = {1, 2, 3, 4, 5};
+    void *array = raw_to_array(items, sizeof(int), 5);
+
+    array = array_resize(array, 2);
+    EXPECT_EQ(array_length(array), 2);
+    EXPECT_EQ(array_capacity(array), 2);
+
+    array_destroy(array);
+}
+
+TEST(ArrayTest, MmapCreateAndOpen) {
+    char path[] = "/tmp/test_array_mmap_XXXXXX";
+    close(mkstemp(path));
+
+    int *array = (int *)array_mmap_create(path, sizeof(int), 4);
+    ASSERT_NE(array, nullptr);
+    EXPECT_EQ(array_length(array), 0);
+    EXPECT_EQ(array_capacity(array), 4);
+
+    // Grow past the initial capacity to extend the file
+    for (int i = 0; i < 1000; i++) {
+        int item = 999 - i;
+        array = (int *)array_append(array, &item);
+        ASSERT_NE(array, nullptr);
+    }
+    EXPECT_EQ(array_mmap_advise(array, ARRAY_ADVICE_SEQUENTIAL), 0);
+    EXPECT_EQ(array_mmap_sync(array), 0);
+    array_destroy(array);
+
+    // Read-only changes stay private
+    array = (int *)array_mmap_open(path, sizeof(int), 0);
+    ASSERT_NE(array, nullptr);
+    ASSERT_EQ(array_length(array), 1000);
+    array_sort(array, [](const void *a, const void *b) -> int {
+        return *(int *)a - *(int *)b;
+    });
+    EXPECT_EQ(array[0], 0);
+    EXPECT_EQ(array[999], 999);
+    array_destroy(array);
+
+    array = (int *)array_mmap_open(path, sizeof(int), 1);
+    ASSERT_NE(array, nullptr);
+    EXPECT_EQ(array[0], 999);
+    int item;
+    array_get(array, 999, &item);
+    EXPECT_EQ(item, 0);
+    array_destroy(array);
+
+    // Mismatched item size
+    EXPECT_EQ(array_mmap_open(path, sizeof(double), 0), nullptr);
+    EXPECT_EQ(array_mmap_open("/nonexistent/array", sizeof(int), 0), nullptr);
+
+    unlink(path);
+}
+
+TEST(ArrayTest, MmapReadOnlyGrowth) {
+    char path[] = "/tmp/test_array_mmap_XXXXXX";
+    close(mkstemp(path));
+
+    int items[] = {1, 2, 3};
+    int *array = (int *)array_mmap_create(path, sizeof(int), 3);
+    for (int i = 0; i < 3; i++) {
+        array = (int *)array_append(array, &items[i]);
+    }
+    array_destroy(array);
+
+    array = (int *)array_mmap_open(path, sizeof(int), 0);
+    ASSERT_NE(array, nullptr);
+    int item = 4;
+    array = (int *)array_append(array, &item);
+    ASSERT_EQ(array_length(array), 4);
+    EXPECT_EQ(array[3], 4);
+    EXPECT_EQ(array_mmap_advise(array, ARRAY_ADVICE_RANDOM), 1);
+    array_destroy(array);
+
+    // The file is unchanged
+    array = (int *)array_mmap_open(path, sizeof(int), 0);
+    EXPECT_EQ(array_length(array), 3);
+    array_destroy(array);
+
+    unlink(path);
+}
+
+TEST(ArrayTest, MmapFileHeader) {
+    char path[] = "/tmp/test_array_mmap_XXXXXX";
+    close(mkstemp(path));
+
+    int items[] = {1, 2, 3};
+    int *array = (int *)array_mmap_create(path, sizeof(int), 3);
+    for (int i = 0; i < 3; i++) {
+        array = (int *)array_append(array, &items[i]);
+    }
+    array_destroy(array);
+
+    // Runtime state after the file header is never read back
+    int fd = open(path, O_RDWR);
+    char junk[64];
+    memset(junk, 0x5a, sizeof(junk));
+    ASSERT_EQ(pwrite(fd, junk, sizeof(junk), 64), (ssize_t)sizeof(junk));
+
+    array = (int *)array_mmap_open(path, sizeof(int), 1);
+    ASSERT_NE(array, nullptr);
+    EXPECT_EQ(array_length(array), 3);
+    EXPECT_EQ(array_capacity(array), 3);
+    EXPECT_TRUE(array_is_unique(array));
+    EXPECT_EQ(array_alignment(array), 0);
+    EXPECT_EQ(array[2], 3);
+
+    // The last owner stores the length
+    int *share = (int *)array_share(array);
+    share = (int *)array_pop(share, NULL);
+    array = (int *)array_pop(array, NULL);
+    array_destroy(share);
+    array_destroy(array);
+
+    array = (int *)array_mmap_open(path, sizeof(int), 0);
+    ASSERT_NE(array, nullptr);
+    EXPECT_EQ(array_length(array), 2);
+    EXPECT_TRUE(array_is_unique(array));
+    array_destroy(array);
+
+    // Unknown version
+    unsigned char byte = 0xff;
+    ASSERT_EQ(pwrite(fd, &byte, 1, 4), 1);
+    EXPECT_EQ(array_mmap_open(path, sizeof(int), 0), nullptr);
+
+    // Unknown magic
+    ASSERT_EQ(pwrite(fd, &byte, 1, 0), 1);
+    EXPECT_EQ(array_mmap_open(path, sizeof(int), 0), nullptr);
+
+    close(fd);
+    unlink(path);
+}
+
+
+TEST(ArrayTest, Share) {
+    int items[] = {3, 1, 2};
+    void *array = raw_to_array(items, sizeof(int), 3);
+    EXPECT_TRUE(array_is_unique(array));
+
+    void *shared = array_share(array);
+    EXPECT_EQ(shared, array);
+    EXPECT_FALSE(array_is_unique(array));
+
+    // Mutating one owner copies the buffer
+    int item = 4;
+    shared = array_append(shared, &item);
+    EXPECT_NE(shared, array);
+    EXPECT_TRUE(array_is_unique(array));
+    EXPECT_TRUE(array_is_unique(shared));
+    EXPECT_EQ(array_length(array), 3);
+    EXPECT_EQ(array_length(shared), 4);
+
+    array_destroy(shared);
+    array_destroy(array);
+}
+
+TEST(ArrayTest, ShareGrowthFailure) {
+    int items[] = {3, 1, 2};
+    int *array = (int *)raw_to_array(items, sizeof(int), 3);
+    int *shared = (int *)array_share(array);
+
+    // Sizes that overflow fail before either owner is released
+    EXPECT_EQ(array_set_length(shared, SIZE_MAX / 2), nullptr);
+    EXPECT_EQ(array_insert_range(shared, 0, items, SIZE_MAX / 2), nullptr);
+    EXPECT_FALSE(array_is_unique(array));
+    ASSERT_EQ(array_length(shared), 3);
+    EXPECT_EQ(shared[2], 2);
+
+    // Growing a shared array copies it once, into the capacity needed
+    shared = (int *)array_set_length(shared, 5);
+    ASSERT_NE(shared, nullptr);
+    EXPECT_NE(shared, array);
+    EXPECT_TRUE(array_is_unique(array));
+    EXPECT_EQ(array_length(array), 3);
+    EXPECT_EQ(array_capacity(shared), 5);
+    EXPECT_EQ(shared[1], 1);
+
+    array_destroy(shared);
+    array_destroy(array);
+}
+
+TEST(ArrayTest, ShareMutations) {
+    int items[] = {3, 1, 2};
+    void *array = raw_to_array(items, sizeof(int), 3);
+
+    void *sorted = array_sort(array_share(array), [](const void *a, const void *b) -> int {
+        return *(int *)a - *(int *)b;
+    });
+    EXPECT_NE(sorted, array);
+    EXPECT_EQ(((int *)array)[0], 3);
+    EXPECT_EQ(((int *)sorted)[0], 1);
+
+    int item;
+    void *popped = array_pop(array_share(array), &item);
+    EXPECT_EQ(item, 2);
+    EXPECT_EQ(array_length(popped), 2);
+    EXPECT_EQ(array_length(array), 3);
+
+    void *resized = array_resize(array_share(array), 1);
+    EXPECT_EQ(array_length(resized), 1);
+    EXPECT_EQ(array_length(array), 3);
+
+    void *shuffled = array_shuffle(array_share(array));
+    EXPECT_NE(shuffled, array);
+
+    // A unique array is mutated in place
+    EXPECT_EQ(array_sort(array, [](const void *a, const void *b) -> int {
+        return *(int *)b - *(int *)a;
+    }), array);
+    EXPECT_EQ(((int *)array)[0], 3);
+    EXPECT_EQ(((int *)array)[2], 1);
+
+    array_destroy(sorted);
+    array_destroy(popped);
+    array_destroy(resized);
+    array_destroy(shuffled);
+    array_destroy(array);
+}
+
+TEST(ArrayTest, Unshare) {
+    int items[] = {1, 2, 3};
+    void *array = raw_to_array(items, sizeof(int), 3);
+
+    EXPECT_EQ(array_unshare(array), array);
+
+    void *shared = array_share(array);
+    int *copy = (int *)array_unshare(shared);
+    ASSERT_NE(copy, nullptr);
+    EXPECT_NE((void *)copy, array);
+    copy[0] = 10;
+    EXPECT_EQ(((int *)array)[0], 1);
+    EXPECT_TRUE(array_is_unique(array));
+
+    array_destroy(copy);
+    array_destroy(array);
+}
+
+
+TEST(ArrayTest, InsertRange) {
+    int items[] = {1, 5};
+    int insert[] = {2, 3, 4};
+    void *array = raw_to_array(items, sizeof(int), 2);
+
+    array = array_insert_range(array, 1, insert, 3);
+    ASSERT_EQ(array_length(array), 5);
+    for (int i = 0; i < 5; i++) {
+        EXPECT_EQ(((int *)array)[i], i + 1);
+    }
+
+    // Insert at the end and the start
+    int six = 6, zero = 0;
+    array = array_insert_range(array, 5, &six, 1);
+    array = array_insert_range(array, 0, &zero, 1);
+    ASSERT_EQ(array_length(array), 7);
+    for (int i = 0; i < 7; i++) {
+        EXPECT_EQ(((int *)array)[i], i);
+    }
+
+    // Out of range
+    EXPECT_EQ(array_insert_range(array, 8, insert, 3), array);
+    EXPECT_EQ(array_length(array), 7);
+
+    array_destroy(array);
+}
+
+TEST(ArrayTest, EraseRange) {
+    int items[] = {0, 1, 2, 3, 4, 5};
+    void *array = raw_to_array(items, sizeof(int), 6);
+
+    array = array_erase_range(array, 1, 3);
+    ASSERT_EQ(array_length(array), 4);
+    int expected[] = {0, 3, 4, 5};
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(((int *)array)[i], expected[i]);
+    }
+
+    array = array_erase_range(array, 2, 5);
+    EXPECT_EQ(array_length(array), 4);
+
+    array = array_erase_range(array, 0, 4);
+    EXPECT_EQ(array_length(array), 0);
+
+    array_destroy(array);
+}
+
+TEST(ArrayTest, RemoveIf) {
+    int items[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    void *array = raw_to_array(items, sizeof(int), 10);
+    void *shared = array_share(array);
+
+    // Remove multiples of n
+    int n = 3;
+    shared = array_remove_if(shared, [](const void *item, void *ctx) -> int {
+        return *(const int *)item % *(int *)ctx == 0;
+    }, &n);
+
+    int expected[] = {1, 2, 4, 5, 7, 8, 10};
+    ASSERT_EQ(array_length(shared), 7);
+    for (int i = 0; i < 7; i++) {
+        EXPECT_EQ(((int *)shared)[i], expected[i]);
+    }
+
+    // The other owner is unaffected
+    EXPECT_EQ(array_length(array), 10);
+
+    array_destroy(shared);
+    array_destroy(array);
+}
+
+TEST(ArrayTest, Unique) {
+    int items[] = {1, 1, 2, 3, 3, 3, 4, 5, 5};
+    void *array = raw_to_array(items, sizeof(int), 9);
+
+    array = array_unique(array, [](const void *a, const void *b) -> int {
+        return *(int *)a - *(int *)b;
+    });
+
+    ASSERT_EQ(array_length(array), 5);
+    for (int i = 0; i < 5; i++) {
+        EXPECT_EQ(((int *)array)[i], i + 1);
+    }
+
+    array_destroy(array);
+}
+
+
+TEST(ArrayTest, SetLength) {
+    int *array = (int *)array_init(sizeof(int), 0);
+
+    array = (int *)array_set_length(array, 10);
+    ASSERT_EQ(array_length(array), 10);
+    EXPECT_GE(array_capacity(array), 10);
+
+    for (int i = 0; i < 10; i++) {
+        array[i] = i;
+    }
+
+    array = (int *)array_set_length(array, 4);
+    EXPECT_EQ(array_length(array), 4);
+    EXPECT_EQ(array[3], 3);
+
+    array_destroy(array);
+}
+
+TEST(ArrayTest, InitAligned) {
+    for (size_t alignment : {1, 16, 32, 64, 4096}) {
+        int *array = (int *) array_init_aligned(sizeof(int), 10, alignment);
+        ASSERT_NE(array, nullptr);
+
+        EXPECT_EQ((uintptr_t)array % alignment, 0u);
+        EXPECT_EQ(array_length(array), 10);
+        EXPECT_EQ(array_capacity(array), 10);
+        EXPECT_EQ(array_item_size(array), sizeof(int));
+        EXPECT_EQ(array_alignment(array), alignment);
+
+        array_destroy(array);
+    }
+
+    EXPECT_EQ(array_init_aligned(sizeof(int), 10, 0), nullptr);
+    EXPECT_EQ(array_init_aligned(sizeof(int), 10, 48), nullptr);
+    EXPECT_EQ(array_init_aligned(sizeof(int), 10, 1 << 30), nullptr);
+
+    void *array = array(int);
+    EXPECT_EQ(array_alignment(array), 0);
+    array_destroy(array);
+}
+
+TEST(ArrayTest, AlignedGrowth) {
+    int *array = (int *) array_init_aligned(sizeof(int), 0, 64);
+
+    // Grows past ARRAY_HUGE_PAGE_THRESHOLD, moving from the heap to a mapping
+    size_t n = 2 * ARRAY_HUGE_PAGE_THRESHOLD / sizeof(int);
+
+    for (size_t i = 0; i < n; i++) {
+        int item = i;
+        array = (int *) array_append(array, &item);
+        ASSERT_EQ((uintptr_t)array % 64, 0u);
+    }
+
+    ASSERT_EQ(array_length(array), n);
+    for (size_t i = 0; i < n; i++) {
+        ASSERT_EQ(array[i], (int)i);
+    }
+
+    // Shrinking back below the threshold moves it to the heap again
+    array = (int *) array_resize(array, 100);
+    ASSERT_NE(array, nullptr);
+    EXPECT_EQ((uintptr_t)array % 64, 0u);
+    EXPECT_EQ(array_length(array), 100);
+    EXPECT_EQ(array[99], 99);
+
+    array_destroy(array);
+}
+
+TEST(ArrayTest, AlignedHugeCopyAndShare) {
+    size_t n = ARRAY_HUGE_PAGE_THRESHOLD / sizeof(double);
+    double *array = (double *) array_init_aligned(sizeof(double), n, 4096);
+    ASSERT_NE(array, nullptr);
+    EXPECT_EQ((uintptr_t)array % 4096, 0u);
+
+    for (size_t i = 0; i < n; i++) {
+        array[i] = i * 0.5;
+    }
+
+    EXPECT_EQ(array_mmap_advise(array, ARRAY_ADVICE_SEQUENTIAL), 0);
+
+    double *copy = (double *) array_copy(array);
+    ASSERT_NE(copy, nullptr);
+    EXPECT_EQ((uintptr_t)copy % 4096, 0u);
+    EXPECT_EQ(array_alignment(copy), 4096);
+    EXPECT_EQ(copy[n - 1], (n - 1) * 0.5);
+
+    // Unsharing keeps the alignment of the original
+    double *shared = (double *) array_share(array);
+    double item = -1;
+    shared = (double *) array_append(shared, &item);
+    ASSERT_NE(shared, nullptr);
+    EXPECT_EQ((uintptr_t)shared % 4096, 0u);
+    EXPECT_EQ(array_length(array), n);
+    EXPECT_EQ(array_length(shared), n + 1);
+    EXPECT_EQ(shared[n], -1);
+
+    array_destroy(array);
+    array_destroy(copy);
+    array_destroy(shared);
+}
+
+TEST(ArrayTest, InitOverflow) {
+    EXPECT_EQ(array_init(1, SIZE_MAX - 40), nullptr);
+    EXPECT_EQ(array_init(16, SIZE_MAX / 16), nullptr);
+    EXPECT_EQ(array_init_aligned(1, SIZE_MAX - 40, 64), nullptr);
+
+    int *array = (int *) array_init(sizeof(int), 0);
+    EXPECT_EQ(array_resize(array, SIZE_MAX / 2), nullptr);
+    array_destroy(array);
+}
+
+TEST(ArrayTest, InitInline) {
+    array_storage(int, 16) storage;
+    int *array = (int *) array_init_inline(&storage, sizeof(storage), sizeof(int));
+    ASSERT_NE(array, nullptr);
+
+    EXPECT_EQ((void *)array, (void *)(&storage.header + 1));
+    EXPECT_EQ(array_length(array), 0);
+    EXPECT_EQ(array_capacity(array), 16);
+    EXPECT_EQ(array_is_inline(array), 1);
+
+    // Fits in the storage, so nothing is allocated
+    for (int i = 0; i < 16; i++) {
+        int *appended = (int *) array_append(array, &i);
+        ASSERT_EQ(appended, array);
+    }
+
+    EXPECT_EQ(array_is_inline(array), 1);
+
+    int item;
+    array_get(array, 15, &item);
+    EXPECT_EQ(item, 15);
+
+    array_pop(array, &item);
+    EXPECT_EQ(item, 15);
+    EXPECT_EQ(array_length(array), 15);
+
+    array_destroy(array);
+
+    char small[sizeof(struct array_header) - 1];
+    EXPECT_EQ(array_init_inline(small, sizeof(small), sizeof(int)), nullptr);
+}
+
+TEST(ArrayTest, InlineSpill) {
+    array_storage(int, 4) storage;
+    int *array = (int *) array_init_inline(&storage, sizeof(storage), sizeof(int));
+
+    for (int i = 0; i < 100; i++) {
+        array = (int *) array_append(array, &i);
+        ASSERT_NE(array, nullptr);
+        ASSERT_EQ(array_is_inline(array), i < 4);
+    }
+
+    EXPECT_EQ(array_length(array), 100);
+    for (int i = 0; i < 100; i++) {
+        ASSERT_EQ(array[i], i);
+    }
+
+    // Frees the heap copy only
+    array_destroy(array);
+}
+
+static int *share_from_frame(void) {
+    array_storage(int, 4) storage;
+    int *array = (int *) array_init_inline(&storage, sizeof(storage), sizeof(int));
+
+    for (int i = 0; i < 4; i++) {
+        array = (int *) array_append(array, &i);
+    }
+
+    int *shared = (int *) array_share(array);
+    array_destroy(array);
+
+    return shared;
+}
+
+TEST(ArrayTest, InlineShareOutlivesStorage) {
+    int *shared = share_from_frame();
+    ASSERT_NE(shared, nullptr);
+
+    // Overwrite the dead frame before reading the share
+    volatile char scratch[256];
+    memset((char *) scratch, 0x5a, sizeof(scratch));
+
+    EXPECT_EQ(array_is_inline(shared), 0);
+    EXPECT_EQ(array_is_unique(shared), 1);
+    ASSERT_EQ(array_length(shared), 4);
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(shared[i], i);
+    }
+
+    int item = 4;
+    shared = (int *) array_append(shared, &item);
+    EXPECT_EQ(shared[4], 4);
+
+    array_destroy(shared);
+}
+
+TEST(ArrayTest, InlineResizeShareCopy) {
+    array_storage(double, 8) storage;
+    double *array = (double *) array_init_inline(&storage, sizeof(storage), sizeof(double));
+    array = (double *) array_set_length(array, 8);
+
+    for (int i = 0; i < 8; i++) {
+        array[i] = i;
+    }
+
+    // Shrinking keeps the storage
+    array = (double *) array_resize(array, 4);
+    EXPECT_EQ(array_is_inline(array), 1);
+    EXPECT_EQ(array_length(array), 4);
+    EXPECT_EQ(array_capacity(array), 8);
+
+    double *copy = (double *) array_copy(array);
+    EXPECT_EQ(array_is_inline(copy), 0);
+    EXPECT_EQ(copy[3], 3);
+
+    // Sharing an inline array gives the other owner a heap copy
+    double *shared = (double *) array_share(array);
+    EXPECT_EQ(array_is_inline(shared), 0);
+    EXPECT_EQ(array_is_unique(array), 1);
+    double item = 9;
+    shared = (double *) array_append(shared, &item);
+    EXPECT_EQ(array_is_inline(shared), 0);
+    EXPECT_EQ(array_length(array), 4);
+    EXPECT_EQ(array_length(shared), 5);
+
+    EXPECT_EQ(array_mmap_advise(array, ARRAY_ADVICE_NORMAL), 1);
+
+    array_destroy(shared);
+    array_destroy(copy);
+    array_destroy(array);
+}
@@ -0,0 +1,241 @@
+#include "../../data_structures/array_io.h"
+#include "../../data_structures/array_kernels.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+
+static const enum array_simd_level levels[] = {ARRAY_SIMD_SCALAR, ARRAY_SIMD_SSE42};
+
+static int temp_file(void) {
+    char path[] = "/tmp/array_io_XXXXXX";
+    int fd = mkstemp(path);
+    unlink(path);
+
+    return fd;
+}
+
+static int *iota(size_t n) {
+    int *array = (int *) array_init(sizeof(int), n);
+    for (size_t i = 0; i < n; i++) {
+        array[i] = i * 3;
+    }
+
+    return array;
+}
+
+
+TEST(ArrayIO, WriteRead) {
+    for (unsigned int flags : {0u, (unsigned int) ARRAY_IO_CHECKSUM}) {
+        int fd = temp_file();
+        int *array = iota(100000);
+
+        ASSERT_EQ(array_write(array, fd, flags), 0);
+        lseek(fd, 0, SEEK_SET);
+
+        int *read = (int *) array_read(fd, sizeof(int));
+        ASSERT_NE(read, nullptr);
+        ASSERT_EQ(array_length(read), 100000);
+        EXPECT_EQ(array_item_size(read), sizeof(int));
+        EXPECT_EQ(memcmp(read, array, 100000 * sizeof(int)), 0);
+
+        array_destroy(array);
+        array_destroy(read);
+        close(fd);
+    }
+}
+
+TEST(ArrayIO, Empty) {
+    int fd = temp_file();
+    void *array = array(double);
+
+    ASSERT_EQ(array_write(array, fd, ARRAY_IO_CHECKSUM), 0);
+    lseek(fd, 0, SEEK_SET);
+
+    // An item size of 0 accepts whatever is in the file
+    void *read = array_read(fd, 0);
+    ASSERT_NE(read, nullptr);
+    EXPECT_EQ(array_length(read), 0);
+    EXPECT_EQ(array_item_size(read), sizeof(double));
+
+    array_destroy(array);
+    array_destroy(read);
+    close(fd);
+}
+
+TEST(ArrayIO, Rejects) {
+    int fd = temp_file();
+    int *array = iota(1000);
+    array_write(array, fd, ARRAY_IO_CHECKSUM);
+
+    // Wrong item size
+    lseek(fd, 0, SEEK_SET);
+    EXPECT_EQ(array_read(fd, sizeof(double)), nullptr);
+
+    // Corrupted item
+    int bad = -1;
+    pwrite(fd, &bad, sizeof(bad), sizeof(struct array_file_header) + 500 * sizeof(int));
+    lseek(fd, 0, SEEK_SET);
+    EXPECT_EQ(array_read(fd, sizeof(int)), nullptr);
+
+    // Truncated payload
+    ftruncate(fd, sizeof(struct array_file_header) + 10);
+    lseek(fd, 0, SEEK_SET);
+    EXPECT_EQ(array_read(fd, sizeof(int)), nullptr);
+
+    // Bad magic
+    uint32_t magic = 0;
+    pwrite(fd, &magic, sizeof(magic), 0);
+    lseek(fd, 0, SEEK_SET);
+    EXPECT_EQ(array_read(fd, sizeof(int)), nullptr);
+
+    array_destroy(array);
+    close(fd);
+}
+
+TEST(ArrayIO, RejectsOverflowingLength) {
+    int fd = temp_file();
+
+    // Length times item size fits, but not with the array's own header
+    struct array_file_header header;
+    memset(&header, 0, sizeof(header));
+    header.magic = ARRAY_IO_MAGIC;
+    header.version = ARRAY_IO_VERSION;
+    header.item_size = 1;
+    header.length = SIZE_MAX - 40;
+    ASSERT_EQ(write(fd, &header, sizeof(header)), (ssize_t)sizeof(header));
+
+    lseek(fd, 0, SEEK_SET);
+    EXPECT_EQ(array_read(fd, 1), nullptr);
+
+    array_reader_t reader;
+    lseek(fd, 0, SEEK_SET);
+    EXPECT_EQ(array_reader_open(&reader, fd, 1), 1);
+
+    close(fd);
+}
+
+TEST(ArrayIO, ChecksumTiers) {
+    int *array = iota(12345);
+
+    for (enum array_simd_level level : levels) {
+        array_simd_set_level(level);
+
+        int fd = temp_file();
+        array_write(array, fd, ARRAY_IO_CHECKSUM);
+
+        // Every tier must compute the same checksum
+        array_simd_set_level(level == ARRAY_SIMD_SCALAR ? ARRAY_SIMD_SSE42 : ARRAY_SIMD_SCALAR);
+        lseek(fd, 0, SEEK_SET);
+
+        void *read = array_read(fd, sizeof(int));
+        ASSERT_NE(read, nullptr);
+        array_destroy(read);
+        close(fd);
+    }
+
+    array_simd_set_level(ARRAY_SIMD_AVX2);
+    array_destroy(array);
+}
+
+TEST(ArrayIO, Streaming) {
+    int fd = temp_file();
+
+    // Something before the array, to check offsets are respected
+    write(fd, "xyz", 3);
+
+    array_writer_t writer;
+    ASSERT_EQ(array_writer_open(&writer, fd, sizeof(int), ARRAY_IO_CHECKSUM), 0);
+
+    int *chunk = (int *) array_init(sizeof(int), 1000);
+    for (int c = 0; c < 10; c++) {
+        for (int i = 0; i < 1000; i++) {
+            chunk[i] = c * 1000 + i;
+        }
+
+        ASSERT_EQ(array_writer_write(&writer, chunk, 1000), 0);
+    }
+
+    ASSERT_EQ(array_writer_finish(&writer), 0);
+    array_destroy(chunk);
+
+    // The whole array can be read at once
+    lseek(fd, 3, SEEK_SET);
+    int *all = (int *) array_read(fd, sizeof(int));
+    ASSERT_NE(all, nullptr);
+    ASSERT_EQ(array_length(all), 10000);
+    EXPECT_EQ(all[9999], 9999);
+    array_destroy(all);
+
+    // Or a chunk at a time, reusing one array
+    lseek(fd, 3, SEEK_SET);
+    array_reader_t reader;
+    ASSERT_EQ(array_reader_open(&reader, fd, sizeof(int)), 0);
+    EXPECT_EQ(array_reader_length(&reader), 10000);
+
+    int *buffer = (int *) array(int);
+    size_t total = 0;
+
+    for (;;) {
+        buffer = (int *) array_reader_read(&reader, buffer, 3000);
+        ASSERT_NE(buffer, nullptr);
+
+        if (array_length(buffer) == 0) {
+            break;
+        }
+
+        for (size_t i = 0; i < array_length(buffer); i++) {
+            ASSERT_EQ(buffer[i], (int)(total + i));
+        }
+
+        total += array_length(buffer);
+    }
+
+    EXPECT_EQ(total, 10000);
+    EXPECT_EQ(array_capacity(buffer), 3000);
+
+    array_destroy(buffer);
+    close(fd);
+}
+
+TEST(ArrayIO, StreamingCorrupt) {
+    int fd = temp_file();
+    int *array = iota(100);
+    array_write(array, fd, ARRAY_IO_CHECKSUM);
+
+    int bad = -1;
+    pwrite(fd, &bad, sizeof(bad), sizeof(struct array_file_header) + 99 * sizeof(int));
+    lseek(fd, 0, SEEK_SET);
+
+    array_reader_t reader;
+    ASSERT_EQ(array_reader_open(&reader, fd, sizeof(int)), 0);
+
+    // The checksum is only known once the last chunk is read
+    void *chunk = array_reader_read(&reader, NULL, 60);
+    ASSERT_NE(chunk, nullptr);
+    EXPECT_EQ(array_reader_read(&reader, chunk, 60), nullptr);
+
+    // The caller's array is emptied, not freed
+    EXPECT_EQ(array_length(chunk), 0);
+    int item = 1;
+    chunk = array_append(chunk, &item);
+    ASSERT_NE(chunk, nullptr);
+    array_destroy(chunk);
+
+    // Nor is one too small for the chunk, which is read into a new array
+    ftruncate(fd, sizeof(struct array_file_header) + 50 * sizeof(int));
+    lseek(fd, 0, SEEK_SET);
+    ASSERT_EQ(array_reader_open(&reader, fd, sizeof(int)), 0);
+
+    int *small = (int *)array_init(sizeof(int), 0);
+    small = (int *)array_append(small, &item);
+    EXPECT_EQ(array_reader_read(&reader, small, 100), nullptr);
+    ASSERT_EQ(array_length(small), 1);
+    EXPECT_EQ(small[0], 1);
+    array_destroy(small);
+
+    array_destroy(array);
+    close(fd);
+}
@@ -0,0 +1,194 @@
+#include "../../data_structures/array_kernels.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <gtest/gtest.h>
+
+
+// Runs each test at every instruction set supported by the CPU
+class ArrayKernelsTest : public ::testing::TestWithParam<enum array_simd_level> {
+protected:
+    void SetUp() override {
+        if (array_simd_set_level(GetParam()) != GetParam()) {
+            GTEST_SKIP() << "Instruction set not supported";
+        }
+    }
+};
+
+TEST_P(ArrayKernelsTest, FindInt) {
+    // Odd length to exercise the scalar tail
+    int32_t *array = (int32_t *)array_init(sizeof(int32_t), 37);
+    for (int i = 0; i < 37; i++) {
+        array[i] = i * 2;
+    }
+
+    for (int i = 0; i < 37; i++) {
+        int32_t value = i * 2;
+        EXPECT_EQ(array_find_eq(array, ARRAY_INT32, &value), (size_t)i);
+    }
+
+    int32_t missing = 3;
+    EXPECT_EQ(array_find_eq(array, ARRAY_INT32, &missing), 37);
+
+    array_destroy(array);
+}
+
+TEST_P(ArrayKernelsTest, FindFloatAndDouble) {
+    float *floats = (float *)array_init(sizeof(float), 19);
+    double *doubles = (double *)array_init(sizeof(double), 19);
+
+    for (int i = 0; i < 19; i++) {
+        floats[i] = i * 0.5f;
+        doubles[i] = i * 0.25;
+    }
+
+    float f = 8.5f;
+    double d = 4.5;
+    EXPECT_EQ(array_find_eq(floats, ARRAY_FLOAT, &f), 17);
+    EXPECT_EQ(array_find_eq(doubles, ARRAY_DOUBLE, &d), 18);
+
+    f = 0.3f;
+    EXPECT_EQ(array_find_eq(floats, ARRAY_FLOAT, &f), 19);
+
+    array_destroy(floats);
+    array_destroy(doubles);
+}
+
+TEST_P(ArrayKernelsTest, Count) {
+    int32_t *ints = (int32_t *)array_init(sizeof(int32_t), 101);
+    float *floats = (float *)array_init(sizeof(float), 101);
+    double *doubles = (double *)array_init(sizeof(double), 101);
+
+    for (int i = 0; i < 101; i++) {
+        ints[i] = i % 3;
+        floats[i] = (float)(i % 3);
+        doubles[i] = i % 3;
+    }
+
+    int32_t i = 1;
+    float f = 2;
+    double d = 0;
+    EXPECT_EQ(array_count_if_eq(ints, ARRAY_INT32, &i), 34);
+    EXPECT_EQ(array_count_if_eq(floats, ARRAY_FLOAT, &f), 33);
+    EXPECT_EQ(array_count_if_eq(doubles, ARRAY_DOUBLE, &d), 34);
+
+    array_destroy(ints);
+    array_destroy(floats);
+    array_destroy(doubles);
+}
+
+TEST_P(ArrayKernelsTest, MinMax) {
+    int32_t *ints = (int32_t *)array_init(sizeof(int32_t), 53);
+    double *doubles = (double *)array_init(sizeof(double), 53);
+
+    srand(7);
+    for (int i = 0; i < 53; i++) {
+        ints[i] = rand() % 1000 - 500;
+        doubles[i] = ints[i] / 4.0;
+    }
+    ints[41] = -1000;
+    ints[12] = 1000;
+    doubles[50] = -1000;
+    doubles[0] = 1000;
+
+    int32_t imin, imax;
+    ASSERT_EQ(array_min(ints, ARRAY_INT32, &imin), 0);
+    ASSERT_EQ(array_max(ints, ARRAY_INT32, &imax), 0);
+    EXPECT_EQ(imin, -1000);
+    EXPECT_EQ(imax, 1000);
+    EXPECT_EQ(array_argmin(ints, ARRAY_INT32), 41);
+    EXPECT_EQ(array_argmax(ints, ARRAY_INT32), 12);
+
+    double dmin;
+    ASSERT_EQ(array_min(doubles, ARRAY_DOUBLE, &dmin), 0);
+    EXPECT_DOUBLE_EQ(dmin, -1000);
+    EXPECT_EQ(array_argmin(doubles, ARRAY_DOUBLE), 50);
+    EXPECT_EQ(array_argmax(doubles, ARRAY_DOUBLE), 0);
+
+    array_destroy(ints);
+    array_destroy(doubles);
+}
+
+TEST_P(ArrayKernelsTest, MinEmpty) {
+    void *array = array_init(sizeof(float), 0);
+    float result;
+
+    EXPECT_EQ(array_min(array, ARRAY_FLOAT, &result), 1);
+    EXPECT_EQ(array_argmax(array, ARRAY_FLOAT), 0);
+
+    array_destroy(array);
+}
+
+TEST_P(ArrayKernelsTest, Sum) {
+    int32_t *ints = (int32_t *)array_init(sizeof(int32_t), 1001);
+    float *floats = (float *)array_init(sizeof(float), 1001);
+
+    for (int i = 0; i < 1001; i++) {
+        ints[i] = INT32_MAX;
+        floats[i] = 0.5f;
+    }
+
+    int64_t isum;
+    double fsum;
+    ASSERT_EQ(array_sum(ints, ARRAY_INT32, &isum), 0);
+    ASSERT_EQ(array_sum(floats, ARRAY_FLOAT, &fsum), 0);
+    EXPECT_EQ(isum, (int64_t)INT32_MAX * 1001);
+    EXPECT_DOUBLE_EQ(fsum, 500.5);
+
+    array_destroy(ints);
+    array_destroy(floats);
+}
+
+TEST_P(ArrayKernelsTest, Dot) {
+    int32_t *a = (int32_t *)array_init(sizeof(int32_t), 23);
+    int32_t *b = (int32_t *)array_init(sizeof(int32_t), 23);
+    double *c = (double *)array_init(sizeof(double), 23);
+    double *d = (double *)array_init(sizeof(double), 23);
+
+    int64_t expected = 0;
+    for (int i = 0; i < 23; i++) {
+        a[i] = -i * 100000;
+        b[i] = i * 100000;
+        c[i] = i;
+        d[i] = 2;
+        expected += (int64_t)a[i] * b[i];
+    }
+
+    int64_t idot;
+    double ddot;
+    ASSERT_EQ(array_dot(a, b, ARRAY_INT32, &idot), 0);
+    ASSERT_EQ(array_dot(c, d, ARRAY_DOUBLE, &ddot), 0);
+    EXPECT_EQ(idot, expected);
+    EXPECT_DOUBLE_EQ(ddot, 22 * 23);
+
+    array_destroy(a);
+    array_destroy(b);
+    array_destroy(c);
+    array_destroy(d);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Levels,
+    ArrayKernelsTest,
+    ::testing::Values(ARRAY_SIMD_SCALAR, ARRAY_SIMD_SSE42, ARRAY_SIMD_AVX2)
+);
+
+
+TEST(ArrayKernels, TypeMismatch) {
+    void *array = array_init(sizeof(char), 4);
+    int32_t value = 0;
+    int64_t sum;
+
+    EXPECT_EQ(array_find_eq(array, ARRAY_INT32, &value), 4);
+    EXPECT_EQ(array_count_if_eq(array, ARRAY_INT32, &value), 0);
+    EXPECT_EQ(array_sum(array, ARRAY_INT32, &sum), 1);
+
+    void *doubles = array_init(sizeof(double), 3);
+    void *other = array_init(sizeof(double), 4);
+    double dot;
+    EXPECT_EQ(array_dot(doubles, other, ARRAY_DOUBLE, &dot), 1);
+
+    array_destroy(array);
+    array_destroy(doubles);
+    array_destroy(other);
+}
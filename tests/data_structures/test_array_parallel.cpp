@@ -0,0 +1,171 @@
+#include "../../data_structures/array_parallel.h"
+#include <stdint.h>
+
+#include <gtest/gtest.h>
+
+
+// More than one 64 KiB block of ints
+#define N_ITEMS 100003
+
+static void *iota(size_t n) {
+    int32_t *array = (int32_t *)array_init(sizeof(int32_t), n);
+    for (size_t i = 0; i < n; i++) {
+        array[i] = i;
+    }
+    return array;
+}
+
+static void add_int(void *acc, const void *item, void *) {
+    *(int32_t *)acc += *(const int32_t *)item;
+}
+
+
+TEST(ArrayParallel, For) {
+    int32_t *array = (int32_t *)iota(N_ITEMS);
+
+    ASSERT_EQ(array_parallel_for(array, [](void *items, size_t start, size_t n, void *) {
+        int32_t *p = (int32_t *)items;
+        for (size_t i = 0; i < n; i++) {
+            p[i] = (start + i) * 2;
+        }
+    }, NULL, NULL), 0);
+
+    for (size_t i = 0; i < N_ITEMS; i++) {
+        ASSERT_EQ(array[i], (int32_t)(i * 2));
+    }
+
+    array_destroy(array);
+}
+
+TEST(ArrayParallel, ReduceSum) {
+    void *array = iota(N_ITEMS);
+    int64_t identity = 0, sum = -1;
+
+    ASSERT_EQ(array_parallel_reduce(
+        array, &sum, sizeof(sum), &identity,
+        [](void *acc, const void *items, size_t n, void *) {
+            for (size_t i = 0; i < n; i++) {
+                *(int64_t *)acc += ((const int32_t *)items)[i];
+            }
+        },
+        [](void *acc, const void *other, void *) {
+            *(int64_t *)acc += *(const int64_t *)other;
+        },
+        NULL, NULL
+    ), 0);
+
+    EXPECT_EQ(sum, (int64_t)N_ITEMS * (N_ITEMS - 1) / 2);
+
+    array_destroy(array);
+}
+
+struct histogram {
+    size_t bins[10];
+};
+
+TEST(ArrayParallel, ReduceHistogram) {
+    void *array = iota(N_ITEMS);
+    struct histogram identity = {}, result;
+
+    threadpool_t pool;
+    threadpool_init(&pool, 3);
+
+    ASSERT_EQ(array_parallel_reduce(
+        array, &result, sizeof(result), &identity,
+        [](void *acc, const void *items, size_t n, void *) {
+            for (size_t i = 0; i < n; i++) {
+                ((struct histogram *)acc)->bins[((const int32_t *)items)[i] % 10]++;
+            }
+        },
+        [](void *acc, const void *other, void *) {
+            for (int b = 0; b < 10; b++) {
+                ((struct histogram *)acc)->bins[b] += ((const struct histogram *)other)->bins[b];
+            }
+        },
+        NULL, &pool
+    ), 0);
+
+    size_t total = 0;
+    for (int b = 0; b < 10; b++) {
+        EXPECT_GE(result.bins[b], N_ITEMS / 10);
+        total += result.bins[b];
+    }
+    EXPECT_EQ(total, N_ITEMS);
+
+    threadpool_destroy(&pool);
+    array_destroy(array);
+}
+
+TEST(ArrayParallel, InclusiveScan) {
+    int32_t items[] = {1, 1, 1, 1, 1, 1, 1, 1};
+    void *array = raw_to_array(items, sizeof(int32_t), 8);
+    int32_t zero = 0;
+
+    int32_t *out = (int32_t *)array_inclusive_scan(array, NULL, &zero, add_int, NULL, NULL);
+    ASSERT_EQ(array_length(out), 8);
+    for (int i = 0; i < 8; i++) {
+        EXPECT_EQ(out[i], i + 1);
+    }
+
+    array_destroy(out);
+    array_destroy(array);
+}
+
+TEST(ArrayParallel, ScanAcrossBlocks) {
+    void *array = array_init(sizeof(int32_t), N_ITEMS);
+    for (size_t i = 0; i < N_ITEMS; i++) {
+        ((int32_t *)array)[i] = 1;
+    }
+    int32_t zero = 0;
+
+    int32_t *exclusive = (int32_t *)array_exclusive_scan(array, NULL, &zero, add_int, NULL, NULL);
+    for (size_t i = 0; i < N_ITEMS; i++) {
+        ASSERT_EQ(exclusive[i], (int32_t)i);
+    }
+
+    // In place
+    int32_t *inclusive = (int32_t *)array_inclusive_scan(array, array, &zero, add_int, NULL, NULL);
+    ASSERT_EQ((void *)inclusive, array);
+    for (size_t i = 0; i < N_ITEMS; i++) {
+        ASSERT_EQ(inclusive[i], (int32_t)(i + 1));
+    }
+
+    array_destroy(exclusive);
+    array_destroy(inclusive);
+}
+
+TEST(ArrayParallel, ScanEmpty) {
+    void *array = array_init(sizeof(int32_t), 0);
+    int32_t zero = 0;
+
+    void *out = array_exclusive_scan(array, NULL, &zero, add_int, NULL, NULL);
+    ASSERT_NE(out, nullptr);
+    EXPECT_EQ(array_length(out), 0);
+
+    array_destroy(out);
+    array_destroy(array);
+}
+
+TEST(ArrayParallel, Transform) {
+    void *array = iota(N_ITEMS);
+    double scale = 0.5;
+
+    double *out = (double *)array_parallel_transform(array, NULL, sizeof(double),
+        [](void *dest, const void *src, size_t n, void *ctx) {
+            for (size_t i = 0; i < n; i++) {
+                ((double *)dest)[i] = ((const int32_t *)src)[i] * *(double *)ctx;
+            }
+        }, &scale, NULL);
+
+    ASSERT_EQ(array_length(out), N_ITEMS);
+    EXPECT_EQ(array_item_size(out), sizeof(double));
+    for (size_t i = 0; i < N_ITEMS; i++) {
+        ASSERT_DOUBLE_EQ(out[i], i * 0.5);
+    }
+
+    // Item sizes must match to transform in place
+    EXPECT_EQ(array_parallel_transform(array, array, sizeof(double), NULL, NULL, NULL), nullptr);
+
+    array_destroy(out);
+    array_destroy(array);
+}
@@ -0,0 +1,175 @@
+#include "../../data_structures/array_select.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+
+static int compare_int(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+static int compare_int_desc(const void *a, const void *b) {
+    return compare_int(b, a);
+}
+
+// Random, sorted, reversed and few-distinct inputs
+static std::vector<std::vector<int>> inputs(size_t n) {
+    std::vector<std::vector<int>> result(4, std::vector<int>(n));
+    srand(11);
+
+    for (size_t i = 0; i < n; i++) {
+        result[0][i] = rand();
+        result[1][i] = i;
+        result[2][i] = n - i;
+        result[3][i] = rand() % 4;
+    }
+
+    return result;
+}
+
+
+TEST(ArraySelect, NthElement) {
+    for (auto &input : inputs(5000)) {
+        std::vector<int> sorted = input;
+        std::sort(sorted.begin(), sorted.end());
+
+        for (size_t nth : {(size_t)0, (size_t)17, (size_t)2500, (size_t)4999}) {
+            int *array = (int *)raw_to_array(input.data(), sizeof(int), input.size());
+            array = (int *)array_nth_element(array, nth, compare_int);
+
+            ASSERT_EQ(array[nth], sorted[nth]);
+            for (size_t i = 0; i < nth; i++) {
+                ASSERT_LE(array[i], array[nth]);
+            }
+            for (size_t i = nth + 1; i < input.size(); i++) {
+                ASSERT_GE(array[i], array[nth]);
+            }
+
+            array_destroy(array);
+        }
+    }
+}
+
+TEST(ArraySelect, NthElementOutOfRange) {
+    int items[] = {3, 1, 2};
+    void *array = raw_to_array(items, sizeof(int), 3);
+
+    EXPECT_EQ(array_nth_element(array, 3, compare_int), array);
+    EXPECT_EQ(((int *)array)[0], 3);
+
+    array_destroy(array);
+}
+
+TEST(ArraySelect, PartialSort) {
+    for (auto &input : inputs(3000)) {
+        std::vector<int> sorted = input;
+        std::sort(sorted.begin(), sorted.end(), std::greater<int>());
+
+        int *array = (int *)raw_to_array(input.data(), sizeof(int), input.size());
+        array = (int *)array_partial_sort(array, 100, compare_int_desc);
+
+        for (int i = 0; i < 100; i++) {
+            ASSERT_EQ(array[i], sorted[i]);
+        }
+
+        array_destroy(array);
+    }
+}
+
+TEST(ArraySelect, TopK) {
+    for (auto &input : inputs(3000)) {
+        std::vector<int> sorted = input;
+        std::sort(sorted.begin(), sorted.end());
+
+        void *array = raw_to_array(input.data(), sizeof(int), input.size());
+        int *top = (int *)array_top_k(array, 50, compare_int, NULL);
+
+        ASSERT_EQ(array_length(top), 50);
+        for (int i = 0; i < 50; i++) {
+            ASSERT_EQ(top[i], sorted[i]);
+        }
+
+        // The input is untouched
+        EXPECT_EQ(((int *)array)[0], input[0]);
+
+        array_destroy(top);
+        array_destroy(array);
+    }
+}
+
+TEST(ArraySelect, TopKLargerThanArray) {
+    int items[] = {3, 1, 2};
+    void *array = raw_to_array(items, sizeof(int), 3);
+
+    int *top = (int *)array_top_k(array, 10, compare_int_desc, NULL);
+    ASSERT_EQ(array_length(top), 3);
+    EXPECT_EQ(top[0], 3);
+    EXPECT_EQ(top[2], 1);
+
+    array_destroy(top);
+    array_destroy(array);
+}
+
+TEST(ArraySelect, ScalarInt) {
+    for (auto &input : inputs(5000)) {
+        std::vector<int> ascending = input, descending = input;
+        std::sort(ascending.begin(), ascending.end());
+        std::sort(descending.begin(), descending.end(), std::greater<int>());
+
+        int32_t *array = (int32_t *)raw_to_array(input.data(), sizeof(int32_t), input.size());
+        array = (int32_t *)array_nth_element_scalar(array, 1234, ARRAY_INT32, 0);
+        EXPECT_EQ(array[1234], ascending[1234]);
+
+        array = (int32_t *)array_partial_sort_scalar(array, 64, ARRAY_INT32, 1);
+        for (int i = 0; i < 64; i++) {
+            ASSERT_EQ(array[i], descending[i]);
+        }
+
+        int32_t *top = (int32_t *)array_top_k_scalar(array, 64, ARRAY_INT32, 0, NULL);
+        for (int i = 0; i < 64; i++) {
+            ASSERT_EQ(top[i], ascending[i]);
+        }
+
+        array_destroy(top);
+        array_destroy(array);
+    }
+}
+
+TEST(ArraySelect, ScalarFloatAndDouble) {
+    std::vector<float> floats(1000);
+    std::vector<double> doubles(1000);
+    srand(5);
+    for (int i = 0; i < 1000; i++) {
+        floats[i] = rand() / (float)RAND_MAX;
+        doubles[i] = rand() / (double)RAND_MAX;
+    }
+
+    void *farray = raw_to_array(floats.data(), sizeof(float), 1000);
+    void *darray = raw_to_array(doubles.data(), sizeof(double), 1000);
+    std::sort(floats.begin(), floats.end(), std::greater<float>());
+    std::sort(doubles.begin(), doubles.end());
+
+    float *ftop = (float *)array_top_k_scalar(farray, 10, ARRAY_FLOAT, 1, NULL);
+    double *dtop = (double *)array_top_k_scalar(darray, 10, ARRAY_DOUBLE, 0, NULL);
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(ftop[i], floats[i]);
+        EXPECT_EQ(dtop[i], doubles[i]);
+    }
+
+    darray = array_nth_element_scalar(darray, 500, ARRAY_DOUBLE, 0);
+    EXPECT_EQ(((double *)darray)[500], doubles[500]);
+
+    // Type mismatch
+    EXPECT_EQ(array_top_k_scalar(darray, 10, ARRAY_FLOAT, 0, NULL), nullptr);
+
+    array_destroy(ftop);
+    array_destroy(dtop);
+    array_destroy(farray);
+    array_destroy(darray);
+}
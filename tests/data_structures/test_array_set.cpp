@@ -0,0 +1,180 @@
+#include "../../data_structures/array_set.h"
+#include "../../data_structures/array_kernels.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+
+static int compare_int(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+// Builds a sorted array of distinct uint32_t with roughly `n` items
+static void *random_set(size_t n, uint32_t range) {
+    std::vector<uint32_t> items;
+    for (size_t i = 0; i < n; i++) {
+        items.push_back(rand() % range);
+    }
+    std::sort(items.begin(), items.end());
+    items.erase(std::unique(items.begin(), items.end()), items.end());
+
+    return raw_to_array(items.data(), sizeof(uint32_t), items.size());
+}
+
+static std::vector<uint32_t> to_vector(void *array) {
+    uint32_t *data = (uint32_t *)array;
+    return std::vector<uint32_t>(data, data + array_length(array));
+}
+
+
+TEST(ArraySet, LowerUpperBound) {
+    int items[] = {1, 3, 3, 3, 5, 7};
+    void *array = raw_to_array(items, sizeof(int), 6);
+
+    int keys[] = {0, 1, 2, 3, 4, 7, 8};
+    size_t lower[] = {0, 0, 1, 1, 4, 5, 6};
+    size_t upper[] = {0, 1, 1, 4, 4, 6, 6};
+
+    for (int i = 0; i < 7; i++) {
+        EXPECT_EQ(array_lower_bound(array, &keys[i], compare_int), lower[i]);
+        EXPECT_EQ(array_upper_bound(array, &keys[i], compare_int), upper[i]);
+    }
+
+    void *empty = array_init(sizeof(int), 0);
+    EXPECT_EQ(array_lower_bound(empty, &keys[0], compare_int), 0);
+
+    array_destroy(array);
+    array_destroy(empty);
+}
+
+TEST(ArraySet, LowerUpperBoundU32) {
+    uint32_t items[] = {2, 4, 4, 8};
+    void *array = raw_to_array(items, sizeof(uint32_t), 4);
+
+    EXPECT_EQ(array_lower_bound_u32(array, 4), 1);
+    EXPECT_EQ(array_upper_bound_u32(array, 4), 3);
+    EXPECT_EQ(array_lower_bound_u32(array, 9), 4);
+    EXPECT_EQ(array_upper_bound_u32(array, 0), 0);
+
+    array_destroy(array);
+}
+
+TEST(ArraySet, Generic) {
+    int a_items[] = {1, 2, 4, 6, 8, 9};
+    int b_items[] = {2, 3, 4, 9, 10};
+    void *a = raw_to_array(a_items, sizeof(int), 6);
+    void *b = raw_to_array(b_items, sizeof(int), 5);
+
+    int *out = (int *)array_intersect(a, b, NULL, compare_int);
+    int intersection[] = {2, 4, 9};
+    ASSERT_EQ(array_length(out), 3);
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(out[i], intersection[i]);
+    }
+
+    // Reuse the output array
+    out = (int *)array_union(a, b, out, compare_int);
+    int union_items[] = {1, 2, 3, 4, 6, 8, 9, 10};
+    ASSERT_EQ(array_length(out), 8);
+    for (int i = 0; i < 8; i++) {
+        EXPECT_EQ(out[i], union_items[i]);
+    }
+
+    out = (int *)array_difference(a, b, out, compare_int);
+    int difference[] = {1, 6, 8};
+    ASSERT_EQ(array_length(out), 3);
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(out[i], difference[i]);
+    }
+
+    void *wrong = array_init(sizeof(char), 0);
+    EXPECT_EQ(array_intersect(a, b, wrong, compare_int), nullptr);
+
+    array_destroy(wrong);
+    array_destroy(out);
+    array_destroy(a);
+    array_destroy(b);
+}
+
+TEST(ArraySet, GenericSkewed) {
+    std::vector<int> large;
+    for (int i = 0; i < 1000; i++) {
+        large.push_back(i * 2);
+    }
+    int small_items[] = {-1, 10, 11, 500, 1998, 2000};
+    void *a = raw_to_array(small_items, sizeof(int), 6);
+    void *b = raw_to_array(large.data(), sizeof(int), large.size());
+
+    int *out = (int *)array_intersect(a, b, NULL, compare_int);
+    ASSERT_EQ(array_length(out), 3);
+    EXPECT_EQ(out[0], 10);
+    EXPECT_EQ(out[1], 500);
+    EXPECT_EQ(out[2], 1998);
+
+    out = (int *)array_difference(a, b, out, compare_int);
+    ASSERT_EQ(array_length(out), 3);
+    EXPECT_EQ(out[0], -1);
+    EXPECT_EQ(out[1], 11);
+    EXPECT_EQ(out[2], 2000);
+
+    out = (int *)array_union(b, a, out, compare_int);
+    ASSERT_EQ(array_length(out), 1003);
+    EXPECT_EQ(out[0], -1);
+    EXPECT_EQ(out[7], 11);
+    EXPECT_EQ(out[1002], 2000);
+
+    array_destroy(out);
+    array_destroy(a);
+    array_destroy(b);
+}
+
+// Compares the u32 operations with the STL for similar and skewed sizes
+class ArraySetU32 : public ::testing::TestWithParam<enum array_simd_level> {
+protected:
+    void SetUp() override {
+        if (array_simd_set_level(GetParam()) != GetParam()) {
+            GTEST_SKIP() << "Instruction set not supported";
+        }
+    }
+};
+
+TEST_P(ArraySetU32, MatchesStl) {
+    srand(3);
+    size_t sizes[][2] = {{1000, 1000}, {1000, 1500}, {10, 5000}, {5000, 10}, {0, 100}};
+
+    for (auto &size : sizes) {
+        void *a = random_set(size[0], 4000);
+        void *b = random_set(size[1], 4000);
+        std::vector<uint32_t> va = to_vector(a), vb = to_vector(b), expected;
+
+        void *out = array_intersect_u32(a, b, NULL);
+        std::set_intersection(va.begin(), va.end(), vb.begin(), vb.end(), std::back_inserter(expected));
+        EXPECT_EQ(to_vector(out), expected);
+
+        expected.clear();
+        out = array_union_u32(a, b, out);
+        std::set_union(va.begin(), va.end(), vb.begin(), vb.end(), std::back_inserter(expected));
+        EXPECT_EQ(to_vector(out), expected);
+
+        expected.clear();
+        out = array_difference_u32(a, b, out);
+        std::set_difference(va.begin(), va.end(), vb.begin(), vb.end(), std::back_inserter(expected));
+        EXPECT_EQ(to_vector(out), expected);
+
+        array_destroy(out);
+        array_destroy(a);
+        array_destroy(b);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Levels,
+    ArraySetU32,
+    ::testing::Values(ARRAY_SIMD_SCALAR, ARRAY_SIMD_SSE42)
+);
@@ -0,0 +1,174 @@
+#include "../../data_structures/array_sort.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+
+
+struct pair {
+    int key;
+    int order;
+};
+
+static int compare_int(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+static int compare_key(const void *a, const void *b) {
+    return compare_int(&((const struct pair *)a)->key, &((const struct pair *)b)->key);
+}
+
+static void expect_sorted(std::vector<int> items) {
+    void *array = raw_to_array(items.data(), sizeof(int), items.size());
+
+    int *sorted = (int *) array_sort_stable(array, compare_int);
+    ASSERT_NE(sorted, nullptr);
+
+    std::sort(items.begin(), items.end());
+    ASSERT_EQ(array_length(sorted), items.size());
+
+    for (size_t i = 0; i < items.size(); i++) {
+        ASSERT_EQ(sorted[i], items[i]) << "at index " << i;
+    }
+
+    array_destroy(sorted);
+}
+
+
+TEST(ArraySortStable, Small) {
+    expect_sorted({});
+    expect_sorted({1});
+    expect_sorted({2, 1});
+    expect_sorted({5, 3, 9, 1, 1, 0, -4, 7});
+}
+
+TEST(ArraySortStable, Sorted) {
+    std::vector<int> items(100000);
+    for (size_t i = 0; i < items.size(); i++) {
+        items[i] = i;
+    }
+
+    expect_sorted(items);
+}
+
+TEST(ArraySortStable, Reversed) {
+    std::vector<int> items(100000);
+    for (size_t i = 0; i < items.size(); i++) {
+        items[i] = items.size() - i;
+    }
+
+    expect_sorted(items);
+}
+
+TEST(ArraySortStable, Sawtooth) {
+    std::vector<int> items(100000);
+    for (size_t i = 0; i < items.size(); i++) {
+        items[i] = i % 1000;
+    }
+
+    expect_sorted(items);
+}
+
+TEST(ArraySortStable, Random) {
+    srand(42);
+
+    for (size_t n : {31, 32, 33, 64, 1000, 65537}) {
+        std::vector<int> items(n);
+        for (size_t i = 0; i < n; i++) {
+            items[i] = rand() % 1000;
+        }
+
+        expect_sorted(items);
+    }
+}
+
+TEST(ArraySortStable, MostlySortedWithStragglers) {
+    srand(7);
+
+    std::vector<int> items(50000);
+    for (size_t i = 0; i < items.size(); i++) {
+        items[i] = i;
+    }
+    for (int i = 0; i < 50; i++) {
+        items[rand() % items.size()] = rand() % 50000;
+    }
+
+    expect_sorted(items);
+}
+
+TEST(ArraySortStable, IsStable) {
+    srand(3);
+
+    size_t n = 20000;
+    struct pair *array = (struct pair *) array_init(sizeof(struct pair), n);
+
+    for (size_t i = 0; i < n; i++) {
+        // Runs of ascending keys with many duplicates, followed by noise
+        array[i].key = i < n / 2 ? (int)(i / 16) % 100 : rand() % 100;
+        array[i].order = i;
+    }
+
+    array = (struct pair *) array_sort_stable(array, compare_key);
+    ASSERT_NE(array, nullptr);
+
+    for (size_t i = 1; i < n; i++) {
+        ASSERT_LE(array[i - 1].key, array[i].key);
+
+        if (array[i - 1].key == array[i].key) {
+            ASSERT_LT(array[i - 1].order, array[i].order);
+        }
+    }
+
+    array_destroy(array);
+}
+
+TEST(ArraySortStable, Shared) {
+    int items[] = {3, 1, 2};
+    int *array = (int *) raw_to_array(items, sizeof(int), 3);
+    int *shared = (int *) array_share(array);
+
+    shared = (int *) array_sort_stable(shared, compare_int);
+
+    EXPECT_EQ(array[0], 3);
+    EXPECT_EQ(shared[0], 1);
+    EXPECT_EQ(shared[2], 3);
+
+    array_destroy(array);
+    array_destroy(shared);
+}
+
+static size_t n_compares;
+
+static int counting_compare(const void *a, const void *b) {
+    n_compares++;
+    return compare_int(a, b);
+}
+
+TEST(ArraySortStable, PresortedIsLinear) {
+    size_t n = 100000;
+    int *array = (int *) array_init(sizeof(int), n);
+
+    for (size_t i = 0; i < n; i++) {
+        array[i] = i;
+    }
+
+    n_compares = 0;
+    array = (int *) array_sort_stable(array, counting_compare);
+    EXPECT_EQ(n_compares, n - 1);
+
+    // Two interleaved sorted halves only need a galloping merge
+    for (size_t i = 0; i < n; i++) {
+        array[i] = i < n / 2 ? 2 * i : 2 * (i - n / 2) + 1;
+    }
+
+    n_compares = 0;
+    array = (int *) array_sort_stable(array, counting_compare);
+    EXPECT_LT(n_compares, 2 * n);
+
+    for (size_t i = 0; i < n; i++) {
+        ASSERT_EQ(array[i], (int)i);
+    }
+
+    array_destroy(array);
+}
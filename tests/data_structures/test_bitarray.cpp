@@ -0,0 +1,195 @@
+#include "../../data_structures/bitarray.h"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+
+static const enum array_simd_level levels[] = {
+    ARRAY_SIMD_SCALAR, ARRAY_SIMD_SSE42, ARRAY_SIMD_AVX2
+};
+
+
+TEST(BitArray, Init) {
+    bitarray_t bits;
+    ASSERT_EQ(bitarray_init(&bits, 100), 0);
+
+    EXPECT_EQ(bitarray_length(&bits), 100);
+    EXPECT_EQ(array_length(bitarray_words(&bits)), 2);
+    EXPECT_EQ(bitarray_count(&bits), 0);
+
+    bitarray_destroy(&bits);
+}
+
+TEST(BitArray, SetClearTest) {
+    bitarray_t bits;
+    bitarray_init(&bits, 130);
+
+    EXPECT_EQ(bitarray_set(&bits, 0), 0);
+    EXPECT_EQ(bitarray_set(&bits, 64), 0);
+    EXPECT_EQ(bitarray_set(&bits, 129), 0);
+    EXPECT_EQ(bitarray_set(&bits, 130), 1);
+
+    EXPECT_EQ(bitarray_test(&bits, 0), 1);
+    EXPECT_EQ(bitarray_test(&bits, 1), 0);
+    EXPECT_EQ(bitarray_test(&bits, 64), 1);
+    EXPECT_EQ(bitarray_test(&bits, 129), 1);
+    EXPECT_EQ(bitarray_test(&bits, 130), 0);
+    EXPECT_EQ(bitarray_count(&bits), 3);
+
+    EXPECT_EQ(bitarray_clear(&bits, 64), 0);
+    EXPECT_EQ(bitarray_test(&bits, 64), 0);
+    EXPECT_EQ(bitarray_count(&bits), 2);
+
+    bitarray_destroy(&bits);
+}
+
+TEST(BitArray, AppendAndResize) {
+    bitarray_t bits;
+    bitarray_init(&bits, 0);
+
+    for (int i = 0; i < 200; i++) {
+        ASSERT_EQ(bitarray_append(&bits, i % 3 == 0), 0);
+    }
+
+    EXPECT_EQ(bitarray_length(&bits), 200);
+    EXPECT_EQ(bitarray_count(&bits), 67);
+
+    // Shrinking drops the tail bits, growing again leaves them cleared
+    ASSERT_EQ(bitarray_resize(&bits, 10), 0);
+    EXPECT_EQ(bitarray_count(&bits), 4);
+    ASSERT_EQ(bitarray_resize(&bits, 300), 0);
+    EXPECT_EQ(bitarray_count(&bits), 4);
+    EXPECT_EQ(bitarray_test(&bits, 12), 0);
+
+    bitarray_destroy(&bits);
+}
+
+TEST(BitArray, Fill) {
+    bitarray_t bits;
+    bitarray_init(&bits, 70);
+
+    bitarray_fill(&bits, 1);
+    EXPECT_EQ(bitarray_count(&bits), 70);
+
+    // The tail of the last word stays clear
+    EXPECT_EQ(bitarray_words(&bits)[1], 0x3fu);
+
+    bitarray_fill(&bits, 0);
+    EXPECT_EQ(bitarray_count(&bits), 0);
+
+    bitarray_destroy(&bits);
+}
+
+TEST(BitArray, BulkOps) {
+    for (enum array_simd_level level : levels) {
+        array_simd_set_level(level);
+
+        bitarray_t a, b;
+        bitarray_init(&a, 1000);
+        bitarray_init(&b, 1000);
+
+        for (size_t i = 0; i < 1000; i++) {
+            if (i % 2 == 0) bitarray_set(&a, i);
+            if (i % 3 == 0) bitarray_set(&b, i);
+        }
+
+        bitarray_t c;
+        bitarray_init(&c, 1000);
+
+        bitarray_or(&c, &a);
+        ASSERT_EQ(bitarray_and(&c, &b), 0);
+        EXPECT_EQ(bitarray_count(&c), 167);     // Multiples of 6
+
+        bitarray_fill(&c, 0);
+        bitarray_or(&c, &a);
+        ASSERT_EQ(bitarray_or(&c, &b), 0);
+        EXPECT_EQ(bitarray_count(&c), 500 + 334 - 167);
+
+        bitarray_fill(&c, 0);
+        bitarray_or(&c, &a);
+        ASSERT_EQ(bitarray_xor(&c, &b), 0);
+        EXPECT_EQ(bitarray_count(&c), 500 + 334 - 2 * 167);
+
+        bitarray_fill(&c, 0);
+        bitarray_or(&c, &a);
+        ASSERT_EQ(bitarray_andnot(&c, &b), 0);
+        EXPECT_EQ(bitarray_count(&c), 500 - 167);
+        EXPECT_EQ(bitarray_test(&c, 2), 1);
+        EXPECT_EQ(bitarray_test(&c, 6), 0);
+
+        bitarray_t d;
+        bitarray_init(&d, 999);
+        EXPECT_EQ(bitarray_and(&c, &d), 1);
+
+        bitarray_destroy(&a);
+        bitarray_destroy(&b);
+        bitarray_destroy(&c);
+        bitarray_destroy(&d);
+    }
+
+    array_simd_set_level(ARRAY_SIMD_AVX2);
+}
+
+TEST(BitArray, Count) {
+    for (enum array_simd_level level : levels) {
+        array_simd_set_level(level);
+
+        bitarray_t bits;
+        bitarray_init(&bits, 12345);
+
+        size_t expected = 0;
+        for (size_t i = 0; i < 12345; i += 7) {
+            bitarray_set(&bits, i);
+            expected++;
+        }
+
+        EXPECT_EQ(bitarray_count(&bits), expected);
+
+        bitarray_destroy(&bits);
+    }
+
+    array_simd_set_level(ARRAY_SIMD_AVX2);
+}
+
+TEST(BitArray, RankSelect) {
+    bitarray_t bits;
+    bitarray_init(&bits, 5000);
+
+    std::vector<size_t> set;
+    for (size_t i = 0; i < 5000; i++) {
+        if ((i * 2654435761u) % 5 == 0) {
+            bitarray_set(&bits, i);
+            set.push_back(i);
+        }
+    }
+
+    size_t rank = 0;
+    for (size_t i = 0; i <= 5000; i++) {
+        ASSERT_EQ(bitarray_rank(&bits, i), rank);
+        rank += bitarray_test(&bits, i);
+    }
+
+    for (size_t k = 0; k < set.size(); k++) {
+        ASSERT_EQ(bitarray_select(&bits, k), set[k]);
+    }
+
+    EXPECT_EQ(bitarray_select(&bits, set.size()), 5000);
+    EXPECT_EQ(bitarray_count(&bits), set.size());
+
+    // Changing a bit invalidates the index
+    bitarray_clear(&bits, set[0]);
+    EXPECT_EQ(bitarray_select(&bits, 0), set[1]);
+    EXPECT_EQ(bitarray_rank(&bits, 5000), set.size() - 1);
+
+    bitarray_destroy(&bits);
+}
+
+TEST(BitArray, RankSelectEmpty) {
+    bitarray_t bits;
+    bitarray_init(&bits, 0);
+
+    EXPECT_EQ(bitarray_rank(&bits, 0), 0);
+    EXPECT_EQ(bitarray_select(&bits, 0), 0);
+
+    bitarray_destroy(&bits);
+}
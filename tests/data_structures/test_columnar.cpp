@@ -0,0 +1,200 @@
+#include "../../data_structures/columnar.h"
+#include "../../data_structures/array_kernels.h"
+#include <stdint.h>
+
+#include <gtest/gtest.h>
+
+
+struct record {
+    int32_t id;
+    char tag;
+    double price;
+    int64_t quantity;
+    float weights[3];
+};
+
+static void add_fields(columnar_t *table) {
+    ASSERT_EQ(columnar_add_field(table, struct record, id), 0);
+    ASSERT_EQ(columnar_add_field(table, struct record, tag), 0);
+    ASSERT_EQ(columnar_add_field(table, struct record, price), 0);
+    ASSERT_EQ(columnar_add_field(table, struct record, quantity), 0);
+    ASSERT_EQ(columnar_add_field(table, struct record, weights), 0);
+}
+
+static struct record make_record(int i) {
+    struct record rec;
+    memset(&rec, 0, sizeof(rec));
+
+    rec.id = i;
+    rec.tag = 'a' + i % 26;
+    rec.price = i * 0.25;
+    rec.quantity = (int64_t)i * 1000;
+    rec.weights[0] = i;
+    rec.weights[1] = -i;
+    rec.weights[2] = 0.5f;
+
+    return rec;
+}
+
+
+TEST(Columnar, Init) {
+    columnar_t table;
+    ASSERT_EQ(columnar_init(&table), 0);
+    add_fields(&table);
+
+    EXPECT_EQ(columnar_length(&table), 0);
+    EXPECT_EQ(columnar_n_columns(&table), 5);
+    EXPECT_EQ(array_item_size(columnar_column(&table, 2)), sizeof(double));
+    EXPECT_EQ(array_item_size(columnar_column(&table, 4)), 3 * sizeof(float));
+    EXPECT_EQ(columnar_column(&table, 5), nullptr);
+
+    columnar_destroy(&table);
+}
+
+TEST(Columnar, AppendRow) {
+    columnar_t table;
+    columnar_init(&table);
+    add_fields(&table);
+
+    for (int i = 0; i < 1000; i++) {
+        struct record rec = make_record(i);
+        ASSERT_EQ(columnar_append_row(&table, &rec), 0);
+    }
+
+    ASSERT_EQ(columnar_length(&table), 1000);
+
+    for (size_t c = 0; c < columnar_n_columns(&table); c++) {
+        EXPECT_EQ(array_length(columnar_column(&table, c)), 1000);
+    }
+
+    int32_t *ids = (int32_t *) columnar_column(&table, 0);
+    double *prices = (double *) columnar_column(&table, 2);
+
+    for (int i = 0; i < 1000; i++) {
+        ASSERT_EQ(ids[i], i);
+        ASSERT_EQ(prices[i], i * 0.25);
+    }
+
+    EXPECT_EQ(*(char *) columnar_at(&table, 1, 27), 'b');
+    EXPECT_EQ(columnar_at(&table, 1, 1000), nullptr);
+
+    columnar_destroy(&table);
+}
+
+TEST(Columnar, AppendAndGatherRows) {
+    columnar_t table;
+    columnar_init(&table);
+    add_fields(&table);
+
+    struct record rows[100];
+    for (int i = 0; i < 100; i++) {
+        rows[i] = make_record(i);
+    }
+
+    ASSERT_EQ(columnar_append_rows(&table, rows, 100, sizeof(struct record)), 0);
+    ASSERT_EQ(columnar_append_rows(&table, rows, 50, sizeof(struct record)), 0);
+    ASSERT_EQ(columnar_length(&table), 150);
+
+    struct record out[20];
+    memset(out, 0, sizeof(out));
+    ASSERT_EQ(columnar_gather_rows(&table, 90, 20, out, sizeof(struct record)), 0);
+
+    for (int i = 0; i < 20; i++) {
+        struct record expected = make_record((90 + i) % 100);
+        EXPECT_EQ(memcmp(&out[i], &expected, sizeof(struct record)), 0);
+    }
+
+    EXPECT_EQ(columnar_gather_rows(&table, 140, 11, out, sizeof(struct record)), 1);
+
+    columnar_destroy(&table);
+}
+
+TEST(Columnar, AddColumnToExistingRows) {
+    columnar_t table;
+    columnar_init(&table);
+    columnar_add_field(&table, struct record, id);
+
+    struct record rec = make_record(7);
+    columnar_append_row(&table, &rec);
+    columnar_append_row(&table, &rec);
+
+    ASSERT_EQ(columnar_add_field(&table, struct record, price), 0);
+
+    double *prices = (double *) columnar_column(&table, 1);
+    ASSERT_EQ(array_length(prices), 2);
+    EXPECT_EQ(prices[0], 0.0);
+    EXPECT_EQ(prices[1], 0.0);
+
+    columnar_destroy(&table);
+}
+
+TEST(Columnar, SetLengthAndReserve) {
+    columnar_t table;
+    columnar_init(&table);
+    add_fields(&table);
+
+    ASSERT_EQ(columnar_reserve(&table, 500), 0);
+    EXPECT_GE(array_capacity(columnar_column(&table, 3)), 500);
+    EXPECT_EQ(columnar_length(&table), 0);
+
+    ASSERT_EQ(columnar_set_length(&table, 10), 0);
+    EXPECT_EQ(array_length(columnar_column(&table, 3)), 10);
+
+    ASSERT_EQ(columnar_set_length(&table, 3), 0);
+    EXPECT_EQ(columnar_length(&table), 3);
+    EXPECT_EQ(array_length(columnar_column(&table, 0)), 3);
+
+    columnar_destroy(&table);
+}
+
+TEST(Columnar, AppendToSharedColumn) {
+    columnar_t table;
+    columnar_init(&table);
+    add_fields(&table);
+
+    struct record rec = make_record(7);
+    ASSERT_EQ(columnar_append_row(&table, &rec), 0);
+    ASSERT_EQ(columnar_reserve(&table, 16), 0);
+
+    // The shared copy keeps its rows; the table gets its own column
+    int32_t *shared = (int32_t *) array_share(columnar_column(&table, 0));
+
+    rec = make_record(42);
+    ASSERT_EQ(columnar_append_row(&table, &rec), 0);
+
+    int32_t *ids = (int32_t *) columnar_column(&table, 0);
+    EXPECT_NE(ids, shared);
+    ASSERT_EQ(array_length(ids), 2);
+    EXPECT_EQ(ids[0], 7);
+    EXPECT_EQ(ids[1], 42);
+    EXPECT_EQ(*(char *) columnar_at(&table, 1, 1), rec.tag);
+
+    EXPECT_TRUE(array_is_unique(shared));
+    ASSERT_EQ(array_length(shared), 1);
+    EXPECT_EQ(shared[0], 7);
+
+    array_destroy(shared);
+    columnar_destroy(&table);
+}
+
+TEST(Columnar, ColumnKernels) {
+    columnar_t table;
+    columnar_init(&table);
+    add_fields(&table);
+
+    for (int i = 0; i < 10000; i++) {
+        struct record rec = make_record(i);
+        columnar_append_row(&table, &rec);
+    }
+
+    // Columns are plain arrays, so the scalar kernels apply directly
+    int64_t id_sum;
+    ASSERT_EQ(array_sum(columnar_column(&table, 0), ARRAY_INT32, &id_sum), 0);
+    EXPECT_EQ(id_sum, (int64_t)10000 * 9999 / 2);
+
+    double max_price;
+    ASSERT_EQ(array_max(columnar_column(&table, 2), ARRAY_DOUBLE, &max_price), 0);
+    EXPECT_EQ(max_price, 9999 * 0.25);
+
+    columnar_destroy(&table);
+}
@@ -0,0 +1,90 @@
+#include "../../data_structures/ilist.h"
+
+#include <gtest/gtest.h>
+
+
+struct task {
+    int id;
+    ilist_link_t link;
+};
+
+static int id_of(ilist_link_t *link) {
+    return ilist_entry(link, struct task, link)->id;
+}
+
+
+TEST(IList, Init) {
+    ilist_t list;
+    ASSERT_EQ(ilist_init(&list), 0);
+
+    EXPECT_EQ(ilist_length(&list), 0);
+    EXPECT_EQ(ilist_empty(&list), 1);
+    EXPECT_EQ(ilist_first(&list), nullptr);
+    EXPECT_EQ(ilist_last(&list), nullptr);
+    EXPECT_EQ(ilist_pop_front(&list), nullptr);
+    EXPECT_EQ(ilist_pop_back(&list), nullptr);
+}
+
+TEST(IList, PushAndIterate) {
+    ilist_t list;
+    ilist_init(&list);
+
+    struct task tasks[5];
+    for (int i = 0; i < 5; i++) {
+        tasks[i].id = i;
+        ilist_link_init(&tasks[i].link);
+    }
+
+    ilist_push_back(&list, &tasks[2].link);
+    ilist_push_back(&list, &tasks[3].link);
+    ilist_push_front(&list, &tasks[1].link);
+    ilist_push_front(&list, &tasks[0].link);
+    ilist_push_back(&list, &tasks[4].link);
+
+    EXPECT_EQ(ilist_length(&list), 5);
+
+    int expected = 0;
+    for (ilist_link_t *l = ilist_first(&list); l; l = ilist_next(&list, l)) {
+        EXPECT_EQ(id_of(l), expected++);
+    }
+    EXPECT_EQ(expected, 5);
+
+    for (ilist_link_t *l = ilist_last(&list); l; l = ilist_prev(&list, l)) {
+        EXPECT_EQ(id_of(l), --expected);
+    }
+    EXPECT_EQ(expected, 0);
+}
+
+TEST(IList, InsertAndRemove) {
+    ilist_t list;
+    ilist_init(&list);
+
+    struct task a = {1, {NULL, NULL}}, b = {2, {NULL, NULL}}, c = {3, {NULL, NULL}};
+
+    EXPECT_EQ(ilist_is_linked(&a.link), 0);
+
+    ilist_push_back(&list, &a.link);
+    ilist_insert_after(&list, &a.link, &c.link);
+    ilist_insert_before(&list, &c.link, &b.link);
+
+    EXPECT_EQ(ilist_is_linked(&a.link), 1);
+    EXPECT_EQ(id_of(ilist_first(&list)), 1);
+    EXPECT_EQ(id_of(ilist_next(&list, ilist_first(&list))), 2);
+    EXPECT_EQ(id_of(ilist_last(&list)), 3);
+
+    // Removing from the middle needs only the object
+    ilist_remove(&list, &b.link);
+    EXPECT_EQ(ilist_is_linked(&b.link), 0);
+    EXPECT_EQ(ilist_length(&list), 2);
+    EXPECT_EQ(ilist_next(&list, &a.link), &c.link);
+
+    EXPECT_EQ(id_of(ilist_pop_back(&list)), 3);
+    EXPECT_EQ(id_of(ilist_pop_front(&list)), 1);
+    EXPECT_EQ(ilist_empty(&list), 1);
+
+    // An object can move between lists
+    ilist_t other;
+    ilist_init(&other);
+    ilist_push_back(&other, &b.link);
+    EXPECT_EQ(id_of(ilist_first(&other)), 2);
+}
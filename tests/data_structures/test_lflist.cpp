@@ -0,0 +1,153 @@
+#include "../../data_structures/lflist.h"
+
+#include <gtest/gtest.h>
+#include <pthread.h>
+#include <vector>
+
+
+static int compare_int(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+
+TEST(LFList, SingleThread) {
+    epoch_domain_t domain;
+    epoch_init(&domain);
+    epoch_thread_t thread;
+    epoch_register(&domain, &thread);
+
+    lflist_t list;
+    ASSERT_EQ(lflist_init(&list, sizeof(int), compare_int), 0);
+
+    int items[] = {5, 1, 9, 3, 7};
+    for (int item : items) {
+        ASSERT_EQ(lflist_insert(&list, &thread, &item), 0);
+    }
+
+    int dup = 3;
+    EXPECT_EQ(lflist_insert(&list, &thread, &dup), 1);
+    EXPECT_EQ(lflist_length(&list), 5);
+
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(lflist_contains(&list, &thread, &i), i % 2 == 1) << i;
+    }
+
+    int key = 9, item;
+    ASSERT_EQ(lflist_get(&list, &thread, &key, &item), 0);
+    EXPECT_EQ(item, 9);
+
+    ASSERT_EQ(lflist_remove(&list, &thread, &key, &item), 0);
+    EXPECT_EQ(item, 9);
+    EXPECT_EQ(lflist_remove(&list, &thread, &key, NULL), 1);
+    EXPECT_EQ(lflist_contains(&list, &thread, &key), 0);
+    EXPECT_EQ(lflist_get(&list, &thread, &key, &item), 1);
+    EXPECT_EQ(lflist_length(&list), 4);
+
+    // The nodes stay sorted
+    std::vector<int> seen;
+    for (lflist_node_t *node = list.head; node; node = node->next) {
+        seen.push_back(*(int *)((char *)node + 32));
+    }
+    EXPECT_EQ(seen, std::vector<int>({1, 3, 5, 7}));
+
+    lflist_destroy(&list);
+    epoch_unregister(&thread);
+    epoch_destroy(&domain);
+}
+
+struct worker_args {
+    lflist_t *list;
+    epoch_domain_t *domain;
+    pthread_barrier_t *barrier;
+    int id;
+    int n_threads;
+    int n_keys;
+};
+
+static void *churn(void *arg) {
+    struct worker_args *args = (struct worker_args *)arg;
+
+    epoch_thread_t thread;
+    epoch_register(args->domain, &thread);
+
+    // Every thread fights over the same keys
+    for (int round = 0; round < 20; round++) {
+        for (int key = 0; key < args->n_keys; key++) {
+            lflist_insert(args->list, &thread, &key);
+        }
+
+        for (int key = args->id; key < args->n_keys; key += 2) {
+            lflist_remove(args->list, &thread, &key, NULL);
+            lflist_contains(args->list, &thread, &key);
+        }
+    }
+
+    pthread_barrier_wait(args->barrier);
+
+    // Finally each thread owns a disjoint slice of the keys
+    for (int key = args->id; key < args->n_keys; key += args->n_threads) {
+        lflist_insert(args->list, &thread, &key);
+        if (key % 3 == 0) {
+            lflist_remove(args->list, &thread, &key, NULL);
+        }
+    }
+
+    epoch_unregister(&thread);
+
+    return NULL;
+}
+
+TEST(LFList, Concurrent) {
+    epoch_domain_t domain;
+    epoch_init(&domain);
+
+    lflist_t list;
+    lflist_init(&list, sizeof(int), compare_int);
+
+    const int n_threads = 8, n_keys = 500;
+    pthread_t threads[n_threads];
+    struct worker_args args[n_threads];
+    pthread_barrier_t barrier;
+    pthread_barrier_init(&barrier, NULL, n_threads);
+
+    for (int i = 0; i < n_threads; i++) {
+        args[i] = {&list, &domain, &barrier, i, n_threads, n_keys};
+        ASSERT_EQ(pthread_create(&threads[i], NULL, churn, &args[i]), 0);
+    }
+
+    for (int i = 0; i < n_threads; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    pthread_barrier_destroy(&barrier);
+
+    epoch_thread_t thread;
+    epoch_register(&domain, &thread);
+
+    // The last phase leaves exactly the keys not divisible by 3
+    size_t count = 0;
+    for (int key = 0; key < n_keys; key++) {
+        int present = lflist_contains(&list, &thread, &key);
+        if (key % 3 == 0) {
+            EXPECT_EQ(present, 0) << key;
+        } else {
+            EXPECT_EQ(present, 1) << key;
+        }
+        count += present;
+    }
+
+    EXPECT_EQ(count, n_keys - (n_keys + 2) / 3);
+    EXPECT_EQ(lflist_length(&list), count);
+
+    int prev = -1;
+    for (lflist_node_t *node = list.head; node; node = node->next) {
+        int key = *(int *)((char *)node + 32);
+        ASSERT_LT(prev, key);
+        prev = key;
+    }
+
+    epoch_unregister(&thread);
+    lflist_destroy(&list);
+    epoch_destroy(&domain);
+}
@@ -286,6 +286,238 @@ TEST(LinkedList, SortDescending) {
     linkedlist_destroy(&list);
 }
 
+TEST(LinkedList, IndexedNearEnds) {
+    linkedlist_t list;
+    linkedlist_init(&list, sizeof(int));
+
+    // Quadratic indexed access would not finish in reasonable time
+    int n = 200000;
+    for (int i = 0; i < n; i++) {
+        linkedlist_append(&list, &i);
+    }
+
+    int item;
+    for (int i = 0; i < n; i++) {
+        ASSERT_EQ(linkedlist_get(&list, i, &item), 0);
+        ASSERT_EQ(item, i);
+    }
+
+    for (int i = n - 1; i >= 0; i -= 1000) {
+        ASSERT_EQ(linkedlist_get(&list, i, &item), 0);
+        ASSERT_EQ(item, i);
+    }
+
+    // Remove every other item from the middle outwards, by index
+    for (int i = n / 2; i < n / 2 + 1000; i++) {
+        ASSERT_EQ(linkedlist_remove(&list, i, &item), 0);
+        ASSERT_EQ(item, 2 * i - n / 2);
+    }
+
+    linkedlist_destroy(&list);
+}
+
+TEST(LinkedList, FingerAfterMutation) {
+    linkedlist_t list;
+    linkedlist_init(&list, sizeof(int));
+
+    for (int i = 0; i < 100; i++) {
+        linkedlist_append(&list, &i);
+    }
+
+    // Leave the finger at index 50, then shift it in every direction
+    int item, value = -1;
+    linkedlist_get(&list, 50, &item);
+    linkedlist_insert(&list, 10, &value);
+    linkedlist_get(&list, 51, &item);
+    EXPECT_EQ(item, 50);
+
+    linkedlist_remove(&list, 0, NULL);
+    linkedlist_get(&list, 49, &item);
+    EXPECT_EQ(item, 49);
+
+    linkedlist_remove(&list, 49, &item);
+    EXPECT_EQ(item, 49);
+    linkedlist_get(&list, 49, &item);
+    EXPECT_EQ(item, 50);
+    linkedlist_get(&list, 48, &item);
+    EXPECT_EQ(item, 48);
+
+    linkedlist_insert(&list, 60, &value);
+    linkedlist_get(&list, 50, &item);
+    EXPECT_EQ(item, 51);
+
+    // Removing the tail while the finger is on it
+    size_t last = linkedlist_length(&list) - 1;
+    linkedlist_get(&list, last, &item);
+    linkedlist_pop(&list, NULL);
+    linkedlist_get(&list, last - 1, &item);
+    EXPECT_EQ(item, 98);
+
+    // Sorting and splitting forget the finger
+    linkedlist_get(&list, 90, &item);
+    linkedlist_sort(&list, [](const void *a, const void *b) -> int {
+        return *(int *)b - *(int *)a;
+    });
+    linkedlist_get(&list, 90, &item);
+    EXPECT_EQ(item, 7);
+
+    linkedlist_t rest;
+    linkedlist_split(&list, 10, &rest);
+    linkedlist_get(&list, 9, &item);
+    EXPECT_EQ(item, 89);
+    linkedlist_get(&rest, 0, &item);
+    EXPECT_EQ(item, 88);
+
+    linkedlist_iterator_t it;
+    ASSERT_EQ(linkedlist_iter_init(&it, &list, 10, 0), 0);
+    EXPECT_EQ(linkedlist_iter_next(&it, &item), 1);
+
+    linkedlist_destroy(&list);
+    linkedlist_destroy(&rest);
+}
+
+struct keyed {
+    int key;
+    int seq;
+};
+
+static int compare_key(const void *a, const void *b) {
+    return ((const struct keyed *)a)->key - ((const struct keyed *)b)->key;
+}
+
+TEST(LinkedList, SortStable) {
+    linkedlist_t list;
+    linkedlist_init(&list, sizeof(struct keyed));
+
+    // An odd length exercises unequal runs in every pass
+    int n = 100001;
+    for (int i = 0; i < n; i++) {
+        struct keyed item = {(i * 7919) % 101, i};
+        linkedlist_append(&list, &item);
+    }
+
+    linkedlist_sort(&list, compare_key);
+
+    EXPECT_EQ(linkedlist_length(&list), n);
+
+    // Walk forwards checking order, then backwards checking the prev links
+    struct keyed prev = {-1, -1}, item;
+    linkedlist_iterator_t it;
+    linkedlist_iter_init(&it, &list, 0, 0);
+    while (linkedlist_iter_next(&it, &item) == 0) {
+        ASSERT_TRUE(prev.key < item.key || (prev.key == item.key && prev.seq < item.seq));
+        prev = item;
+    }
+
+    int count = 0;
+    linkedlist_iter_init(&it, &list, -1, 1);
+    while (linkedlist_iter_next(&it, &item) == 0) {
+        count++;
+    }
+    EXPECT_EQ(count, n);
+
+    linkedlist_tail(&list, &item);
+    EXPECT_EQ(item.key, 100);
+
+    // Appending after a sort uses the fixed-up tail
+    struct keyed last = {1000, n};
+    linkedlist_append(&list, &last);
+    linkedlist_tail(&list, &item);
+    EXPECT_EQ(item.key, 1000);
+
+    linkedlist_destroy(&list);
+}
+
+TEST(LinkedList, SortEmptyAndSingle) {
+    linkedlist_t list;
+    linkedlist_init(&list, sizeof(int));
+
+    linkedlist_sort(&list, [](const void *a, const void *b) -> int {
+        return *(int *)a - *(int *)b;
+    });
+    EXPECT_EQ(linkedlist_length(&list), 0);
+
+    int one = 1, item;
+    linkedlist_append(&list, &one);
+    linkedlist_sort(&list, [](const void *a, const void *b) -> int {
+        return *(int *)a - *(int *)b;
+    });
+    linkedlist_tail(&list, &item);
+    EXPECT_EQ(item, 1);
+
+    linkedlist_destroy(&list);
+}
+
+TEST(LinkedList, Merge) {
+    int a_items[] = {1, 3, 5, 7};
+    int b_items[] = {2, 3, 4, 8, 9};
+
+    linkedlist_t a, b;
+    linkedlist_from_raw(&a, sizeof(int), 4, a_items);
+    linkedlist_from_raw(&b, sizeof(int), 5, b_items);
+
+    ASSERT_EQ(linkedlist_merge(&a, &b, [](const void *x, const void *y) -> int {
+        return *(int *)x - *(int *)y;
+    }), 0);
+
+    int merged[] = {1, 2, 3, 3, 4, 5, 7, 8, 9};
+    int item;
+    EXPECT_EQ(linkedlist_length(&a), 9);
+    EXPECT_EQ(linkedlist_length(&b), 0);
+    for (int i = 0; i < 9; i++) {
+        linkedlist_get(&a, i, &item);
+        EXPECT_EQ(item, merged[i]);
+    }
+
+    linkedlist_tail(&a, &item);
+    EXPECT_EQ(item, 9);
+
+    // Lists that allocate nodes differently cannot exchange them
+    linkedlist_t pooled;
+    linkedlist_init_pooled(&pooled, sizeof(int));
+    EXPECT_EQ(linkedlist_merge(&a, &pooled, NULL), 1);
+    EXPECT_EQ(linkedlist_merge(&a, &a, NULL), 1);
+
+    linkedlist_destroy(&pooled);
+    linkedlist_destroy(&a);
+    linkedlist_destroy(&b);
+}
+
+TEST(LinkedList, Split) {
+    int items[] = {0, 1, 2, 3, 4};
+
+    linkedlist_t list, rest;
+    linkedlist_from_raw(&list, sizeof(int), 5, items);
+
+    EXPECT_EQ(linkedlist_split(&list, 6, &rest), 1);
+
+    ASSERT_EQ(linkedlist_split(&list, 2, &rest), 0);
+    EXPECT_EQ(linkedlist_length(&list), 2);
+    EXPECT_EQ(linkedlist_length(&rest), 3);
+
+    int item;
+    linkedlist_tail(&list, &item);
+    EXPECT_EQ(item, 1);
+    linkedlist_head(&rest, &item);
+    EXPECT_EQ(item, 2);
+    linkedlist_tail(&rest, &item);
+    EXPECT_EQ(item, 4);
+
+    // Splitting at 0 moves everything, at the length moves nothing
+    linkedlist_t all, none;
+    ASSERT_EQ(linkedlist_split(&rest, 0, &all), 0);
+    ASSERT_EQ(linkedlist_split(&all, 3, &none), 0);
+    EXPECT_EQ(linkedlist_length(&rest), 0);
+    EXPECT_EQ(linkedlist_length(&all), 3);
+    EXPECT_EQ(linkedlist_length(&none), 0);
+    EXPECT_EQ(linkedlist_pop(&rest, &item), 1);
+
+    linkedlist_destroy(&list);
+    linkedlist_destroy(&rest);
+    linkedlist_destroy(&all);
+    linkedlist_destroy(&none);
+}
+
 TEST(LinkedList, Head) {
     linkedlist_t list;
     linkedlist_init(&list, sizeof(int));
@@ -339,4 +571,375 @@ TEST(LinkedList, Copy) {
     }
 
     linkedlist_destroy(&copy);
-}
\ No newline at end of file
+}
+TEST(LinkedList, Extend) {
+    linkedlist_t list;
+    int first[] = {1, 2};
+    int rest[] = {3, 4, 5};
+
+    linkedlist_from_raw(&list, sizeof(int), 2, first);
+    ASSERT_EQ(linkedlist_extend(&list, 3, rest), 0);
+    ASSERT_EQ(linkedlist_extend(&list, 0, rest), 0);
+
+    EXPECT_EQ(linkedlist_length(&list), 5);
+
+    int tail;
+    linkedlist_tail(&list, &tail);
+    EXPECT_EQ(tail, 5);
+
+    // The prev links of the new nodes are set too
+    linkedlist_iterator_t it;
+    linkedlist_iter_init(&it, &list, -1, 1);
+
+    int item;
+    for (int i = 5; i >= 1; i--) {
+        ASSERT_EQ(linkedlist_iter_next(&it, &item), 0);
+        EXPECT_EQ(item, i);
+    }
+
+    EXPECT_EQ(linkedlist_iter_next(&it, &item), 1);
+
+    linkedlist_destroy(&list);
+}
+
+TEST(LinkedList, AppendPopLarge) {
+    linkedlist_t list;
+    linkedlist_init(&list, sizeof(int));
+
+    // Quadratic appends or pops would not finish in reasonable time
+    int n = 1000000;
+    for (int i = 0; i < n; i++) {
+        ASSERT_EQ(linkedlist_append(&list, &i), 0);
+    }
+
+    linkedlist_t copy;
+    ASSERT_EQ(linkedlist_copy(&copy, &list), 0);
+    EXPECT_EQ(linkedlist_length(&copy), n);
+
+    int item;
+    for (int i = n - 1; i >= 0; i--) {
+        ASSERT_EQ(linkedlist_pop(&copy, &item), 0);
+        ASSERT_EQ(item, i);
+    }
+
+    EXPECT_EQ(linkedlist_length(&copy), 0);
+    EXPECT_EQ(linkedlist_pop(&copy, &item), 1);
+
+    // Appending to an emptied list still works
+    ASSERT_EQ(linkedlist_append(&copy, &n), 0);
+    linkedlist_head(&copy, &item);
+    EXPECT_EQ(item, n);
+
+    linkedlist_destroy(&list);
+    linkedlist_destroy(&copy);
+}
+
+TEST(LinkedList, Pooled) {
+    linkedlist_t list;
+    ASSERT_EQ(linkedlist_init_pooled(&list, sizeof(int)), 0);
+
+    nodepool_t *pool = linkedlist_pool(&list);
+    ASSERT_NE(pool, nullptr);
+
+    // Churning the list recycles the same nodes
+    int item;
+    for (int round = 0; round < 100; round++) {
+        for (int i = 0; i < 1000; i++) {
+            ASSERT_EQ(linkedlist_append(&list, &i), 0);
+        }
+
+        for (int i = 999; i >= 0; i--) {
+            ASSERT_EQ(linkedlist_pop(&list, &item), 0);
+            ASSERT_EQ(item, i);
+        }
+    }
+
+    EXPECT_EQ(nodepool_in_use(pool), 0);
+    EXPECT_EQ(nodepool_slab_count(pool), 1);
+
+    int raw[] = {3, 1, 2};
+    ASSERT_EQ(linkedlist_extend(&list, 3, raw), 0);
+    ASSERT_EQ(linkedlist_insert(&list, 1, &raw[0]), 0);
+    ASSERT_EQ(linkedlist_remove(&list, 0, &item), 0);
+    EXPECT_EQ(item, 3);
+    EXPECT_EQ(nodepool_in_use(pool), 3);
+
+    // Frees the pool without walking the nodes
+    linkedlist_destroy(&list);
+    EXPECT_EQ(linkedlist_pool(&list), nullptr);
+    EXPECT_EQ(linkedlist_length(&list), 0);
+}
+
+TEST(LinkedList, SharedPool) {
+    nodepool_t pool;
+    nodepool_init(&pool, linkedlist_node_size(sizeof(int)));
+
+    linkedlist_t a, b;
+    ASSERT_EQ(linkedlist_init_with_pool(&a, sizeof(int), &pool), 0);
+    ASSERT_EQ(linkedlist_init_with_pool(&b, sizeof(int), &pool), 0);
+
+    linkedlist_t too_large;
+    EXPECT_EQ(linkedlist_init_with_pool(&too_large, 1024, &pool), 1);
+
+    for (int i = 0; i < 100; i++) {
+        linkedlist_append(i % 2 ? &a : &b, &i);
+    }
+
+    EXPECT_EQ(nodepool_in_use(&pool), 100);
+
+    int item;
+    linkedlist_get(&a, 10, &item);
+    EXPECT_EQ(item, 21);
+
+    // Destroying one list returns only its nodes
+    linkedlist_destroy(&a);
+    EXPECT_EQ(nodepool_in_use(&pool), 50);
+    EXPECT_EQ(linkedlist_pool(&b), &pool);
+
+    linkedlist_destroy(&b);
+    EXPECT_EQ(nodepool_in_use(&pool), 0);
+    EXPECT_EQ(nodepool_trim(&pool), 1);
+
+    nodepool_destroy(&pool);
+}
+
+TEST(LinkedListIterator, FilterInPlace) {
+    linkedlist_t list;
+    linkedlist_init(&list, sizeof(int));
+
+    for (int i = 0; i < 1000; i++) {
+        linkedlist_append(&list, &i);
+    }
+
+    linkedlist_iterator_t it;
+    linkedlist_iter_init(&it, &list, 0, 0);
+
+    // Nothing returned yet, so nothing to erase
+    EXPECT_EQ(linkedlist_erase_at(&it), 1);
+
+    int *item;
+    while ((item = (int *) linkedlist_iter_next_ptr(&it))) {
+        if (*item % 3 != 0) {
+            ASSERT_EQ(linkedlist_erase_at(&it), 0);
+            EXPECT_EQ(linkedlist_erase_at(&it), 1);
+        } else {
+            // Items can be modified in place
+            *item *= 2;
+        }
+    }
+
+    EXPECT_EQ(linkedlist_length(&list), 334);
+
+    int value;
+    for (int i = 0; i < 334; i++) {
+        linkedlist_get(&list, i, &value);
+        ASSERT_EQ(value, 6 * i);
+    }
+
+    linkedlist_tail(&list, &value);
+    EXPECT_EQ(value, 1998);
+
+    linkedlist_destroy(&list);
+}
+
+TEST(LinkedListIterator, EraseAllReverse) {
+    linkedlist_t list;
+    linkedlist_init_pooled(&list, sizeof(int));
+
+    for (int i = 0; i < 100; i++) {
+        linkedlist_append(&list, &i);
+    }
+
+    linkedlist_iterator_t it;
+    linkedlist_iter_init(&it, &list, -1, 1);
+
+    int expected = 99;
+    while (int *item = (int *) linkedlist_iter_next_ptr(&it)) {
+        ASSERT_EQ(*item, expected--);
+        ASSERT_EQ(linkedlist_erase_at(&it), 0);
+    }
+
+    EXPECT_EQ(linkedlist_length(&list), 0);
+    EXPECT_EQ(list.head, nullptr);
+    EXPECT_EQ(list.tail, nullptr);
+    EXPECT_EQ(nodepool_in_use(linkedlist_pool(&list)), 0);
+
+    // The emptied list is still usable
+    linkedlist_append(&list, &expected);
+    EXPECT_EQ(linkedlist_length(&list), 1);
+
+    linkedlist_destroy(&list);
+}
+
+TEST(LinkedListIterator, InsertAround) {
+    int items[] = {10, 20, 30};
+
+    linkedlist_t list;
+    linkedlist_from_raw(&list, sizeof(int), 3, items);
+
+    linkedlist_iterator_t it;
+    linkedlist_iter_init(&it, &list, 0, 0);
+
+    int value = 5;
+    EXPECT_EQ(linkedlist_insert_before(&it, &value), 1);
+
+    // Insert around every item; the new items are not visited
+    int visited = 0;
+    while (int *item = (int *) linkedlist_iter_next_ptr(&it)) {
+        value = *item - 1;
+        ASSERT_EQ(linkedlist_insert_before(&it, &value), 0);
+        value = *item + 1;
+        ASSERT_EQ(linkedlist_insert_after(&it, &value), 0);
+        visited++;
+    }
+
+    EXPECT_EQ(visited, 3);
+
+    int expected[] = {9, 10, 11, 19, 20, 21, 29, 30, 31};
+    ASSERT_EQ(linkedlist_length(&list), 9);
+    for (int i = 0; i < 9; i++) {
+        linkedlist_get(&list, i, &value);
+        EXPECT_EQ(value, expected[i]);
+    }
+
+    linkedlist_head(&list, &value);
+    EXPECT_EQ(value, 9);
+    linkedlist_tail(&list, &value);
+    EXPECT_EQ(value, 31);
+
+    linkedlist_destroy(&list);
+}
+
+TEST(LinkedList, Splice) {
+    int a_items[] = {0, 1, 2, 3, 4, 5};
+    int b_items[] = {10, 11};
+
+    linkedlist_t a, b;
+    linkedlist_from_raw(&a, sizeof(int), 6, a_items);
+    linkedlist_from_raw(&b, sizeof(int), 2, b_items);
+
+    // Find the nodes holding 2 and 4, and 10
+    linkedlist_iterator_t it;
+    linkedlist_iter_init(&it, &a, 2, 0);
+    linkedlist_iter_next_ptr(&it);
+    linkedlist_node_t *first = linkedlist_iter_node(&it);
+    linkedlist_iter_next_ptr(&it);
+    linkedlist_iter_next_ptr(&it);
+    linkedlist_node_t *last = linkedlist_iter_node(&it);
+
+    linkedlist_iter_init(&it, &b, 0, 0);
+    linkedlist_iter_next_ptr(&it);
+    linkedlist_node_t *pos = linkedlist_iter_node(&it);
+
+    ASSERT_EQ(linkedlist_splice(&b, pos, &a, first, last, 3), 0);
+
+    int a_expected[] = {0, 1, 5};
+    int b_expected[] = {10, 2, 3, 4, 11};
+    int value;
+
+    ASSERT_EQ(linkedlist_length(&a), 3);
+    for (int i = 0; i < 3; i++) {
+        linkedlist_get(&a, i, &value);
+        EXPECT_EQ(value, a_expected[i]);
+    }
+
+    ASSERT_EQ(linkedlist_length(&b), 5);
+    for (int i = 0; i < 5; i++) {
+        linkedlist_get(&b, i, &value);
+        EXPECT_EQ(value, b_expected[i]);
+    }
+
+    // Move all of b to the front of a, then the tail of a within a
+    ASSERT_EQ(linkedlist_splice(&a, NULL, &b, b.head, b.tail, 5), 0);
+    EXPECT_EQ(linkedlist_length(&b), 0);
+    EXPECT_EQ(b.head, nullptr);
+    EXPECT_EQ(b.tail, nullptr);
+
+    ASSERT_EQ(linkedlist_splice(&a, NULL, &a, a.tail, a.tail, 1), 0);
+
+    int moved[] = {5, 10, 2, 3, 4, 11, 0, 1};
+    ASSERT_EQ(linkedlist_length(&a), 8);
+    for (int i = 0; i < 8; i++) {
+        linkedlist_get(&a, i, &value);
+        EXPECT_EQ(value, moved[i]);
+    }
+
+    linkedlist_tail(&a, &value);
+    EXPECT_EQ(value, 1);
+
+    // Nodes cannot leave a list that owns their pool
+    linkedlist_t pooled;
+    linkedlist_init_pooled(&pooled, sizeof(int));
+    linkedlist_append(&pooled, &value);
+    EXPECT_EQ(linkedlist_splice(&a, NULL, &pooled, pooled.head, pooled.head, 1), 1);
+    EXPECT_EQ(linkedlist_splice(&a, NULL, &b, NULL, NULL, 0), 1);
+
+    linkedlist_destroy(&pooled);
+    linkedlist_destroy(&a);
+    linkedlist_destroy(&b);
+}
+
+TEST(LinkedList, ClearReusesNodes) {
+    linkedlist_t list;
+    linkedlist_init(&list, sizeof(int));
+
+    for (int i = 0; i < 100; i++) {
+        linkedlist_append(&list, &i);
+    }
+
+    linkedlist_node_t *first = list.head;
+    int item;
+    linkedlist_get(&list, 50, &item);
+
+    linkedlist_clear(&list);
+    EXPECT_EQ(linkedlist_length(&list), 0);
+    EXPECT_EQ(linkedlist_spare(&list), 100);
+    EXPECT_EQ(linkedlist_get(&list, 0, &item), 1);
+
+    // The first node cleared is the first reused
+    int value = 7;
+    linkedlist_append(&list, &value);
+    EXPECT_EQ(list.head, first);
+    EXPECT_EQ(linkedlist_spare(&list), 99);
+    linkedlist_get(&list, 0, &item);
+    EXPECT_EQ(item, 7);
+
+    linkedlist_clear(&list);
+    EXPECT_EQ(linkedlist_spare(&list), 100);
+
+    linkedlist_shrink(&list);
+    EXPECT_EQ(linkedlist_spare(&list), 0);
+
+    // Spare nodes are freed by destroy too
+    linkedlist_append(&list, &value);
+    linkedlist_append(&list, &value);
+    linkedlist_clear(&list);
+    linkedlist_destroy(&list);
+    EXPECT_EQ(linkedlist_spare(&list), 0);
+}
+
+TEST(LinkedList, ClearPooled) {
+    linkedlist_t list;
+    ASSERT_EQ(linkedlist_init_pooled(&list, sizeof(int)), 0);
+    nodepool_t *pool = linkedlist_pool(&list);
+
+    for (int i = 0; i < 1000; i++) {
+        linkedlist_append(&list, &i);
+    }
+
+    // Cleared nodes stay out of the pool until shrunk
+    linkedlist_clear(&list);
+    EXPECT_EQ(nodepool_in_use(pool), 1000);
+
+    for (int i = 0; i < 1000; i++) {
+        linkedlist_append(&list, &i);
+    }
+    EXPECT_EQ(nodepool_in_use(pool), 1000);
+    EXPECT_EQ(linkedlist_spare(&list), 0);
+
+    linkedlist_clear(&list);
+    linkedlist_shrink(&list);
+    EXPECT_EQ(nodepool_in_use(pool), 0);
+
+    linkedlist_destroy(&list);
+}
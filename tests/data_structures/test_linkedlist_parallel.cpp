@@ -0,0 +1,130 @@
+#include "../../data_structures/linkedlist_parallel.h"
+
+#include <gtest/gtest.h>
+
+
+struct keyed {
+    int key;
+    int seq;
+};
+
+static int compare_key(const void *a, const void *b) {
+    return ((const struct keyed *)a)->key - ((const struct keyed *)b)->key;
+}
+
+static void fill(linkedlist_t *list, int n) {
+    for (int i = 0; i < n; i++) {
+        struct keyed item = {(int) ((i * 2654435761u) % 1000), i};
+        linkedlist_append(list, &item);
+    }
+}
+
+static void expect_sorted_stable(linkedlist_t *list, int n) {
+    ASSERT_EQ(linkedlist_length(list), n);
+
+    struct keyed prev = {-1, -1}, item;
+    linkedlist_iterator_t it;
+    linkedlist_iter_init(&it, list, 0, 0);
+    while (linkedlist_iter_next(&it, &item) == 0) {
+        ASSERT_TRUE(prev.key < item.key || (prev.key == item.key && prev.seq < item.seq));
+        prev = item;
+    }
+
+    // The prev links and tail are consistent
+    int count = 0;
+    linkedlist_iter_init(&it, list, -1, 1);
+    while (linkedlist_iter_next(&it, &item) == 0) {
+        count++;
+    }
+    EXPECT_EQ(count, n);
+
+    linkedlist_tail(list, &item);
+    EXPECT_EQ(item.key, prev.key);
+    EXPECT_EQ(item.seq, prev.seq);
+}
+
+
+TEST(LinkedListParallel, Sort) {
+    threadpool_t pool;
+    ASSERT_EQ(threadpool_init(&pool, 4), 0);
+
+    // Five pieces, so one is left over in the first merge round
+    int n = 200003;
+    linkedlist_t list;
+    linkedlist_init(&list, sizeof(struct keyed));
+    fill(&list, n);
+
+    ASSERT_EQ(linkedlist_sort_parallel(&list, compare_key, &pool), 0);
+    expect_sorted_stable(&list, n);
+
+    linkedlist_destroy(&list);
+    threadpool_destroy(&pool);
+}
+
+TEST(LinkedListParallel, SharedPoolAndPooledNodes) {
+    int n = 100000;
+    linkedlist_t list;
+    ASSERT_EQ(linkedlist_init_pooled(&list, sizeof(struct keyed)), 0);
+    fill(&list, n);
+
+    ASSERT_EQ(linkedlist_sort_parallel(&list, compare_key, NULL), 0);
+    expect_sorted_stable(&list, n);
+    EXPECT_EQ(nodepool_in_use(linkedlist_pool(&list)), n);
+
+    linkedlist_destroy(&list);
+}
+
+TEST(LinkedListParallel, Short) {
+    linkedlist_t list;
+    linkedlist_init(&list, sizeof(struct keyed));
+    fill(&list, 100);
+
+    ASSERT_EQ(linkedlist_sort_parallel(&list, compare_key, NULL), 0);
+    expect_sorted_stable(&list, 100);
+
+    linkedlist_destroy(&list);
+
+    linkedlist_init(&list, sizeof(struct keyed));
+    ASSERT_EQ(linkedlist_sort_parallel(&list, compare_key, NULL), 0);
+    EXPECT_EQ(linkedlist_length(&list), 0);
+    linkedlist_destroy(&list);
+}
+
+TEST(LinkedListParallel, DestroyAsync) {
+    linkedlist_t plain, pooled;
+    linkedlist_init(&plain, sizeof(struct keyed));
+    ASSERT_EQ(linkedlist_init_pooled(&pooled, sizeof(struct keyed)), 0);
+    fill(&plain, 100000);
+    fill(&pooled, 100000);
+    linkedlist_clear(&pooled);
+    fill(&pooled, 10);
+
+    linkedlist_destroy_async(&plain);
+    linkedlist_destroy_async(&pooled);
+
+    // The objects are reusable at once
+    EXPECT_EQ(linkedlist_length(&plain), 0);
+    EXPECT_EQ(linkedlist_spare(&pooled), 0);
+    EXPECT_EQ(linkedlist_pool(&pooled), nullptr);
+    fill(&plain, 10);
+    EXPECT_EQ(linkedlist_length(&plain), 10);
+
+    linkedlist_destroy_async(&plain);
+    linkedlist_reclaim_wait();
+    linkedlist_destroy(&pooled);
+}
+
+TEST(LinkedListParallel, DestroyAsyncSharedPool) {
+    nodepool_t pool;
+    nodepool_init(&pool, linkedlist_node_size(sizeof(struct keyed)));
+
+    linkedlist_t list;
+    ASSERT_EQ(linkedlist_init_with_pool(&list, sizeof(struct keyed), &pool), 0);
+    fill(&list, 1000);
+
+    // The pool is not thread-safe, so the nodes are freed before returning
+    linkedlist_destroy_async(&list);
+    EXPECT_EQ(nodepool_in_use(&pool), 0);
+
+    nodepool_destroy(&pool);
+}
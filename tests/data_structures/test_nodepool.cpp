@@ -0,0 +1,121 @@
+#include "../../data_structures/nodepool.h"
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <vector>
+
+
+TEST(NodePool, Init) {
+    nodepool_t pool;
+    ASSERT_EQ(nodepool_init(&pool, 24), 0);
+
+    EXPECT_EQ(nodepool_node_size(&pool), 32);
+    EXPECT_EQ(nodepool_slab_count(&pool), 0);
+    EXPECT_EQ(nodepool_in_use(&pool), 0);
+    EXPECT_EQ(nodepool_capacity(&pool), 0);
+
+    EXPECT_EQ(nodepool_init(&pool, 0), 1);
+
+    nodepool_destroy(&pool);
+}
+
+TEST(NodePool, AllocFree) {
+    nodepool_t pool;
+    nodepool_init(&pool, sizeof(int));
+
+    std::vector<int *> nodes;
+    for (int i = 0; i < 10000; i++) {
+        int *node = (int *) nodepool_alloc(&pool);
+        ASSERT_NE(node, nullptr);
+        EXPECT_EQ((uintptr_t) node % 16, 0);
+        *node = i;
+        nodes.push_back(node);
+    }
+
+    EXPECT_EQ(nodepool_in_use(&pool), 10000);
+    EXPECT_GE(nodepool_capacity(&pool), 10000);
+    EXPECT_GT(nodepool_slab_count(&pool), 1);
+
+    // Nodes never overlap
+    for (int i = 0; i < 10000; i++) {
+        ASSERT_EQ(*nodes[i], i);
+    }
+
+    for (int *node : nodes) {
+        nodepool_free(&pool, node);
+    }
+
+    EXPECT_EQ(nodepool_in_use(&pool), 0);
+
+    nodepool_destroy(&pool);
+    EXPECT_EQ(nodepool_slab_count(&pool), 0);
+}
+
+TEST(NodePool, Recycle) {
+    nodepool_t pool;
+    nodepool_init(&pool, 40);
+
+    void *a = nodepool_alloc(&pool);
+    void *b = nodepool_alloc(&pool);
+    nodepool_free(&pool, a);
+
+    // The freed node is handed out again before untouched ones
+    EXPECT_EQ(nodepool_alloc(&pool), a);
+    EXPECT_EQ(nodepool_slab_count(&pool), 1);
+
+    nodepool_free(&pool, a);
+    nodepool_free(&pool, b);
+    nodepool_destroy(&pool);
+}
+
+TEST(NodePool, Trim) {
+    nodepool_t pool;
+    nodepool_init(&pool, 64);
+
+    std::vector<void *> nodes;
+    for (int i = 0; i < 5000; i++) {
+        nodes.push_back(nodepool_alloc(&pool));
+    }
+
+    size_t slabs = nodepool_slab_count(&pool);
+    ASSERT_GT(slabs, 2);
+
+    // Keep the first node, which pins its slab, and free the rest
+    for (size_t i = 1; i < nodes.size(); i++) {
+        nodepool_free(&pool, nodes[i]);
+    }
+
+    EXPECT_EQ(nodepool_trim(&pool), slabs - 1);
+    EXPECT_EQ(nodepool_slab_count(&pool), 1);
+    EXPECT_EQ(nodepool_in_use(&pool), 1);
+    EXPECT_EQ(nodepool_trim(&pool), 0);
+
+    // The pool grows again after trimming
+    for (size_t i = 1; i < nodes.size(); i++) {
+        nodes[i] = nodepool_alloc(&pool);
+        ASSERT_NE(nodes[i], nullptr);
+    }
+
+    EXPECT_EQ(nodepool_slab_count(&pool), slabs);
+
+    nodepool_destroy(&pool);
+}
+
+TEST(NodePool, LargeNodes) {
+    nodepool_t pool;
+    nodepool_init(&pool, 100000);
+
+    // Slabs grow to hold several large nodes
+    char *a = (char *) nodepool_alloc(&pool);
+    char *b = (char *) nodepool_alloc(&pool);
+    memset(a, 1, 100000);
+    memset(b, 2, 100000);
+    EXPECT_EQ(a[99999], 1);
+    EXPECT_EQ(nodepool_slab_count(&pool), 1);
+
+    nodepool_free(&pool, a);
+    nodepool_free(&pool, b);
+    EXPECT_EQ(nodepool_trim(&pool), 1);
+
+    nodepool_destroy(&pool);
+}
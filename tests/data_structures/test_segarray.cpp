@@ -0,0 +1,122 @@
+#include "../../data_structures/segarray.h"
+
+#include <gtest/gtest.h>
+
+
+TEST(SegArray, Init) {
+    segarray_t array;
+    ASSERT_EQ(segarray_init(&array, sizeof(int), 0), 0);
+
+    EXPECT_EQ(segarray_length(&array), 0);
+    EXPECT_EQ(segarray_item_size(&array), sizeof(int));
+    EXPECT_EQ(segarray_capacity(&array), 0);
+    EXPECT_EQ(segarray_chunk_count(&array), 0);
+
+    segarray_destroy(&array);
+}
+
+TEST(SegArray, AppendAndGet) {
+    segarray_t array;
+    segarray_init(&array, sizeof(int), 5);      // Rounded up to 8
+
+    for (int i = 0; i < 100; i++) {
+        ASSERT_EQ(segarray_append(&array, &i), 0);
+    }
+
+    EXPECT_EQ(segarray_length(&array), 100);
+    EXPECT_EQ(segarray_capacity(&array), 104);
+
+    int item;
+    for (int i = 0; i < 100; i++) {
+        ASSERT_EQ(segarray_get(&array, i, &item), 0);
+        EXPECT_EQ(item, i);
+        EXPECT_EQ(*(int *)segarray_at(&array, i), i);
+    }
+
+    EXPECT_EQ(segarray_get(&array, 100, &item), 1);
+    EXPECT_EQ(segarray_at(&array, 100), nullptr);
+
+    segarray_destroy(&array);
+}
+
+TEST(SegArray, StableAddresses) {
+    segarray_t array;
+    segarray_init(&array, sizeof(int), 4);
+
+    int first = 42;
+    segarray_append(&array, &first);
+    int *ptr = (int *)segarray_at(&array, 0);
+
+    for (int i = 0; i < 10000; i++) {
+        segarray_append(&array, &i);
+    }
+
+    EXPECT_EQ(segarray_at(&array, 0), ptr);
+    EXPECT_EQ(*ptr, 42);
+
+    segarray_destroy(&array);
+}
+
+TEST(SegArray, Pop) {
+    segarray_t array;
+    segarray_init(&array, sizeof(int), 4);
+
+    for (int i = 0; i < 10; i++) {
+        segarray_append(&array, &i);
+    }
+
+    int item;
+    for (int i = 9; i >= 0; i--) {
+        ASSERT_EQ(segarray_pop(&array, &item), 0);
+        EXPECT_EQ(item, i);
+    }
+
+    EXPECT_EQ(segarray_pop(&array, NULL), 1);
+    EXPECT_EQ(segarray_length(&array), 0);
+
+    // Chunks are kept for reuse
+    EXPECT_EQ(segarray_capacity(&array), 12);
+
+    segarray_destroy(&array);
+}
+
+TEST(SegArray, Reserve) {
+    segarray_t array;
+    segarray_init(&array, sizeof(double), 16);
+
+    ASSERT_EQ(segarray_reserve(&array, 100), 0);
+    EXPECT_EQ(segarray_capacity(&array), 112);
+    EXPECT_EQ(segarray_length(&array), 0);
+
+    segarray_destroy(&array);
+}
+
+TEST(SegArray, Chunks) {
+    segarray_t array;
+    segarray_init(&array, sizeof(int), 8);
+
+    for (int i = 0; i < 20; i++) {
+        segarray_append(&array, &i);
+    }
+
+    ASSERT_EQ(segarray_chunk_count(&array), 3);
+
+    // Iterate chunk by chunk
+    int expected = 0;
+    size_t sizes[] = {8, 8, 4};
+    for (size_t c = 0; c < segarray_chunk_count(&array); c++) {
+        size_t n_items;
+        int *chunk = (int *)segarray_chunk(&array, c, &n_items);
+        ASSERT_NE(chunk, nullptr);
+        EXPECT_EQ(n_items, sizes[c]);
+
+        for (size_t i = 0; i < n_items; i++) {
+            EXPECT_EQ(chunk[i], expected++);
+        }
+    }
+
+    size_t n_items;
+    EXPECT_EQ(segarray_chunk(&array, 3, &n_items), nullptr);
+
+    segarray_destroy(&array);
+}
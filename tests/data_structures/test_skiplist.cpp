@@ -0,0 +1,178 @@
+#include "../../data_structures/skiplist.h"
+
+#include <gtest/gtest.h>
+#include <set>
+#include <vector>
+
+
+static int compare_int(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+struct entry {
+    int key;
+    double value;
+};
+
+static int compare_key(const void *a, const void *b) {
+    return compare_int(&((const struct entry *)a)->key, &((const struct entry *)b)->key);
+}
+
+
+TEST(SkipList, Init) {
+    skiplist_t list;
+    ASSERT_EQ(skiplist_init(&list, sizeof(int), compare_int), 0);
+
+    EXPECT_EQ(skiplist_length(&list), 0);
+    EXPECT_EQ(skiplist_empty(&list), 1);
+
+    int key = 1;
+    EXPECT_EQ(skiplist_find(&list, &key), nullptr);
+    EXPECT_EQ(skiplist_erase(&list, &key, NULL), 1);
+
+    skiplist_iterator_t it;
+    skiplist_lower_bound(&it, &list, NULL);
+    EXPECT_EQ(skiplist_iter_next_ptr(&it), nullptr);
+
+    skiplist_destroy(&list);
+}
+
+TEST(SkipList, MatchesSet) {
+    skiplist_t list;
+    skiplist_init(&list, sizeof(int), compare_int);
+
+    std::set<int> expected;
+    uint32_t state = 2463534242u;
+    auto next_random = [&state]() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    };
+
+    for (int step = 0; step < 100000; step++) {
+        int key = next_random() % 5000;
+
+        if (next_random() % 3 == 0) {
+            int removed = -1;
+            int err = skiplist_erase(&list, &key, &removed);
+            ASSERT_EQ(err, expected.erase(key) ? 0 : 1);
+            if (err == 0) {
+                ASSERT_EQ(removed, key);
+            }
+        } else {
+            ASSERT_EQ(skiplist_insert(&list, &key), expected.insert(key).second ? 0 : 1);
+        }
+    }
+
+    ASSERT_EQ(skiplist_length(&list), expected.size());
+
+    // Iterating yields the keys in order
+    skiplist_iterator_t it;
+    skiplist_lower_bound(&it, &list, NULL);
+    for (int key : expected) {
+        int item;
+        ASSERT_EQ(skiplist_iter_next(&it, &item), 0);
+        ASSERT_EQ(item, key);
+    }
+    int item;
+    EXPECT_EQ(skiplist_iter_next(&it, &item), 1);
+
+    for (int key = 0; key < 5000; key++) {
+        ASSERT_EQ(skiplist_find(&list, &key) != nullptr, expected.count(key) == 1);
+    }
+
+    skiplist_destroy(&list);
+    EXPECT_EQ(skiplist_length(&list), 0);
+}
+
+TEST(SkipList, Map) {
+    skiplist_t map;
+    skiplist_init(&map, sizeof(struct entry), compare_key);
+
+    for (int i = 0; i < 1000; i++) {
+        struct entry e = {i * 2, i * 0.5};
+        ASSERT_EQ(skiplist_insert(&map, &e), 0);
+    }
+
+    // Values are updated in place through the pointer
+    struct entry key = {500, 0};
+    struct entry *found = (struct entry *)skiplist_find(&map, &key);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(found->value, 125.0);
+    found->value = -1;
+
+    struct entry e;
+    ASSERT_EQ(skiplist_get(&map, &key, &e), 0);
+    EXPECT_EQ(e.value, -1);
+
+    key.key = 501;
+    EXPECT_EQ(skiplist_get(&map, &key, &e), 1);
+
+    // Inserting an existing key does not replace it
+    struct entry dup = {500, 99};
+    EXPECT_EQ(skiplist_insert(&map, &dup), 1);
+    key.key = 500;
+    skiplist_get(&map, &key, &e);
+    EXPECT_EQ(e.value, -1);
+
+    skiplist_destroy(&map);
+}
+
+TEST(SkipList, RangeScan) {
+    skiplist_t list;
+    skiplist_init(&list, sizeof(int), compare_int);
+
+    for (int i = 0; i < 100; i++) {
+        int key = i * 10;
+        skiplist_insert(&list, &key);
+    }
+
+    // Every key in [255, 300)
+    int low = 255, high = 300;
+    std::vector<int> seen;
+    skiplist_iterator_t it;
+    skiplist_lower_bound(&it, &list, &low);
+
+    int *item;
+    while ((item = (int *)skiplist_iter_next_ptr(&it)) && *item < high) {
+        seen.push_back(*item);
+    }
+
+    EXPECT_EQ(seen, std::vector<int>({260, 270, 280, 290}));
+
+    // A bound equal to a key starts at that key, one past the end is empty
+    low = 500;
+    skiplist_lower_bound(&it, &list, &low);
+    EXPECT_EQ(*(int *)skiplist_iter_next_ptr(&it), 500);
+
+    low = 991;
+    skiplist_lower_bound(&it, &list, &low);
+    EXPECT_EQ(skiplist_iter_next_ptr(&it), nullptr);
+
+    skiplist_destroy(&list);
+}
+
+TEST(SkipList, LargeSequential) {
+    skiplist_t list;
+    skiplist_init(&list, sizeof(int), compare_int);
+
+    // Linear-time inserts or lookups would not finish in reasonable time
+    int n = 1000000;
+    for (int i = 0; i < n; i++) {
+        ASSERT_EQ(skiplist_insert(&list, &i), 0);
+    }
+
+    for (int i = 0; i < n; i += 7) {
+        ASSERT_NE(skiplist_find(&list, &i), nullptr);
+    }
+
+    for (int i = n - 1; i >= 0; i -= 2) {
+        ASSERT_EQ(skiplist_erase(&list, &i, NULL), 0);
+    }
+
+    EXPECT_EQ(skiplist_length(&list), n / 2);
+
+    skiplist_destroy(&list);
+}
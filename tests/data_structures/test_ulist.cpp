@@ -0,0 +1,229 @@
+#include "../../data_structures/ulist.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <stdint.h>
+#include <vector>
+
+
+static void expect_equal(ulist_t *list, const std::vector<int> &expected) {
+    ASSERT_EQ(ulist_length(list), expected.size());
+
+    int item;
+    ulist_iterator_t it;
+    ulist_iter_init(&it, list, 0, 0);
+    for (size_t i = 0; i < expected.size(); i++) {
+        ASSERT_EQ(ulist_iter_next(&it, &item), 0);
+        ASSERT_EQ(item, expected[i]);
+    }
+    EXPECT_EQ(ulist_iter_next(&it, &item), 1);
+}
+
+
+TEST(UList, Init) {
+    ulist_t list;
+    ASSERT_EQ(ulist_init(&list, sizeof(int)), 0);
+
+    EXPECT_EQ(ulist_length(&list), 0);
+    EXPECT_EQ(ulist_empty(&list), 1);
+    EXPECT_EQ(ulist_item_size(&list), sizeof(int));
+    EXPECT_EQ(ulist_node_count(&list), 0);
+
+    int item;
+    EXPECT_EQ(ulist_get(&list, 0, &item), 1);
+    EXPECT_EQ(ulist_pop(&list, &item), 1);
+    EXPECT_EQ(ulist_at(&list, 0), nullptr);
+
+    EXPECT_EQ(ulist_init(&list, 0), 1);
+
+    ulist_destroy(&list);
+}
+
+TEST(UList, AppendFillsNodes) {
+    ulist_t list;
+    ulist_init(&list, sizeof(int));
+
+    std::vector<int> expected;
+    for (int i = 0; i < 10000; i++) {
+        ASSERT_EQ(ulist_append(&list, &i), 0);
+        expected.push_back(i);
+    }
+
+    expect_equal(&list, expected);
+
+    // Every node but the last is full
+    size_t capacity = list.node_capacity;
+    EXPECT_EQ(ulist_node_count(&list), (10000 + capacity - 1) / capacity);
+
+    int item;
+    for (int i = 0; i < 10000; i += 997) {
+        ASSERT_EQ(ulist_get(&list, i, &item), 0);
+        EXPECT_EQ(item, i);
+        EXPECT_EQ(*(int *)ulist_at(&list, i), i);
+    }
+
+    for (int i = 9999; i >= 0; i--) {
+        ASSERT_EQ(ulist_pop(&list, &item), 0);
+        ASSERT_EQ(item, i);
+    }
+
+    EXPECT_EQ(ulist_node_count(&list), 0);
+    ulist_destroy(&list);
+}
+
+TEST(UList, InsertRemoveMatchesVector) {
+    ulist_t list;
+    ulist_init(&list, sizeof(int));
+
+    std::vector<int> expected;
+    uint32_t state = 12345;
+    auto next_random = [&state]() {
+        state = state * 1103515245u + 12345u;
+        return state >> 8;
+    };
+
+    // Mostly inserts, so nodes split and merge as the list grows
+    for (int step = 0; step < 20000; step++) {
+        if (expected.empty() || next_random() % 3 != 0) {
+            size_t index = next_random() % (expected.size() + 1);
+            ASSERT_EQ(ulist_insert(&list, index, &step), 0);
+            expected.insert(expected.begin() + index, step);
+        } else {
+            size_t index = next_random() % expected.size();
+            int item;
+            ASSERT_EQ(ulist_remove(&list, index, &item), 0);
+            ASSERT_EQ(item, expected[index]);
+            expected.erase(expected.begin() + index);
+        }
+    }
+
+    expect_equal(&list, expected);
+
+    // Nodes stay at least half full on average
+    EXPECT_LE(ulist_node_count(&list), 2 * expected.size() / list.node_capacity + 2);
+
+    EXPECT_EQ(ulist_insert(&list, expected.size() + 1, &state), 1);
+    EXPECT_EQ(ulist_remove(&list, expected.size(), NULL), 1);
+
+    // Drain from the front
+    while (!expected.empty()) {
+        ASSERT_EQ(ulist_remove(&list, 0, NULL), 0);
+        expected.erase(expected.begin());
+    }
+
+    EXPECT_EQ(ulist_node_count(&list), 0);
+    ulist_destroy(&list);
+}
+
+TEST(UList, FromRaw) {
+    std::vector<int> raw;
+    for (int i = 0; i < 1000; i++) {
+        raw.push_back(i * 3);
+    }
+
+    ulist_t list;
+    ASSERT_EQ(ulist_from_raw(&list, sizeof(int), raw.size(), raw.data()), 0);
+    expect_equal(&list, raw);
+
+    int item;
+    ulist_get(&list, 999, &item);
+    EXPECT_EQ(item, 2997);
+
+    ulist_destroy(&list);
+}
+
+TEST(UList, Iterator) {
+    int raw[200];
+    for (int i = 0; i < 200; i++) {
+        raw[i] = i;
+    }
+
+    ulist_t list;
+    ulist_from_raw(&list, sizeof(int), 200, raw);
+
+    ulist_iterator_t it;
+    int item;
+
+    ASSERT_EQ(ulist_iter_init(&it, &list, -1, 1), 0);
+    for (int i = 199; i >= 0; i--) {
+        ASSERT_EQ(ulist_iter_next(&it, &item), 0);
+        ASSERT_EQ(item, i);
+    }
+    EXPECT_EQ(ulist_iter_next(&it, &item), 1);
+
+    ASSERT_EQ(ulist_iter_init(&it, &list, 150, 0), 0);
+    for (int i = 150; i < 200; i++) {
+        ASSERT_EQ(ulist_iter_next(&it, &item), 0);
+        ASSERT_EQ(item, i);
+    }
+    EXPECT_EQ(ulist_iter_next(&it, &item), 1);
+
+    ASSERT_EQ(ulist_iter_init(&it, &list, 200, 0), 0);
+    EXPECT_EQ(ulist_iter_next(&it, &item), 1);
+    EXPECT_EQ(ulist_iter_init(&it, &list, 201, 0), 1);
+
+    ulist_destroy(&list);
+}
+
+struct keyed {
+    int key;
+    int seq;
+};
+
+TEST(UList, SortStable) {
+    ulist_t list;
+    ulist_init(&list, sizeof(struct keyed));
+
+    for (int i = 0; i < 5000; i++) {
+        struct keyed item = {(i * 7919) % 37, i};
+        ulist_insert(&list, i / 2, &item);
+    }
+
+    ASSERT_EQ(ulist_sort(&list, [](const void *a, const void *b) -> int {
+        return ((const struct keyed *)a)->key - ((const struct keyed *)b)->key;
+    }), 0);
+
+    // Equal keys keep their order in the list before sorting
+    std::vector<struct keyed> before;
+    for (int i = 0; i < 5000; i++) {
+        struct keyed item = {(i * 7919) % 37, i};
+        before.insert(before.begin() + i / 2, item);
+    }
+    std::stable_sort(before.begin(), before.end(), [](const keyed &a, const keyed &b) {
+        return a.key < b.key;
+    });
+
+    struct keyed item;
+    for (int i = 0; i < 5000; i++) {
+        ulist_get(&list, i, &item);
+        ASSERT_EQ(item.key, before[i].key);
+        ASSERT_EQ(item.seq, before[i].seq);
+    }
+
+    ulist_destroy(&list);
+}
+
+TEST(UList, LargeItems) {
+    struct big {
+        char bytes[300];
+    };
+
+    ulist_t list;
+    ulist_init(&list, sizeof(struct big));
+
+    // Items larger than a node still get several per node
+    EXPECT_GE(list.node_capacity, 2);
+
+    struct big item;
+    for (int i = 0; i < 50; i++) {
+        memset(item.bytes, i, sizeof(item.bytes));
+        ASSERT_EQ(ulist_insert(&list, i / 3, &item), 0);
+    }
+
+    for (int i = 0; i < 50; i++) {
+        ASSERT_EQ(ulist_remove(&list, 0, &item), 0);
+        EXPECT_EQ(item.bytes[0], item.bytes[299]);
+    }
+
+    ulist_destroy(&list);
+}
@@ -0,0 +1,129 @@
+#include "../../synchronization/epoch.h"
+
+#include <gtest/gtest.h>
+#include <stdlib.h>
+
+
+struct object {
+    int *freed;
+    epoch_retired_t retired;
+};
+
+static void object_free(epoch_retired_t *retired) {
+    struct object *object = (struct object *)((char *)retired - offsetof(struct object, retired));
+    (*object->freed)++;
+    free(object);
+}
+
+static void retire_new(epoch_thread_t *thread, int *freed) {
+    struct object *object = (struct object *)malloc(sizeof(struct object));
+    object->freed = freed;
+    epoch_retire(thread, &object->retired, object_free);
+}
+
+
+TEST(Epoch, FreedAfterTwoEpochs) {
+    epoch_domain_t domain;
+    ASSERT_EQ(epoch_init(&domain), 0);
+
+    epoch_thread_t thread;
+    ASSERT_EQ(epoch_register(&domain, &thread), 0);
+
+    int freed = 0;
+    epoch_enter(&thread);
+    retire_new(&thread, &freed);
+    epoch_exit(&thread);
+
+    EXPECT_EQ(epoch_pending(&thread), 1);
+
+    // One advance is not enough, the second frees it
+    EXPECT_EQ(epoch_collect(&thread), 0);
+    EXPECT_EQ(epoch_collect(&thread), 1);
+    EXPECT_EQ(freed, 1);
+    EXPECT_EQ(epoch_pending(&thread), 0);
+
+    epoch_unregister(&thread);
+    epoch_destroy(&domain);
+}
+
+TEST(Epoch, ReaderBlocksReclamation) {
+    epoch_domain_t domain;
+    epoch_init(&domain);
+
+    epoch_thread_t writer, reader;
+    epoch_register(&domain, &writer);
+    epoch_register(&domain, &reader);
+
+    // A reader that entered before the retirement may still see the object
+    epoch_enter(&reader);
+
+    int freed = 0;
+    retire_new(&writer, &freed);
+
+    for (int i = 0; i < 10; i++) {
+        epoch_collect(&writer);
+    }
+    EXPECT_EQ(freed, 0);
+
+    // Nested sections keep the reader inside
+    epoch_enter(&reader);
+    epoch_exit(&reader);
+    epoch_collect(&writer);
+    EXPECT_EQ(freed, 0);
+
+    epoch_exit(&reader);
+    epoch_collect(&writer);
+    epoch_collect(&writer);
+    EXPECT_EQ(freed, 1);
+
+    epoch_unregister(&reader);
+    epoch_unregister(&writer);
+    epoch_destroy(&domain);
+}
+
+TEST(Epoch, Threshold) {
+    epoch_domain_t domain;
+    epoch_init(&domain);
+
+    epoch_thread_t thread;
+    epoch_register(&domain, &thread);
+
+    // Retiring runs collection by itself, so little stays pending
+    int freed = 0;
+    for (int i = 0; i < 100 * EPOCH_COLLECT_THRESHOLD; i++) {
+        retire_new(&thread, &freed);
+    }
+
+    EXPECT_LE(epoch_pending(&thread), 2 * EPOCH_COLLECT_THRESHOLD);
+    EXPECT_EQ(freed + epoch_pending(&thread), 100 * EPOCH_COLLECT_THRESHOLD);
+
+    epoch_unregister(&thread);
+    epoch_destroy(&domain);
+    EXPECT_EQ(freed, 100 * EPOCH_COLLECT_THRESHOLD);
+}
+
+TEST(Epoch, Orphans) {
+    epoch_domain_t domain;
+    epoch_init(&domain);
+
+    epoch_thread_t leaving, staying;
+    epoch_register(&domain, &leaving);
+    epoch_register(&domain, &staying);
+
+    int freed = 0;
+    epoch_enter(&staying);
+    retire_new(&leaving, &freed);
+    epoch_unregister(&leaving);
+    EXPECT_EQ(freed, 0);
+    epoch_exit(&staying);
+
+    // Another thread frees what the leaving thread left
+    epoch_collect(&staying);
+    epoch_collect(&staying);
+    EXPECT_EQ(freed, 1);
+
+    // Destroying the domain frees whatever is still pending
+    retire_new(&staying, &freed);
+    epoch_destroy(&domain);
+    EXPECT_EQ(freed, 2);
+}
@@ -0,0 +1,58 @@
+#include "../../synchronization/threadpool.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+
+static void mark(void *ctx, size_t index) {
+    int *counts = (int *)ctx;
+    __atomic_add_fetch(&counts[index], 1, __ATOMIC_RELAXED);
+}
+
+TEST(ThreadPool, RunsEveryTaskOnce) {
+    threadpool_t pool;
+    ASSERT_EQ(threadpool_init(&pool, 4), 0);
+    EXPECT_EQ(threadpool_size(&pool), 4);
+
+    // Reuse the same workers for many jobs
+    for (int job = 0; job < 200; job++) {
+        std::vector<int> counts(1000, 0);
+        ASSERT_EQ(threadpool_run(&pool, counts.size(), mark, counts.data()), 0);
+
+        for (int count : counts) {
+            ASSERT_EQ(count, 1);
+        }
+    }
+
+    threadpool_destroy(&pool);
+}
+
+TEST(ThreadPool, NoWorkers) {
+    threadpool_t pool;
+    ASSERT_EQ(threadpool_init(&pool, 0), 0);
+
+    std::vector<int> counts(10, 0);
+    ASSERT_EQ(threadpool_run(&pool, counts.size(), mark, counts.data()), 0);
+
+    for (int count : counts) {
+        EXPECT_EQ(count, 1);
+    }
+
+    EXPECT_EQ(threadpool_run(&pool, 0, mark, NULL), 0);
+
+    threadpool_destroy(&pool);
+}
+
+TEST(ThreadPool, Shared) {
+    threadpool_t *pool = threadpool_shared();
+    ASSERT_NE(pool, nullptr);
+    EXPECT_EQ(threadpool_shared(), pool);
+
+    std::vector<int> counts(100, 0);
+    ASSERT_EQ(threadpool_run(pool, counts.size(), mark, counts.data()), 0);
+
+    for (int count : counts) {
+        EXPECT_EQ(count, 1);
+    }
+}